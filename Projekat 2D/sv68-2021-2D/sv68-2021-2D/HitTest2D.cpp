@@ -0,0 +1,30 @@
+#include "HitTest2D.h"
+
+glm::vec2 screenToWorld(double mouseX, double mouseY, int screenWidth, int screenHeight, const glm::mat4& projection) {
+    // Normalizovane koordinate misa (od -1 do 1)
+    float normalizedX = ((float)mouseX / (float)screenWidth) * 2.0f - 1.0f;
+    float normalizedY = 1.0f - ((float)mouseY / (float)screenHeight) * 2.0f;
+
+    // Vektor u "ekran" prostoru
+    glm::vec4 screenPos = glm::vec4(normalizedX, normalizedY, 0.0f, 1.0f);
+
+    // Inverzna projekcija da dobijemo svetovni prostor
+    glm::mat4 inverseProjection = glm::inverse(projection);
+    glm::vec4 worldPos = inverseProjection * screenPos;
+
+    // Vracamo X i Y svetovne koordinate
+    return glm::vec2(worldPos.x, worldPos.y);
+}
+
+bool isPointInCircle(const glm::vec2& point, const glm::vec2& center, float radius) {
+    float dx = point.x - center.x;
+    float dy = point.y - center.y;
+
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+bool isPointInRing(const glm::vec2& point, float innerRadius, float outerRadius) {
+    float distanceFromCenter = glm::length(point);
+
+    return distanceFromCenter >= innerRadius && distanceFromCenter <= outerRadius;
+}
@@ -0,0 +1,17 @@
+#ifndef HIT_TEST_2D_H
+#define HIT_TEST_2D_H
+
+#include <glm/glm.hpp>
+
+// Testovi pogotka misem bez GLFW/OpenGL poziva - koriste ih 2D scena i microbenchmark
+
+// Piksel kursora (od gornjeg levog ugla) -> svetske koordinate preko inverzne projekcije
+glm::vec2 screenToWorld(double mouseX, double mouseY, int screenWidth, int screenHeight, const glm::mat4& projection);
+
+// Planeta, Sunce i Mesec su krugovi
+bool isPointInCircle(const glm::vec2& point, const glm::vec2& center, float radius);
+
+// Asteroidni pojas je prsten oko (0, 0)
+bool isPointInRing(const glm::vec2& point, float innerRadius, float outerRadius);
+
+#endif // HIT_TEST_2D_H
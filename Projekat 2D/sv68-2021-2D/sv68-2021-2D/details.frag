@@ -1,9 +1,10 @@
 #version 330 core
 in vec2 TexCoords;
+flat in float Layer;
 out vec4 FragColor;
 
-uniform sampler2D texture1;
+uniform sampler2DArray texture1;
 
 void main() {
-    FragColor = texture(texture1, TexCoords);
+    FragColor = texture(texture1, vec3(TexCoords, Layer));
 }
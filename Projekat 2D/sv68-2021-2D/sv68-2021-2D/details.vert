@@ -1,8 +1,11 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // pozicija + UV koordinate
+layout (location = 1) in float layer; // stranica atlasa kartica
 out vec2 TexCoords;
+flat out float Layer;
 
 void main() {
     gl_Position = vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    Layer = layer;
 }
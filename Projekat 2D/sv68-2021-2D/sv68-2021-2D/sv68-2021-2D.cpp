@@ -12,12 +12,29 @@
 #include <fstream>
 #include <sstream>
 #include <thread>
+#include <cstdlib>
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>      
 #include <ft2build.h>
 #include FT_FREETYPE_H
-
+#include "Trace.h"
+#include "HitTest2D.h"
+#include "GpuMemory.h"
+#include "ImageCache.h"
+#include "UiAtlas.h"
+#include "UiBatch.h"
+
+
+// glfwTerminate na izlasku iz main-a; deklarise se odmah posle prozora, pa se unistava poslednji i svi GL
+// objekti iz main-a (atlas, UI batch, pojasevi...) brisu svoje resurse dok kontekst jos postoji
+struct GlfwSession {
+    GlfwSession() = default;
+    GlfwSession(const GlfwSession&) = delete;
+    GlfwSession& operator=(const GlfwSession&) = delete;
+    ~GlfwSession() { glfwTerminate(); }
+};
 
 GLFWwindow* initializeOpenGL(int width, int height, const char* title) {
     if (!glfwInit()) {      // Inicijalizacija GLFW-a
@@ -70,6 +87,8 @@ GLuint compileShader(GLenum shaderType, const char* source) {
 
 // Funkcija za kreiranje programa
 GLuint createProgram(const char* vertexShaderPath, const char* fragmentShaderPath) {
+    TRACE_SCOPE_DETAIL("createProgram", vertexShaderPath);
+
     std::string vertexSource = loadShaderSource(vertexShaderPath);
     std::string fragmentSource = loadShaderSource(fragmentShaderPath);
 
@@ -137,12 +156,24 @@ glm::mat4 calculateProjection(int screenWidth, int screenHeight, float zoomLevel
     );
 }
 
+// Ceo fajl u memoriju; isti bajtovi idu u ImageCache (hes izvora) i u dekoder
+bool readFileBytes(const std::string& path, std::vector<unsigned char>& bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    std::streamoff size = file.tellg();
+    if (size < 0) return false;
+    bytes.resize((size_t)size);
+    file.seekg(0);
+    return size == 0 || (bool)file.read(reinterpret_cast<char*>(bytes.data()), size);
+}
+
 // Funkcija za učitavanje teksture
 GLuint loadTexture(const char* filePath) {
+    TRACE_SCOPE_DETAIL("loadTexture", filePath);
 
     // Provera da li fajl postoji
-    std::ifstream testFile(filePath);
-    if (!testFile) {
+    std::vector<unsigned char> source;
+    if (!readFileBytes(filePath, source)) {
         std::cerr << "File does not exist: " << filePath << std::endl;
         return 0; // Vrati 0 jer tekstura nije uspešno učitana
     }
@@ -158,9 +189,29 @@ GLuint loadTexture(const char* filePath) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
+    // Dekodirana slika sa mip lancem iz proslog pokretanja: bez stbi_load i glGenerateMipmap
+    ImageDecode decode;
+    decode.mipmaps = true;
+    CachedImage cached = ImageCache::load(filePath, source.data(), source.size(), decode);
+    if (!cached.empty()) {
+        GLenum format = (cached.channels() == 4) ? GL_RGBA : GL_RGB;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (int i = 0; i < cached.levelCount(); ++i) {
+            const CachedLevel& level = cached.level(i);
+            glTexImage2D(GL_TEXTURE_2D, i, format, level.width, level.height, 0, format, GL_UNSIGNED_BYTE, cached.pixels() + level.offset);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        GpuMemory::track(GPU_TEXTURE, textureID, GpuMemory::imageBytes(cached.width(), cached.height(), cached.channels(), true), filePath, GPU_MEMORY_SITE);
+        return textureID;
+    }
+
     // Učitavanje slike
     int width, height, nrChannels;
-    unsigned char* data = stbi_load(filePath, &width, &height, &nrChannels, 0);
+    unsigned char* data = nullptr;
+    {
+        TRACE_SCOPE("stbi_load");
+        data = stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &nrChannels, 0);
+    }
     if (data) {
         // Provera broja kanala
         if (nrChannels == 1) {
@@ -196,6 +247,8 @@ GLuint loadTexture(const char* filePath) {
             return 0; // Vrati 0 jer tekstura nije u podržanom formatu
         }
         glGenerateMipmap(GL_TEXTURE_2D);
+        GpuMemory::track(GPU_TEXTURE, textureID, GpuMemory::imageBytes(width, height, nrChannels, true), filePath, GPU_MEMORY_SITE);
+        ImageCache::store(filePath, source.data(), source.size(), decode, data, width, height, nrChannels);
     }
     else {
         std::cerr << "Failed to load texture: " << filePath << std::endl;
@@ -217,6 +270,8 @@ struct Character {
 };
 
 void loadFont(const std::string& fontPath, std::map<GLchar, Character>& Characters) {
+    GPU_MEMORY_OWNER("loadFont");
+
     FT_Library ft;
     if (FT_Init_FreeType(&ft)) {
         std::cerr << "ERROR FREETYPE: Nije instanciran" << std::endl;
@@ -255,6 +310,8 @@ void loadFont(const std::string& fontPath, std::map<GLchar, Character>& Characte
             GL_UNSIGNED_BYTE,
             face->glyph->bitmap.buffer
         );
+        GpuMemory::track(GPU_TEXTURE, texture, GpuMemory::imageBytes(face->glyph->bitmap.width, face->glyph->bitmap.rows, 1, false),
+            fontPath.c_str(), GPU_MEMORY_SITE);
         GLenum error = glGetError();
         if (error != GL_NO_ERROR) {
             std::cerr << "OpenGL error: " << error
@@ -286,6 +343,9 @@ void loadFont(const std::string& fontPath, std::map<GLchar, Character>& Characte
 void RenderText(GLFWwindow* window, unsigned int& shader, std::string text, float x, float y, float scale, glm::vec3 color, 
     std::map<GLchar, Character>& Characters)
 {
+    TRACE_SCOPE("RenderText");
+    GPU_MEMORY_OWNER("RenderText");
+
     GLuint VAO = 0;
     GLuint VBO = 0;
 
@@ -294,6 +354,7 @@ void RenderText(GLFWwindow* window, unsigned int& shader, std::string text, floa
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, VBO, sizeof(float) * 6 * 4, text.c_str(), GPU_MEMORY_SITE);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -403,6 +464,7 @@ public:
         }
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, (numSegments + 2) * 4 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, (numSegments + 2) * 4 * sizeof(GLfloat), "Sun2D circle", GPU_MEMORY_SITE);
 
         // Pozicije (layout 0)
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)0);
@@ -540,6 +602,7 @@ public:
         glGenBuffers(1, &VBO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, (numSegments + 2) * 4 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, (numSegments + 2) * 4 * sizeof(GLfloat), "Planet2D circle", GPU_MEMORY_SITE);
 
         // Pozicije
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)0);
@@ -574,6 +637,7 @@ public:
         glGenBuffers(1, &orbitVBO);
         glBindBuffer(GL_ARRAY_BUFFER, orbitVBO);
         glBufferData(GL_ARRAY_BUFFER, numSegments * 2 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, orbitVBO, numSegments * 2 * sizeof(GLfloat), "Planet2D orbit", GPU_MEMORY_SITE);
 
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (void*)0);
         glEnableVertexAttribArray(0);
@@ -702,6 +766,7 @@ public:
         glGenBuffers(1, &VBO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, (numSegments + 2) * 4 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, (numSegments + 2) * 4 * sizeof(GLfloat), "Moon2D circle", GPU_MEMORY_SITE);
 
         // Pozicije
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (void*)0);
@@ -825,6 +890,7 @@ public:
         glGenBuffers(1, &VBO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, asteroidPositions.size() * sizeof(glm::vec2), asteroidPositions.data(), GL_STATIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, asteroidPositions.size() * sizeof(glm::vec2), "AsteroidBelt positions", GPU_MEMORY_SITE);
 
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
@@ -884,133 +950,45 @@ glm::vec2 getMouseWorldPosition(GLFWwindow* window, int screenWidth, int screenH
     double mouseX, mouseY;
     glfwGetCursorPos(window, &mouseX, &mouseY);
 
-    // Normalizovane koordinate miša (od -1 do 1)
-    float normalizedX = ((float)mouseX / (float)screenWidth) * 2.0f - 1.0f;
-    float normalizedY = 1.0f - ((float)mouseY / (float)screenHeight) * 2.0f;
-
-    // Vektor u "ekran" prostoru
-    glm::vec4 screenPos = glm::vec4(normalizedX, normalizedY, 0.0f, 1.0f);
-
-    // Inverzna projekcija da dobijemo svetovni prostor
-    glm::mat4 inverseProjection = glm::inverse(projection);
-    glm::vec4 worldPos = inverseProjection * screenPos;
-
-    // Vraćamo X i Y svetovne koordinate
-    return glm::vec2(worldPos.x, worldPos.y);
+    return screenToWorld(mouseX, mouseY, screenWidth, screenHeight, projection);
 }
 
 bool isMouseOverPlanet(const glm::vec2& mousePos, const Planet2D::PlanetBounds objectPos) {
-    float dx = mousePos.x - objectPos.center.x;
-    float dy = mousePos.y - objectPos.center.y;
-
-    if (dx * dx + dy * dy <= objectPos.radius * objectPos.radius) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return isPointInCircle(mousePos, objectPos.center, objectPos.radius);
 }
 
 bool isMouseOverSun(const glm::vec2& mousePos, const Sun2D::SunBounds objectPos) {
-    float dx = mousePos.x - objectPos.center.x;
-    float dy = mousePos.y - objectPos.center.y;
-
-    if (dx * dx + dy * dy <= objectPos.radius * objectPos.radius) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return isPointInCircle(mousePos, objectPos.center, objectPos.radius);
 }
 
 bool isMouseOverMoon(const glm::vec2& mousePos, const Moon2D::MoonBounds objectPos) {
-    float dx = mousePos.x - objectPos.center.x;
-    float dy = mousePos.y - objectPos.center.y;
-
-    if (dx * dx + dy * dy <= objectPos.radius * objectPos.radius) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return isPointInCircle(mousePos, objectPos.center, objectPos.radius);
 }
 
 bool isMouseOverAsteroidBelt(const glm::vec2& mousePos, AsteroidBelt& belt) {
-    float distanceFromCenter = glm::length(mousePos);
     glm::vec2 radiuses = belt.getRadiuses();
 
     // Proveri da li je miš unutar prstena
-    if (distanceFromCenter >= radiuses[0] && distanceFromCenter <= radiuses[1]) {
-        return true;
-    }
-    return false;
+    return isPointInRing(mousePos, radiuses[0], radiuses[1]);
 }
 
-//render fja za details prikaz planete
-void renderInfoBox(float x, float y, float width, float height, GLuint shaderProgram, const char* textureName) {
-    GLuint texture = loadTexture(textureName);
-
-    if (texture == 0) {
-        std::cerr << "Error: Nevalidni Texture ID" << std::endl;
-        return;
-    }
+//Kartica sa detaljima ide u UI batch (atlas stranica + UV); crta se sa ostatkom UI-ja u UiBatch::flush
+void renderInfoBox(float x, float y, float width, float height, UiBatch& uiBatch, UiAtlas& triviaAtlas, const std::string& name) {
+    TRACE_SCOPE_DETAIL("renderInfoBox", name.c_str());
 
     // Prilagodimo visinu i širinu da budu u NDC
-    width = width * 2.0f; 
-    height = height * 2.0f;
-
-    // Verteksi za pravougaonik
-    float vertices[6][4] = {
-        {x, y, 0.0f, 0.0f},
-        {x, y - height, 0.0f, 1.0f},
-        {x + width, y - height, 1.0f, 1.0f},
-
-        {x, y, 0.0f, 0.0f},
-        {x + width, y - height, 1.0f, 1.0f},
-        {x + width, y, 1.0f, 0.0f}
-    };
-
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-
-    // Aktiviraj sejder
-    glUseProgram(shaderProgram);
-
-    // Binduj teksturu
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    // Setuj uniform za teksturu
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
-
-    // Renderuj pravougaonik
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Očisti resurse
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    uiBatch.addQuad(x, y, width * 2.0f, height * 2.0f, triviaAtlas.find(name));
 }
 
 void mouseHoverPlanet(Planet2D& planet, glm::vec2 mouseWorldPos, GLFWwindow* window, GLuint textShaderProgram,
-    GLuint triviaShaderProgram, std::map<GLchar, Character> Characters, std::string planetName, const char* triviaPath, bool &hovered) {
+    UiBatch& uiBatch, UiAtlas& triviaAtlas, std::map<GLchar, Character> Characters, std::string planetName, const std::string& triviaName, bool &hovered) {
     // Proveri za planete
     if (!hovered) {
         Planet2D::PlanetBounds planetBounds = planet.getPlanetBounds();
         if (isMouseOverPlanet(mouseWorldPos, planetBounds)) {
             RenderText(window, textShaderProgram, planetName, 0.0f, 0.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), Characters);
             if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-                renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, triviaShaderProgram, triviaPath);
+                renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, triviaName);
             }
             hovered = true;
         }
@@ -1018,7 +996,7 @@ void mouseHoverPlanet(Planet2D& planet, glm::vec2 mouseWorldPos, GLFWwindow* win
 }
 
 void mouseHoverSun(Sun2D& sun, glm::vec2 mouseWorldPos, GLFWwindow* window, GLuint textShaderProgram,
-    GLuint triviaShaderProgram, std::map<GLchar, Character> Characters, bool &hovered) {
+    UiBatch& uiBatch, UiAtlas& triviaAtlas, std::map<GLchar, Character> Characters, bool &hovered) {
     //Proveri za sunce
     if (!hovered) {
         Sun2D::SunBounds sunBounds = sun.getSunBounds();
@@ -1026,7 +1004,7 @@ void mouseHoverSun(Sun2D& sun, glm::vec2 mouseWorldPos, GLFWwindow* window, GLui
             RenderText(window, textShaderProgram, "Sun", 0.0f, 0.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), Characters);
 
             if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-                renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, triviaShaderProgram, "sun-trivia.png");
+                renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, "sun");
             }
             hovered = true;
         }
@@ -1034,13 +1012,13 @@ void mouseHoverSun(Sun2D& sun, glm::vec2 mouseWorldPos, GLFWwindow* window, GLui
 }
 
 void mouseHoverMoon(Moon2D& moon, glm::vec2 mouseWorldPos, GLFWwindow* window, GLuint textShaderProgram,
-    GLuint triviaShaderProgram, std::map<GLchar, Character> Characters, std::string moonName, const char* triviaPath, bool &hovered) {
+    UiBatch& uiBatch, UiAtlas& triviaAtlas, std::map<GLchar, Character> Characters, std::string moonName, const std::string& triviaName, bool &hovered) {
     if (!hovered) {
         Moon2D::MoonBounds moonBounds = moon.getMoonBounds();
         if (isMouseOverMoon(mouseWorldPos, moonBounds)) {
             RenderText(window, textShaderProgram, moonName, 0.0f, 0.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), Characters);
              if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-                 renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, triviaShaderProgram,  triviaPath);
+                 renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, triviaName);
              }
             hovered = true;
         }
@@ -1048,12 +1026,12 @@ void mouseHoverMoon(Moon2D& moon, glm::vec2 mouseWorldPos, GLFWwindow* window, G
 }
 
 void mouseHoverAsteroidBelt(AsteroidBelt& belt, glm::vec2 mouseWorldPos, GLFWwindow* window, GLuint textShaderProgram,
-    GLuint triviaShaderProgram, std::map<GLchar, Character> Characters, std::string beltName, const char* triviaPath, bool &hovered) {
+    UiBatch& uiBatch, UiAtlas& triviaAtlas, std::map<GLchar, Character> Characters, std::string beltName, const std::string& triviaName, bool &hovered) {
     if (!hovered) {
         if (isMouseOverAsteroidBelt(mouseWorldPos, belt)) {
             RenderText(window, textShaderProgram, beltName, 0.0f, 0.0f, 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), Characters);
              if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-                 renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, triviaShaderProgram, triviaPath);
+                 renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, triviaName);
              }
             hovered = true;
         }
@@ -1066,8 +1044,8 @@ void mouseHoverDetection(GLFWwindow* window, int screenWidth, int screenHeight,
     Moon2D& phobos, Moon2D& deimos, Moon2D& io, Moon2D& europa, Moon2D& ganymede, Moon2D& callisto, Moon2D& titan, Moon2D& rhea,
     Moon2D& iapetus, Moon2D& miranda, Moon2D& ariel, Moon2D& umbriel, Moon2D& triton, AsteroidBelt& asteroidBelt, AsteroidBelt& kuiperBelt,
     AsteroidBelt& oortBelt, glm::mat4 projection, GLuint textShaderProgram,
-    std::map<GLchar, Character> characters, GLuint triviaShaderProgram) {
-   
+    std::map<GLchar, Character> characters, GLuint triviaShaderProgram, UiBatch& uiBatch, UiAtlas& triviaAtlas) {
+    TRACE_SCOPE("mouseHoverDetection");
 
     glm::vec2 mouseWorldPos = getMouseWorldPosition(window, screenWidth, screenHeight, projection);
     
@@ -1077,44 +1055,58 @@ void mouseHoverDetection(GLFWwindow* window, int screenWidth, int screenHeight,
 
     bool hovered = false;
    
-    mouseHoverSun(sun, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, hovered);
-
-    mouseHoverPlanet(mercury, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Mercury", "mercury-trivia.png", hovered);
-    mouseHoverPlanet(earth, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Earth", "earth-trivia.png", hovered);
-    mouseHoverPlanet(venus, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Venus", "venus-trivia.png", hovered);
-    mouseHoverPlanet(mars, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Mars", "mars-trivia.png", hovered);
-    mouseHoverPlanet(jupiter, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Jupiter", "jupiter-trivia.png", hovered);
-    mouseHoverPlanet(saturn, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Saturn", "saturn-trivia.png", hovered);
-    mouseHoverPlanet(uranus, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Uranus", "uranus-trivia.png", hovered);
-    mouseHoverPlanet(neptune, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Neptune", "neptune-trivia.png", hovered);
-    mouseHoverPlanet(pluto, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Pluto", "pluto-trivia.png", hovered);
-
-    mouseHoverMoon(moon, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Moon", "moon-trivia.png", hovered);
-    mouseHoverMoon(phobos, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Phobos", "phobos-trivia.png", hovered);
-    mouseHoverMoon(deimos, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Deimos", "deimos-trivia.png", hovered);
-    mouseHoverMoon(io, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Io", "io-trivia.png", hovered);
-    mouseHoverMoon(europa, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Europa", "europa-trivia.png", hovered);
-    mouseHoverMoon(ganymede, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Ganymede", "ganymede-trivia.png", hovered);
-    mouseHoverMoon(callisto, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Callisto", "callisto-trivia.png", hovered);
-    mouseHoverMoon(titan, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Titan", "titan-trivia.png", hovered);
-    mouseHoverMoon(rhea, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Rhea", "rhea-trivia.png", hovered);
-    mouseHoverMoon(iapetus, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Iapetus", "iapetus-trivia.png", hovered);
-    mouseHoverMoon(miranda, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Miranda", "miranda-trivia.png", hovered);
-    mouseHoverMoon(ariel, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Ariel", "ariel-trivia.png", hovered);
-    mouseHoverMoon(umbriel, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Umbriel", "umbriel-trivia.png", hovered);
-    mouseHoverMoon(triton, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Triton", "triton-trivia.png", hovered);
-
-    mouseHoverAsteroidBelt(asteroidBelt, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Main Asteroid Belt", "main asteroid belt-trivia.png", hovered);
-    mouseHoverAsteroidBelt(kuiperBelt, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Kuiper Belt", "kuiper belt-trivia.png", hovered);
-    mouseHoverAsteroidBelt(oortBelt, mouseWorldPos, window, textShaderProgram, triviaShaderProgram, characters, "Oort Cloud", "oort cloud-trivia.png", hovered);
+    mouseHoverSun(sun, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, hovered);
+
+    mouseHoverPlanet(mercury, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Mercury", "mercury", hovered);
+    mouseHoverPlanet(earth, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Earth", "earth", hovered);
+    mouseHoverPlanet(venus, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Venus", "venus", hovered);
+    mouseHoverPlanet(mars, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Mars", "mars", hovered);
+    mouseHoverPlanet(jupiter, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Jupiter", "jupiter", hovered);
+    mouseHoverPlanet(saturn, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Saturn", "saturn", hovered);
+    mouseHoverPlanet(uranus, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Uranus", "uranus", hovered);
+    mouseHoverPlanet(neptune, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Neptune", "neptune", hovered);
+    mouseHoverPlanet(pluto, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Pluto", "pluto", hovered);
+
+    mouseHoverMoon(moon, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Moon", "moon", hovered);
+    mouseHoverMoon(phobos, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Phobos", "phobos", hovered);
+    mouseHoverMoon(deimos, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Deimos", "deimos", hovered);
+    mouseHoverMoon(io, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Io", "io", hovered);
+    mouseHoverMoon(europa, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Europa", "europa", hovered);
+    mouseHoverMoon(ganymede, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Ganymede", "ganymede", hovered);
+    mouseHoverMoon(callisto, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Callisto", "callisto", hovered);
+    mouseHoverMoon(titan, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Titan", "titan", hovered);
+    mouseHoverMoon(rhea, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Rhea", "rhea", hovered);
+    mouseHoverMoon(iapetus, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Iapetus", "iapetus", hovered);
+    mouseHoverMoon(miranda, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Miranda", "miranda", hovered);
+    mouseHoverMoon(ariel, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Ariel", "ariel", hovered);
+    mouseHoverMoon(umbriel, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Umbriel", "umbriel", hovered);
+    mouseHoverMoon(triton, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Triton", "triton", hovered);
+
+    mouseHoverAsteroidBelt(asteroidBelt, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Main Asteroid Belt", "main asteroid belt", hovered);
+    mouseHoverAsteroidBelt(kuiperBelt, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Kuiper Belt", "kuiper belt", hovered);
+    mouseHoverAsteroidBelt(oortBelt, mouseWorldPos, window, textShaderProgram, uiBatch, triviaAtlas, characters, "Oort Cloud", "oort cloud", hovered);
+
+    // Sve UI kartice frejma jednim pozivom
+    uiBatch.flush(triviaShaderProgram, triviaAtlas.texture(), GL_FILL);
 }
 
-int main() {
+int main(int argc, char** argv) {
+    Tracer::setThreadName("main");
+
+    // Dekodirane slike iz proslog pokretanja (image-cache/ u radnom folderu); --no-image-cache uvek dekodira
+    bool imageCache = true;
+    long long triviaBudget = UiAtlas::DEFAULT_BUDGET_BYTES;    // --trivia-budget-mb N: VRAM za kartice sa detaljima
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--no-image-cache") imageCache = false;
+        else if (std::string(argv[i]) == "--trivia-budget-mb" && i + 1 < argc) triviaBudget = std::max(0LL, std::atoll(argv[++i])) * 1024 * 1024;
+    }
+    if (imageCache) ImageCache::setDirectory(ImageCache::DEFAULT_DIRECTORY);
 
     int screenWidth = 1800, screenHeight = 950;
 
     GLFWwindow* window = initializeOpenGL(screenWidth, screenHeight, "Suncev Sistem - 2D");
     if (!window) return -1;
+    GlfwSession glfwSession;
 
 
     double lastClickTime = glfwGetTime();   //zapis poslednjeg klika (pomaze pri onemogucavanju slucajnih visestrukih klikova)
@@ -1138,6 +1130,14 @@ int main() {
     //ucitavanje sejdera za tekst i dodatne informacije
     GLuint textShaderProgram = createProgram("text.vert", "text.frag");
     GLuint triviaShaderProgram = createProgram("details.vert", "details.frag");
+    UiAtlas triviaAtlas(triviaBudget);  //kartice sa detaljima: raspored odmah, slika pri prvom prikazu, VRAM pod budzetom
+    for (const char* name : { "sun", "mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "neptune", "pluto",
+        "moon", "phobos", "deimos", "io", "europa", "ganymede", "callisto", "titan", "rhea", "iapetus", "miranda", "ariel",
+        "umbriel", "triton", "main asteroid belt", "kuiper belt", "oort cloud" }) {
+        triviaAtlas.add(name, std::string(name) + "-trivia.png");
+    }
+    triviaAtlas.build();
+    UiBatch uiBatch;
 
     //ucitavanje svih sejdera za sve objekte
     GLuint sunProgram = createProgram("planet.vert", "planet.frag");
@@ -1190,7 +1190,9 @@ int main() {
 
     auto lastFrameTime = std::chrono::high_resolution_clock::now();
     while (!glfwWindowShouldClose(window)) {
+        TRACE_SCOPE("Frame");
         glm::mat4 projection = calculateProjection(screenWidth, screenHeight, zoomLevel, offsetX, offsetY);
+        triviaAtlas.beginFrame();
         
         //ZUMIRANJE
         if (glfwGetKey(window, GLFW_KEY_KP_SUBTRACT) == GLFW_PRESS) {
@@ -1231,6 +1233,21 @@ int main() {
             }
         }
 
+        //TRACE ISPIS (chrome://tracing)
+        if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS) {
+            if (!isOneClick(lastClickTime)) {
+                Tracer::writeChromeJson("trace.json");
+            }
+        }
+
+        //GPU MEMORIJA (zive teksture/baferi po vlasniku i sumnjiva curenja)
+        if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS) {
+            if (!isOneClick(lastClickTime)) {
+                GpuMemory::printReport(std::cout);
+                triviaAtlas.print(std::cout);
+            }
+        }
+
         //PAUZIRAJ ANIMACIJU
         if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS) {
             speedMultiplier = 0.0f;
@@ -1317,11 +1334,14 @@ int main() {
 
         mouseHoverDetection(window, screenWidth, screenHeight, sun, mercury, earth, venus, mars, jupiter, saturn, uranus, neptune, pluto, 
             moon, phobos, deimos, io, europa, ganymede, callisto, titan, rhea, iapetus, miranda, ariel, umbriel, triton, mainAsteroidBelt, 
-            kuiperBelt, oortCloud, projection, textShaderProgram, Characters, triviaShaderProgram);
+            kuiperBelt, oortCloud, projection, textShaderProgram, Characters, triviaShaderProgram, uiBatch, triviaAtlas);
+        GpuMemory::endFrame();
         
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
-    glfwTerminate();
+    if (GpuMemory::suspectedLeakCount() > 0) {
+        GpuMemory::printReport(std::cerr);
+    }
     return 0;
 }
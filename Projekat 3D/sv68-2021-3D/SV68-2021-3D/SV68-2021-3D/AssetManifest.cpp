@@ -0,0 +1,100 @@
+#include "AssetManifest.h"
+
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+const char* SHADERS[] = {
+    "skybox", "sun", "planet", "moon", "ring", "details", "orbit", "asteroids", "oort-cloud", "text"
+};
+
+const char* SURFACE_TEXTURES[] = {
+    "sun", "mercury", "venus", "earth", "mars", "jupiter", "saturn", "saturn-ring", "uranus", "pluto", "neptune",
+    "moon", "deimos", "phobos", "io", "europa", "ganymede", "callisto", "titan", "rhea", "iapetus",
+    "umbriel", "ariel", "miranda", "triton"
+};
+
+// Imaju svoje 2D teksture: Sunce se crta sun sejderom, a prsten nije ekvirektangularna mapa
+const char* SINGLE_TEXTURES[] = { "sun", "saturn-ring" };
+
+const char* TRIVIA_CARDS[] = {
+    "sun", "mercury", "venus", "earth", "mars", "jupiter", "saturn", "uranus", "pluto", "neptune",
+    "moon", "deimos", "phobos", "io", "europa", "ganymede", "callisto", "titan", "rhea", "iapetus",
+    "umbriel", "ariel", "miranda", "triton", "main asteroid belt", "kuiper belt", "oort cloud"
+};
+
+const char* SKYBOX_FACES[] = { "bkg1_back.png", "bkg1_bot.png", "bkg1_front.png", "bkg1_left.png", "bkg1_right.png", "bkg1_top.png" };
+
+}
+
+std::vector<std::string> sceneShaderFiles() {
+    std::vector<std::string> files;
+    for (const char* name : SHADERS) {
+        files.push_back(std::string(name) + ".vert");
+        files.push_back(std::string(name) + ".frag");
+    }
+    return files;
+}
+
+std::vector<std::string> sceneImageFiles() {
+    std::vector<std::string> files;
+    for (const char* name : SURFACE_TEXTURES) files.push_back(std::string(name) + "-tex.jpg");
+    files.push_back("2k_asteroid.jpg");
+    for (const char* face : SKYBOX_FACES) files.push_back(face);
+    for (const char* name : TRIVIA_CARDS) files.push_back(triviaPathFor(name));
+    return files;
+}
+
+std::vector<std::string> triviaCardNames() {
+    return std::vector<std::string>(std::begin(TRIVIA_CARDS), std::end(TRIVIA_CARDS));
+}
+
+std::string triviaPathFor(const std::string& name) {
+    return name + "-trivia.png";
+}
+
+std::vector<std::string> sceneFontFiles() {
+    return { "LiberationSans-Regular.ttf" };
+}
+
+bool isSkyboxFace(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    return name.compare(0, 5, "bkg1_") == 0;
+}
+
+bool isTriviaCard(const std::string& path) {
+    static const std::string suffix = "-trivia.png";
+    return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool isSurfaceMap(const std::string& path) {
+    static const std::string suffix = "-tex.jpg";
+    if (path.size() < suffix.size() || path.compare(path.size() - suffix.size(), suffix.size(), suffix) != 0) return false;
+    std::string name = path.substr(0, path.size() - suffix.size());
+    for (const char* single : SINGLE_TEXTURES) {
+        if (name == single) return false;
+    }
+    return true;
+}
+
+const TextureSizeClass TEXTURE_SIZE_CLASSES[TEXTURE_SIZE_CLASS_COUNT] = {
+    { 2048, 1024 }, { 1024, 512 }, { 512, 256 }
+};
+
+int textureSizeClassFor(int width, int height) {
+    if (width <= 0 || height <= 0) return 1;
+
+    // Najbliza klasa po log2 sirine: 1280 -> 1024, 1800 -> 2048, 318 -> 512
+    int best = 0;
+    float bestDistance = 1.0e9f;
+    for (int i = 0; i < TEXTURE_SIZE_CLASS_COUNT; ++i) {
+        float distance = std::fabs(std::log2((float)width) - std::log2((float)TEXTURE_SIZE_CLASSES[i].width));
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = i;
+        }
+    }
+    return best;
+}
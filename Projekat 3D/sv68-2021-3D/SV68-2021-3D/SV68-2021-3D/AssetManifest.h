@@ -0,0 +1,29 @@
+#ifndef ASSET_MANIFEST_H
+#define ASSET_MANIFEST_H
+
+#include <string>
+#include <vector>
+
+// Fajlovi koje 3D program ucitava pri pokretanju i tokom rada - spisak za alate
+// (SV68-2021-TexConvert, SV68-2021-Packer), da ne bi svaki drzao svoju kopiju.
+
+std::vector<std::string> sceneShaderFiles();        // *.vert / *.frag
+std::vector<std::string> sceneImageFiles();         // Povrsine tela, nebo (bkg1_*) i trivia kartice
+std::vector<std::string> sceneFontFiles();
+std::vector<std::string> triviaCardNames();         // Kljucevi UI atlasa: "earth", "main asteroid belt", ...
+std::string triviaPathFor(const std::string& name); // "earth" -> "earth-trivia.png"
+
+bool isSkyboxFace(const std::string& path);         // bkg1_*: bez okretanja i bez mipmapa
+bool isTriviaCard(const std::string& path);         // *-trivia.png: ide u UI atlas, bez .dds i umanjene verzije
+bool isSurfaceMap(const std::string& path);         // Povrsina planete/meseca: sloj niza tekstura, .dds u velicini klase
+
+// Klase velicine povrsinskih mapa (TextureArrayManager): 2:1 (ekvirektangularne mape), od najvece.
+// Program i SV68-2021-TexConvert preuzorkuju sliku na istu klasu, pa se .dds salje u niz bez preracunavanja.
+struct TextureSizeClass {
+    int width, height;
+};
+const int TEXTURE_SIZE_CLASS_COUNT = 3;
+extern const TextureSizeClass TEXTURE_SIZE_CLASSES[TEXTURE_SIZE_CLASS_COUNT];
+int textureSizeClassFor(int width, int height);     // Najbliza po log2 sirine
+
+#endif // ASSET_MANIFEST_H
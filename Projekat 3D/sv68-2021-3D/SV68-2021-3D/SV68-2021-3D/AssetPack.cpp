@@ -0,0 +1,278 @@
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AssetPack.h"
+#include "Trace.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+// Zaglavlje: magic, verzija, broj unosa; zatim indeks (duzina imena, ime, offset, velicina) i podaci
+const char PACK_MAGIC[8] = { 'S', 'V', '6', '8', 'P', 'A', 'K', '\0' };
+const uint32_t PACK_VERSION = 1;
+const uint64_t DATA_ALIGNMENT = 16;
+
+struct PackEntry {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct MappedPack {
+    std::string path;
+    const unsigned char* base = nullptr;
+    size_t size = 0;
+    std::unordered_map<std::string, PackEntry> index;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+MappedPack pack;
+
+std::string normalizeName(const std::string& name) {
+    std::string normalized = name;
+    for (char& c : normalized) {
+        if (c == '\\') c = '/';
+    }
+    while (normalized.compare(0, 2, "./") == 0) normalized.erase(0, 2);
+    return normalized;
+}
+
+bool mapFile(const std::string& path) {
+#ifdef _WIN32
+    pack.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (pack.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(pack.file, &fileSize) || fileSize.QuadPart == 0) return false;
+    pack.mapping = CreateFileMappingA(pack.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!pack.mapping) return false;
+    pack.base = (const unsigned char*)MapViewOfFile(pack.mapping, FILE_MAP_READ, 0, 0, 0);
+    pack.size = (size_t)fileSize.QuadPart;
+    return pack.base != nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);        // Mapiranje ostaje vazece i bez deskriptora
+    if (mapped == MAP_FAILED) return false;
+    pack.base = (const unsigned char*)mapped;
+    pack.size = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+void unmapFile() {
+#ifdef _WIN32
+    if (pack.base) UnmapViewOfFile(pack.base);
+    if (pack.mapping) CloseHandle(pack.mapping);
+    if (pack.file != INVALID_HANDLE_VALUE) CloseHandle(pack.file);
+    pack.mapping = nullptr;
+    pack.file = INVALID_HANDLE_VALUE;
+#else
+    if (pack.base) munmap((void*)pack.base, pack.size);
+#endif
+    pack.base = nullptr;
+    pack.size = 0;
+}
+
+// Cita indeks i proverava da svaki unos staje u fajl
+bool readIndex() {
+    const unsigned char* cursor = pack.base;
+    const unsigned char* end = pack.base + pack.size;
+    auto read = [&](void* target, size_t bytes) {
+        if ((size_t)(end - cursor) < bytes) return false;
+        std::memcpy(target, cursor, bytes);
+        cursor += bytes;
+        return true;
+    };
+
+    char magic[8];
+    uint32_t version = 0, count = 0;
+    if (!read(magic, sizeof(magic)) || std::memcmp(magic, PACK_MAGIC, sizeof(magic)) != 0 ||
+        !read(&version, sizeof(version)) || version != PACK_VERSION || !read(&count, sizeof(count))) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t nameLength = 0;
+        PackEntry entry;
+        if (!read(&nameLength, sizeof(nameLength)) || (size_t)(end - cursor) < nameLength) return false;
+        std::string name((const char*)cursor, nameLength);
+        cursor += nameLength;
+        if (!read(&entry.offset, sizeof(entry.offset)) || !read(&entry.size, sizeof(entry.size))) return false;
+        if (entry.offset > pack.size || entry.size > pack.size - entry.offset) return false;
+        pack.index[name] = entry;
+    }
+    return true;
+}
+
+bool readLooseFile(const std::string& path, std::vector<unsigned char>& bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    std::streamoff size = file.tellg();
+    if (size < 0) return false;
+    bytes.resize((size_t)size);
+    file.seekg(0);
+    return size == 0 || (bool)file.read(reinterpret_cast<char*>(bytes.data()), size);
+}
+
+bool looseFileExists(const std::string& path) {
+    return (bool)std::ifstream(path, std::ios::binary);
+}
+
+}
+
+const char* AssetPack::DEFAULT_PACK_NAME = "assets.pak";
+
+bool AssetPack::open(const std::string& path) {
+    TRACE_SCOPE_DETAIL("AssetPack::open", path.c_str());
+    close();
+
+    if (!mapFile(path)) {
+        unmapFile();
+        return false;
+    }
+    if (!readIndex()) {
+        std::cerr << "AssetPack: neispravan paket: " << path << std::endl;
+        close();
+        return false;
+    }
+    pack.path = path;
+    std::cout << "AssetPack: " << path << " (" << pack.index.size() << " fajlova, " << pack.size / (1024 * 1024) << " MB)" << std::endl;
+    return true;
+}
+
+bool AssetPack::openDefault() {
+    std::string directory = executableDirectory();
+    if (!directory.empty() && open(directory + DEFAULT_PACK_NAME)) return true;
+    return open(DEFAULT_PACK_NAME);
+}
+
+void AssetPack::close() {
+    unmapFile();
+    pack.index.clear();
+    pack.path.clear();
+}
+
+bool AssetPack::isOpen() {
+    return pack.base != nullptr;
+}
+
+const std::string& AssetPack::path() {
+    return pack.path;
+}
+
+bool AssetPack::contains(const std::string& name) {
+    if (pack.index.count(normalizeName(name))) return true;
+    if (looseFileExists(name)) return true;
+    std::string directory = executableDirectory();
+    return !directory.empty() && looseFileExists(directory + name);
+}
+
+AssetData AssetPack::load(const std::string& name) {
+    AssetData asset;
+    auto found = pack.index.find(normalizeName(name));
+    if (found != pack.index.end()) {
+        asset.bytes = pack.base + found->second.offset;
+        asset.length = (size_t)found->second.size;
+        return asset;
+    }
+
+    std::string directory = executableDirectory();
+    if (readLooseFile(name, asset.owned) || (!directory.empty() && readLooseFile(directory + name, asset.owned))) {
+        asset.length = asset.owned.size();
+        asset.owned.push_back(0);       // Zavrsna nula: i prazan fajl ima data(), a tekst je C string
+        asset.bytes = asset.owned.data();
+    }
+    return asset;
+}
+
+std::string AssetPack::executableDirectory() {
+    static const std::string directory = [] {
+        std::string path;
+#ifdef _WIN32
+        char buffer[MAX_PATH];
+        DWORD length = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+        if (length > 0 && length < MAX_PATH) path.assign(buffer, length);
+#else
+        char buffer[4096];
+        ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
+        if (length > 0 && length < (ssize_t)sizeof(buffer)) path.assign(buffer, (size_t)length);
+#endif
+        size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }();
+    return directory;
+}
+
+bool AssetPack::write(const std::string& path, const std::vector<std::string>& files, std::ostream& log) {
+    std::vector<std::string> names;
+    std::vector<std::vector<unsigned char>> contents;
+    for (const std::string& file : files) {
+        std::vector<unsigned char> bytes;
+        if (!readLooseFile(file, bytes)) {
+            log << "AssetPack: preskacem (ne postoji): " << file << std::endl;
+            continue;
+        }
+        names.push_back(normalizeName(file));
+        contents.push_back(std::move(bytes));
+    }
+
+    uint64_t indexBytes = sizeof(PACK_MAGIC) + 2 * sizeof(uint32_t);
+    for (const std::string& name : names) indexBytes += sizeof(uint32_t) + name.size() + 2 * sizeof(uint64_t);
+
+    std::vector<PackEntry> entries;
+    uint64_t offset = indexBytes;
+    for (const std::vector<unsigned char>& bytes : contents) {
+        offset = (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        entries.push_back(PackEntry{ offset, (uint64_t)bytes.size() });
+        offset += bytes.size();
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        log << "AssetPack: ne mogu da pisem " << path << std::endl;
+        return false;
+    }
+    uint32_t count = (uint32_t)names.size();
+    out.write(PACK_MAGIC, sizeof(PACK_MAGIC));
+    out.write(reinterpret_cast<const char*>(&PACK_VERSION), sizeof(PACK_VERSION));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (size_t i = 0; i < names.size(); ++i) {
+        uint32_t nameLength = (uint32_t)names[i].size();
+        out.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        out.write(names[i].data(), nameLength);
+        out.write(reinterpret_cast<const char*>(&entries[i].offset), sizeof(entries[i].offset));
+        out.write(reinterpret_cast<const char*>(&entries[i].size), sizeof(entries[i].size));
+    }
+
+    uint64_t position = indexBytes;
+    const char padding[DATA_ALIGNMENT] = {};
+    for (size_t i = 0; i < contents.size(); ++i) {
+        out.write(padding, (std::streamsize)(entries[i].offset - position));
+        out.write(reinterpret_cast<const char*>(contents[i].data()), (std::streamsize)contents[i].size());
+        position = entries[i].offset + entries[i].size;
+        log << "  " << names[i] << " " << contents[i].size() / 1024 << " KB" << std::endl;
+    }
+    log << "AssetPack: " << path << " (" << names.size() << " fajlova, " << position / 1024 << " KB)" << std::endl;
+    return (bool)out;
+}
@@ -0,0 +1,60 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Bajtovi jednog asseta: pokazivac u mapirani paket (bez kopije) ili u sopstveni bafer
+// kad je fajl procitan sa diska. Vazi dok postoji objekat (paket ostaje mapiran do close()).
+class AssetData {
+public:
+    AssetData() : bytes(nullptr), length(0) {}
+    AssetData(AssetData&&) = default;
+    AssetData& operator=(AssetData&&) = default;
+    AssetData(const AssetData&) = delete;
+    AssetData& operator=(const AssetData&) = delete;
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool empty() const { return bytes == nullptr; }
+    bool fromPack() const { return bytes != nullptr && owned.empty(); }
+
+private:
+    friend class AssetPack;
+    const unsigned char* bytes;
+    size_t length;
+    std::vector<unsigned char> owned;
+};
+
+// Svi seideri, teksture i font u jednom indeksiranom fajlu (assets.pak) koji se mapira u memoriju:
+// jedan open i jedno mapiranje umesto ~60 otvaranja fajlova, a dekoderi dobijaju bajtove direktno.
+//
+//   AssetPack::openDefault();                              // glavna nit, pre radnih niti
+//   AssetData png = AssetPack::load("earth-trivia.png");   // paket, pa fajl na disku
+//   stbi_load_from_memory(png.data(), (int)png.size(), ...);
+//
+// Paket se trazi pored exe fajla, pa u radnom folderu. Asset kojeg nema u paketu (ili bez paketa)
+// se cita sa diska relativno na radni folder, pa na folder exe fajla, pa program ne zavisi od
+// toga odakle je pokrenut. Pakuje ga SV68-2021-Packer; load/contains su bezbedni iz vise niti.
+class AssetPack {
+public:
+    static const char* DEFAULT_PACK_NAME;
+
+    static bool open(const std::string& path);
+    static bool openDefault();
+    static void close();
+    static bool isOpen();
+    static const std::string& path();
+
+    static bool contains(const std::string& name);     // U paketu ili na disku
+    static AssetData load(const std::string& name);    // empty() ako ne postoji nigde
+
+    static std::string executableDirectory();          // Sa zavrsnim '/', prazan ako nije poznat
+
+    // Indeks + podaci poravnati na 16 B; imena ostaju onakva kakva su data (bez pocetnog "./")
+    static bool write(const std::string& path, const std::vector<std::string>& files, std::ostream& log);
+};
+
+#endif // ASSET_PACK_H
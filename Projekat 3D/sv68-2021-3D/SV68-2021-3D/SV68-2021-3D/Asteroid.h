@@ -3,6 +3,7 @@
 
 #include <glad/glad.h>  // Must be first
 #include <GLFW/glfw3.h> // Then GLFW
+#include <memory>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
@@ -11,29 +12,30 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/string_cast.hpp>
+#include "MeshRegistry.h"
 
 
 
+// Broj nepravilnih stena po pojasu (AsteroidVariantSet); varijanta instance staje u jedan bajt
+const int DEFAULT_ASTEROID_VARIANTS = 32;
+const int MAX_ASTEROID_VARIANTS = 256;
+
 class Asteroid {
 public:
-    std::vector<float> sphere_vertices;
-    std::vector<int> sphere_indices;
-    GLuint VBO, VAO, EBO;
-    float radius;
-    int sectorCount;
-    int stackCount;
-
-
-    void generateVertices();
-    void generateIndices();
-    void setupMesh();
+    std::shared_ptr<const SphereMesh> mesh;     // Deljena jedinicna ikosfera (MeshRegistry), 16-bit indeksi
+    std::shared_ptr<const AsteroidVariantSet> variants;    // Pozicije stena; mesh daje indekse i UV
+    GLuint VAO;             // Sopstveni VAO nad deljenim baferima: AsteroidBelt mu dodaje atribute instanci
+    float radius;           // Ne ulazi u verteks; AsteroidBelt ga dodaje u matrice instanci
+    int subdivisions;
 
     float x;
     float y;
     float z;
 
-    Asteroid(float r, int sectors, int stacks, float x = 0.0f, float y = 0.0f, float z = 0.0f);
+    Asteroid(float r, int subdivisions, int variantCount, float x = 0.0f, float y = 0.0f, float z = 0.0f);
     ~Asteroid();
+    Asteroid(const Asteroid&) = delete;
+    Asteroid& operator=(const Asteroid&) = delete;
 };
 
 #endif // ASTEROID_H
@@ -1,45 +1,31 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "AsteroidBelt.h"
+#include "OrbitMath.h"
+#include "GpuMemory.h"
 
-AsteroidBelt::AsteroidBelt(int count, float inner, float outer)
-    : numAsteroids(count), innerRadius(inner), outerRadius(outer), baseAsteroid(0.3f, 8, 8) {
+AsteroidBelt::AsteroidBelt(int count, float inner, float outer, unsigned int seed, int variantCount)
+    : baseAsteroid(0.3f, 1, variantCount), numAsteroids(count), innerRadius(inner), outerRadius(outer), seed(seed) {
     generateAsteroids();
     setupInstancedRendering();
 }
 
 
 AsteroidBelt::~AsteroidBelt() {
+    GpuMemory::release(GPU_BUFFER, instanceVBO);
     glDeleteBuffers(1, &instanceVBO);
-    modelMatrices.clear();
+    GpuMemory::release(GPU_BUFFER, variantVBO);
+    glDeleteBuffers(1, &variantVBO);
 }
 
 
 void AsteroidBelt::generateAsteroids() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-    std::uniform_real_distribution<float> radiusDist(innerRadius, outerRadius);
-    std::uniform_real_distribution<float> heightDist(-1.0f, 1.0f);
+    generateBeltInstances(numAsteroids, innerRadius, outerRadius, seed, instances);
 
-    modelMatrices.clear();
-
-    for (int i = 0; i < numAsteroids; ++i) {
-        float angle = angleDist(gen);
-        float radius = radiusDist(gen);
-        float height = heightDist(gen);
-
-        float x = radius * cos(angle);
-        float y = height;
-        float z = radius * sin(angle);
-
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(x, y, z));
-        model = glm::scale(model, glm::vec3(0.05f));
-
-        modelMatrices.push_back(model);
-    }
+    // Mreza je jedinicna sfera, pa velicina baznog asteroida ide u skalu svake instance
+    for (glm::vec4& instance : instances) instance.w *= baseAsteroid.radius;
 
+    generateBeltVariants(numAsteroids, baseAsteroid.variants->variantCount(), seed, instanceVariants);
 }
 
 
@@ -48,16 +34,30 @@ void AsteroidBelt::setupInstancedRendering() {
     glGenBuffers(1, &instanceVBO);
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
 
-    glBufferData(GL_ARRAY_BUFFER, numAsteroids * sizeof(glm::mat4), &modelMatrices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, numAsteroids * sizeof(glm::vec4), instances.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, instanceVBO, numAsteroids * sizeof(glm::vec4), "AsteroidBelt instances", GPU_MEMORY_SITE);
+
+    // Jedan vec4 po instanci umesto cetiri kolone mat4; sejder sam pravi poziciju (asteroids.vert)
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+    glVertexAttribDivisor(2, 1);
 
-    for (int i = 0; i < 4; i++) {
-        glEnableVertexAttribArray(2 + i);
-        glVertexAttribPointer(2 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * i));
-        glVertexAttribDivisor(2 + i, 1);
-    }
+    // Varijanta stene, jedan bajt po instanci u svom baferu (celobrojni atribut)
+    glGenBuffers(1, &variantVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, variantVBO);
+    glBufferData(GL_ARRAY_BUFFER, numAsteroids * sizeof(unsigned char), instanceVariants.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, variantVBO, numAsteroids * sizeof(unsigned char), "AsteroidBelt variants", GPU_MEMORY_SITE);
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(unsigned char), (void*)0);
+    glVertexAttribDivisor(3, 1);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    // CPU kopije nisu potrebne posle slanja
+    std::vector<glm::vec4>().swap(instances);
+    std::vector<unsigned char>().swap(instanceVariants);
 }
 
 
@@ -76,17 +76,18 @@ void AsteroidBelt::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4&
     glBindTexture(GL_TEXTURE_2D, textureID);
     glUniform1i(glGetUniformLocation(shaderProgram, "asteroidTexture"), 0);
 
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, baseAsteroid.variants->positionTexture());
+    glUniform1i(glGetUniformLocation(shaderProgram, "variantPositions"), 1);
+    glUniform1i(glGetUniformLocation(shaderProgram, "variantVertexCount"), baseAsteroid.variants->vertexCount());
+    glActiveTexture(GL_TEXTURE0);
+
     glBindVertexArray(baseAsteroid.VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(baseAsteroid.sphere_indices.size()), GL_UNSIGNED_INT, 0, numAsteroids);
+    glDrawElementsInstanced(GL_TRIANGLES, baseAsteroid.mesh->indexCount(), baseAsteroid.mesh->indexType(), 0, numAsteroids);
     glBindVertexArray(0);
 }
 
 bool AsteroidBelt::isInsideBelt(glm::vec3 cameraPos) {
-    float distance = glm::length(cameraPos);    //razdaljina od (0, 0, 0)
-
-    if (distance >= innerRadius && distance <= outerRadius && -1.0f <= cameraPos.y && cameraPos.y <= 1.0f) {
-        return true;
-    }
-    return false;
+    return isInsideBeltVolume(cameraPos, innerRadius, outerRadius);
 }
 
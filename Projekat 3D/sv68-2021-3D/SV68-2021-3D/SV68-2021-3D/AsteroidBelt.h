@@ -14,12 +14,15 @@
 class AsteroidBelt {
 public:
     Asteroid baseAsteroid;
-    std::vector<glm::mat4> modelMatrices;
+    std::vector<glm::vec4> instances;       // xyz = pozicija, w = skala (16 bajtova); prazan posle slanja na GPU
+    std::vector<unsigned char> instanceVariants;    // Varijanta stene po instanci; prazan posle slanja na GPU
     int numAsteroids;
     float innerRadius, outerRadius;
     GLuint instanceVBO;
+    GLuint variantVBO;
+    unsigned int seed;      // 0 = nasumican raspored (random_device)
 
-    AsteroidBelt(int count, float inner, float outer);
+    AsteroidBelt(int count, float inner, float outer, unsigned int seed = 0, int variantCount = DEFAULT_ASTEROID_VARIANTS);
     ~AsteroidBelt();
 
     void generateAsteroids();
@@ -0,0 +1,146 @@
+#include "AtlasLayout.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+AtlasLayout::AtlasLayout(int maxPageSize)
+    : maxPageSize(maxPageSize), pages(0), usedWidth(0), usedHeight(0) {
+}
+
+int AtlasLayout::cellSize(int size) {
+    const int align = 1 << (MIP_LEVELS - 1);
+    return (size + 2 * GUTTER + align - 1) / align * align;
+}
+
+void AtlasLayout::add(const std::string& name, int width, int height) {
+    for (const Entry& entry : entries) {
+        if (entry.name == name) return;
+    }
+    entries.push_back(Entry{ name, width, height });
+}
+
+void AtlasLayout::setMaxPageSize(int size) {
+    maxPageSize = size;
+}
+
+int AtlasLayout::largestCell() const {
+    int largest = 0;
+    for (const Entry& entry : entries) largest = std::max(largest, std::max(cellSize(entry.width), cellSize(entry.height)));
+    return largest;
+}
+
+void AtlasLayout::pack() {
+    rects.clear();
+    pages = 0;
+    usedWidth = 0;
+    usedHeight = 0;
+
+    // Vise slike prve, pa su police sto nize; redosled jednakih ostaje kao u add()
+    std::vector<const Entry*> order;
+    for (const Entry& entry : entries) order.push_back(&entry);
+    std::stable_sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) { return a->height > b->height; });
+
+    int x = 0, y = 0, shelfHeight = 0;
+    for (const Entry* entry : order) {
+        int cellWidth = cellSize(entry->width);
+        int cellHeight = cellSize(entry->height);
+        if (entry->width <= 0 || entry->height <= 0 || cellWidth > maxPageSize || cellHeight > maxPageSize) {
+            std::cerr << "AtlasLayout: slika ne staje u stranicu " << maxPageSize << "x" << maxPageSize << ": " << entry->name << std::endl;
+            continue;
+        }
+
+        if (pages == 0) pages = 1;
+        if (x + cellWidth > maxPageSize) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (y + cellHeight > maxPageSize) {
+            pages++;
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+
+        AtlasRect rect;
+        rect.page = pages - 1;
+        rect.x = x + GUTTER;
+        rect.y = y + GUTTER;
+        rect.width = entry->width;
+        rect.height = entry->height;
+        rects[entry->name] = rect;
+
+        x += cellWidth;
+        shelfHeight = std::max(shelfHeight, cellHeight);
+        usedWidth = std::max(usedWidth, x);
+        usedHeight = std::max(usedHeight, y + shelfHeight);
+    }
+}
+
+int AtlasLayout::pageCount() const {
+    return pages;
+}
+
+int AtlasLayout::pageWidth() const {
+    return usedWidth;
+}
+
+int AtlasLayout::pageHeight() const {
+    return usedHeight;
+}
+
+int AtlasLayout::imageCount() const {
+    return (int)rects.size();
+}
+
+AtlasRect AtlasLayout::find(const std::string& name) const {
+    auto found = rects.find(name);
+    return (found != rects.end()) ? found->second : AtlasRect();
+}
+
+void AtlasLayout::uv(const AtlasRect& rect, float& u0, float& v0, float& u1, float& v1) const {
+    u0 = (float)rect.x / usedWidth;
+    v0 = (float)rect.y / usedHeight;
+    u1 = (float)(rect.x + rect.width) / usedWidth;
+    v1 = (float)(rect.y + rect.height) / usedHeight;
+}
+
+float AtlasLayout::occupancy() const {
+    if (pages == 0) return 0.0f;
+    long long pixels = 0;
+    for (const auto& pair : rects) pixels += (long long)pair.second.width * pair.second.height;
+    return 100.0f * pixels / ((long long)usedWidth * usedHeight * pages);
+}
+
+void AtlasLayout::withGutter(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& cell,
+    int& cellWidth, int& cellHeight) {
+    cellWidth = cellSize(width);
+    cellHeight = cellSize(height);
+    cell.resize((size_t)cellWidth * cellHeight * 4);
+
+    // Ivica (i poravnanje do celije) ponavlja najblizi piksel slike
+    for (int y = 0; y < cellHeight; ++y) {
+        int sourceY = std::min(std::max(y - GUTTER, 0), height - 1);
+        const unsigned char* row = rgba + (size_t)sourceY * width * 4;
+        unsigned char* out = &cell[(size_t)y * cellWidth * 4];
+        for (int x = 0; x < GUTTER; ++x) std::memcpy(out + x * 4, row, 4);
+        std::memcpy(out + GUTTER * 4, row, (size_t)width * 4);
+        for (int x = GUTTER + width; x < cellWidth; ++x) std::memcpy(out + x * 4, row + (size_t)(width - 1) * 4, 4);
+    }
+}
+
+void AtlasLayout::halveCell(const std::vector<unsigned char>& cell, int cellWidth, int cellHeight, std::vector<unsigned char>& out) {
+    int outWidth = cellWidth / 2;
+    int outHeight = cellHeight / 2;
+    out.resize((size_t)outWidth * outHeight * 4);
+    for (int y = 0; y < outHeight; ++y) {
+        const unsigned char* row0 = &cell[(size_t)(y * 2) * cellWidth * 4];
+        const unsigned char* row1 = row0 + (size_t)cellWidth * 4;
+        unsigned char* dst = &out[(size_t)y * outWidth * 4];
+        for (int x = 0; x < outWidth * 4; ++x) {
+            int c = x % 4 + (x / 4) * 8;
+            dst[x] = (unsigned char)((row0[c] + row0[c + 4] + row1[c] + row1[c + 4] + 2) / 4);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef ATLAS_LAYOUT_H
+#define ATLAS_LAYOUT_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Polozaj slike u atlasu: stranica (sloj GL_TEXTURE_2D_ARRAY) i pravougaonik bez ivice
+struct AtlasRect {
+    int page = -1;              // -1 = slika nije u atlasu
+    int x = 0, y = 0;           // Gornji levi ugao u pikselima stranice
+    int width = 0, height = 0;
+};
+
+// Raspored UI slika (trivia kartice) u stranicama atlasa, izracunat iz zaglavlja slika pre dekodiranja.
+//
+//   AtlasLayout layout(4096);
+//   layout.add("earth", 1100, 215);
+//   layout.pack();                            // police po visini; sve stranice iste velicine
+//   AtlasRect rect = layout.find("earth");    // + uv() za UI kvad
+//
+// Svaka slika dobija celiju sa ivicom od GUTTER ponovljenih piksela; celije pocinju i imaju velicinu
+// deljivu sa 1 << (MIP_LEVELS - 1), pa mip nivoi do MIP_LEVELS - 1 nikad ne mesaju susedne slike.
+// Ne zavisi od GL zaglavlja; pikseli i teksture su posao aplikacije.
+class AtlasLayout {
+public:
+    static const int GUTTER = 4;
+    static const int MIP_LEVELS = 3;
+
+    explicit AtlasLayout(int maxPageSize);
+
+    // Pre pack(); ponovljeno ime se ignorise
+    void add(const std::string& name, int width, int height);
+    void setMaxPageSize(int size);
+    int largestCell() const;        // Najveca strana celije medju dodatim slikama
+    void pack();
+
+    int pageCount() const;
+    int pageWidth() const;
+    int pageHeight() const;
+    int imageCount() const;
+
+    AtlasRect find(const std::string& name) const;
+    // u0, v0 = gornji levi ugao slike (red 0 stranice je gornji red slike)
+    void uv(const AtlasRect& rect, float& u0, float& v0, float& u1, float& v1) const;
+    // Procenat stranica koji pokrivaju same slike (bez ivica i praznog prostora)
+    float occupancy() const;
+
+    // RGBA slika (redovi odozgo) -> celija za glTexSubImage na (rect.x - GUTTER, rect.y - GUTTER)
+    static void withGutter(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& cell,
+        int& cellWidth, int& cellHeight);
+    // Sledeci mip nivo celije (prosek 2x2); velicina celije je deljiva sa 2 za svaki nivo do MIP_LEVELS - 1
+    static void halveCell(const std::vector<unsigned char>& cell, int cellWidth, int cellHeight, std::vector<unsigned char>& out);
+    static int cellSize(int size);
+
+private:
+    struct Entry {
+        std::string name;
+        int width, height;
+    };
+
+    int maxPageSize;
+    int pages;
+    int usedWidth;
+    int usedHeight;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, AtlasRect> rects;
+};
+
+#endif // ATLAS_LAYOUT_H
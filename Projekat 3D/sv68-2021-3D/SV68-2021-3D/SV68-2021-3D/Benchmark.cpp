@@ -0,0 +1,307 @@
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+static void printBenchmarkUsage() {
+    std::cout << "Usage: SV68-2021-3D-Bench [--frames N] [--warmup N] [--dt SECONDS] [--width W] [--height H] [--trace FILE.json] [--replay FILE.cam]" << std::endl;
+    std::cout << "       [--gl-stats] [--max-gl-calls N] [--max-draw-calls N] [--max-redundant N] [--max-gl-creates N]" << std::endl;
+    std::cout << "       [--bodies N[,N...]] [--moons M[,M...]] [--asteroids K[,K...]] [--sweep-out FILE.csv]" << std::endl;
+    std::cout << "       [--no-image-cache] [--ring-particles N] [--terrain] [--terrain-height SCALE] [--trivia-budget-mb N]" << std::endl;
+    std::cout << "Run from the asset directory (shaders and textures are loaded by relative path)." << std::endl;
+}
+
+// "10,100,1000" -> {10, 100, 1000}; negativne vrednosti se odbacuju
+static std::vector<int> parseIntList(const char* text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) continue;
+        int value = std::atoi(item.c_str());
+        if (value >= 0) values.push_back(value);
+    }
+    return values;
+}
+
+BenchmarkOptions parseBenchmarkArgs(int argc, char** argv) {
+    BenchmarkOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--warmup") == 0 && hasValue) {
+            options.warmupFrames = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--dt") == 0 && hasValue) {
+            options.deltaTime = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--width") == 0 && hasValue) {
+            options.width = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--height") == 0 && hasValue) {
+            options.height = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && hasValue) {
+            options.tracePath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--no-image-cache") == 0) {
+            options.imageCache = false;
+        }
+        else if (std::strcmp(arg, "--ring-particles") == 0 && hasValue) {
+            options.ringParticles = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--terrain") == 0) {
+            options.terrain = true;
+        }
+        else if (std::strcmp(arg, "--terrain-height") == 0 && hasValue) {
+            options.terrain = true;
+            options.terrainHeight = std::max(0.0f, (float)std::atof(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--trivia-budget-mb") == 0 && hasValue) {
+            options.triviaBudgetBytes = std::max(0LL, std::atoll(argv[++i])) * 1024 * 1024;
+        }
+        else if (std::strcmp(arg, "--gl-stats") == 0) {
+            options.glStats = true;
+        }
+        else if (std::strcmp(arg, "--max-gl-calls") == 0 && hasValue) {
+            options.maxGLCalls = std::atoll(argv[++i]);
+            options.glStats = true;
+        }
+        else if (std::strcmp(arg, "--max-draw-calls") == 0 && hasValue) {
+            options.maxDrawCalls = std::atoll(argv[++i]);
+            options.glStats = true;
+        }
+        else if (std::strcmp(arg, "--max-redundant") == 0 && hasValue) {
+            options.maxRedundantState = std::atoll(argv[++i]);
+            options.glStats = true;
+        }
+        else if (std::strcmp(arg, "--max-gl-creates") == 0 && hasValue) {
+            options.maxObjectsCreated = std::atoll(argv[++i]);
+            options.glStats = true;
+        }
+        else if (std::strcmp(arg, "--bodies") == 0 && hasValue) {
+            options.stressBodies = parseIntList(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--moons") == 0 && hasValue) {
+            options.stressMoons = parseIntList(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--asteroids") == 0 && hasValue) {
+            options.stressAsteroids = parseIntList(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--sweep-out") == 0 && hasValue) {
+            options.sweepOutPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--help") == 0) {
+            printBenchmarkUsage();
+            std::exit(0);
+        }
+        else {
+            std::cerr << "Nepoznat argument: " << arg << std::endl;
+            printBenchmarkUsage();
+        }
+    }
+
+    return options;
+}
+
+static bool checkLimit(const char* name, long long limit, long long value, std::ostream& out) {
+    if (limit < 0 || value <= limit) return true;
+    out << "GL budget exceeded: " << name << " = " << value << " (limit " << limit << ")" << std::endl;
+    return false;
+}
+
+bool checkGLBudget(const BenchmarkOptions& options, const GLCounters& peakFrame, std::ostream& out) {
+    bool ok = true;
+    ok &= checkLimit("gl calls / frame", options.maxGLCalls, peakFrame.calls, out);
+    ok &= checkLimit("draw calls / frame", options.maxDrawCalls, peakFrame.drawCalls, out);
+    ok &= checkLimit("redundant state sets / frame", options.maxRedundantState, peakFrame.redundantStateSets(), out);
+    ok &= checkLimit("objects created / frame", options.maxObjectsCreated, peakFrame.objectsCreated, out);
+    return ok;
+}
+
+bool queryProcessMemory(size_t& currentBytes, size_t& peakBytes) {
+    currentBytes = 0;
+    peakBytes = 0;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return false;
+    currentBytes = counters.WorkingSetSize;
+    peakBytes = counters.PeakWorkingSetSize;
+    return true;
+#else
+    // /proc/self/status: VmRSS = trenutno, VmHWM = maksimum (u kB)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) currentBytes = std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+        else if (line.compare(0, 6, "VmHWM:") == 0) peakBytes = std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+    }
+    return currentBytes != 0;
+#endif
+}
+
+GLFWwindow* initializeHeadlessOpenGL(int width, int height) {
+    struct ContextAttempt {
+        int platform;
+        int contextApi;
+        const char* name;
+    };
+
+    const ContextAttempt attempts[] = {
+        { GLFW_PLATFORM_NULL, GLFW_OSMESA_CONTEXT_API, "null platform + OSMesa" },
+        { GLFW_ANY_PLATFORM, GLFW_EGL_CONTEXT_API, "EGL" },
+        { GLFW_ANY_PLATFORM, GLFW_NATIVE_CONTEXT_API, "hidden native window" },
+    };
+
+    for (const ContextAttempt& attempt : attempts) {
+        if (attempt.platform != GLFW_ANY_PLATFORM && !glfwPlatformSupported(attempt.platform)) {
+            continue;
+        }
+
+        glfwInitHint(GLFW_PLATFORM, attempt.platform);
+        if (!glfwInit()) {
+            continue;
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, attempt.contextApi);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        GLFWwindow* window = glfwCreateWindow(width, height, "3D Suncev sistem - benchmark", nullptr, nullptr);
+        if (!window) {
+            glfwTerminate();
+            continue;
+        }
+        glfwMakeContextCurrent(window);
+
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cerr << "GLAD initialization failed!" << std::endl;
+            glfwTerminate();
+            return nullptr;
+        }
+
+        std::cout << "Headless context: " << attempt.name
+            << " (" << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << ")" << std::endl;
+        return window;
+    }
+
+    std::cerr << "Headless context creation failed (OSMesa, EGL and hidden window)!" << std::endl;
+    return nullptr;
+}
+
+OffscreenTarget::OffscreenTarget(int width, int height)
+    : FBO(0), colorRBO(0), depthRBO(0), width(width), height(height) {
+    glGenFramebuffers(1, &FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+    glGenRenderbuffers(1, &colorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRBO);
+
+    glGenRenderbuffers(1, &depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+
+    if (!isComplete()) {
+        std::cerr << "Offscreen framebuffer nije kompletan!" << std::endl;
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    glDeleteFramebuffers(1, &FBO);
+    glDeleteRenderbuffers(1, &colorRBO);
+    glDeleteRenderbuffers(1, &depthRBO);
+}
+
+bool OffscreenTarget::isComplete() const {
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+    return complete;
+}
+
+void OffscreenTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glViewport(0, 0, width, height);
+}
+
+void FrameTimeReport::addFrame(double milliseconds) {
+    frameTimesMs.push_back(milliseconds);
+}
+
+size_t FrameTimeReport::frameCount() const {
+    return frameTimesMs.size();
+}
+
+double FrameTimeReport::mean() const {
+    if (frameTimesMs.empty()) return 0.0;
+    return std::accumulate(frameTimesMs.begin(), frameTimesMs.end(), 0.0) / frameTimesMs.size();
+}
+
+// Nearest-rank percentil (p u opsegu 0-100)
+double FrameTimeReport::percentile(double p) const {
+    if (frameTimesMs.empty()) return 0.0;
+
+    std::vector<double> sorted = frameTimesMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    rank = std::min(std::max(rank, (size_t)1), sorted.size());
+    return sorted[rank - 1];
+}
+
+double FrameTimeReport::worst(size_t* frameIndex) const {
+    if (frameTimesMs.empty()) return 0.0;
+
+    auto it = std::max_element(frameTimesMs.begin(), frameTimesMs.end());
+    if (frameIndex) *frameIndex = static_cast<size_t>(it - frameTimesMs.begin());
+    return *it;
+}
+
+void FrameTimeReport::print(std::ostream& out) const {
+    size_t worstFrame = 0;
+    double worstMs = worst(&worstFrame);
+    double meanMs = mean();
+
+    out << std::fixed << std::setprecision(3);
+    out << "==================== FRAME TIME REPORT ====================" << std::endl;
+    out << "frames: " << frameCount() << std::endl;
+    out << "mean:   " << meanMs << " ms (" << (meanMs > 0.0 ? 1000.0 / meanMs : 0.0) << " FPS)" << std::endl;
+    out << "p50:    " << percentile(50.0) << " ms" << std::endl;
+    out << "p95:    " << percentile(95.0) << " ms" << std::endl;
+    out << "p99:    " << percentile(99.0) << " ms" << std::endl;
+    out << "worst:  " << worstMs << " ms (frame " << worstFrame << ")" << std::endl;
+    out << "===========================================================" << std::endl;
+}
@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include <string>
+#include <ostream>
+#include "GLStats.h"
+
+// Parametri headless benchmark rezima (SV68-2021-3D-Bench target)
+struct BenchmarkOptions {
+    int frames = 1000;                  // Broj merenih frejmova
+    int warmupFrames = 30;              // Frejmovi koji se ne racunaju (drajver, kesevi)
+    float deltaTime = 1.0f / 60.0f;     // Fiksni korak simulacije po frejmu
+    int width = 1600;
+    int height = 800;
+    std::string tracePath;              // --trace: Chrome trace JSON na kraju merenja
+    std::string replayPath;             // --replay: snimljena putanja kamere umesto staticne kamere
+    bool imageCache = true;             // --no-image-cache: teksture se uvek dekodiraju (ImageCache iskljucen)
+    int ringParticles = 0;              // --ring-particles: Saturnov prsten i kao N stena (SaturnRing), 0 = samo traka
+    bool terrain = false;               // --terrain: povrsina tela izbliza kao quadtree zakrpa (SurfaceTerrain)
+    float terrainHeight = 0.0f;         // --terrain-height: visine iz svetline teksture tela, u poluprecnicima (ukljucuje --terrain)
+    long long triviaBudgetBytes = 32LL * 1024 * 1024;   // --trivia-budget-mb: VRAM za kartice sa detaljima (UiAtlas)
+
+    // GL brojaci (--gl-stats); granice se porede sa najgorim merenim frejmom, -1 = bez provere
+    bool glStats = false;
+    long long maxGLCalls = -1;
+    long long maxDrawCalls = -1;
+    long long maxRedundantState = -1;
+    long long maxObjectsCreated = -1;
+
+    // Stres scena umesto Suncevog sistema (--bodies/--moons/--asteroids, vrednosti razdvojene zarezom).
+    // Svaka kombinacija je jedna tacka sweep-a; rezultati idu u sweepOutPath (CSV).
+    std::vector<int> stressBodies;
+    std::vector<int> stressMoons;       // Po telu
+    std::vector<int> stressAsteroids;   // Po pojasu (3 pojasa)
+    std::string sweepOutPath = "stress-sweep.csv";
+
+    bool stressMode() const { return !stressBodies.empty() || !stressMoons.empty() || !stressAsteroids.empty(); }
+};
+
+BenchmarkOptions parseBenchmarkArgs(int argc, char** argv);
+
+// Ispisuje svaku prekoracenu granicu; false ako je bar jedna prekoracena
+bool checkGLBudget(const BenchmarkOptions& options, const GLCounters& peakFrame, std::ostream& out);
+
+// Memorija procesa (working set / RSS) i njen maksimum; false ako platforma ne daje podatak
+bool queryProcessMemory(size_t& currentBytes, size_t& peakBytes);
+
+// Kreira OpenGL 3.3 core kontekst bez vidljivog prozora.
+// Redom probava: GLFW null platformu + OSMesa (Mesa llvmpipe, bez GPU-a i displeja),
+// EGL kontekst, i na kraju skriveni nativni prozor.
+GLFWwindow* initializeHeadlessOpenGL(int width, int height);
+
+// Framebuffer u koji se renderuje kada nema prozora
+class OffscreenTarget {
+private:
+    GLuint FBO, colorRBO, depthRBO;
+    int width, height;
+
+public:
+    OffscreenTarget(int width, int height);
+    ~OffscreenTarget();
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    bool isComplete() const;
+    void bind() const;
+};
+
+// Skuplja vremena frejmova i ispisuje mean/p50/p95/p99/worst
+class FrameTimeReport {
+private:
+    std::vector<double> frameTimesMs;
+
+public:
+    void addFrame(double milliseconds);
+    size_t frameCount() const;
+    double mean() const;
+    double percentile(double p) const;
+    double worst(size_t* frameIndex = nullptr) const;
+    void print(std::ostream& out) const;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,131 @@
+#include "CameraPath.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[8] = { 'S', 'V', '6', '8', 'C', 'A', 'M', '\0' };
+const uint32_t VERSION = 1;
+const size_t RECORD_SIZE = 9 * sizeof(float) + 2;
+
+uint8_t encodePolygonMode(GLenum mode) {
+    if (mode == GL_LINE) return 1;
+    if (mode == GL_POINT) return 2;
+    return 0;
+}
+
+GLenum decodePolygonMode(uint8_t mode) {
+    if (mode == 1) return GL_LINE;
+    if (mode == 2) return GL_POINT;
+    return GL_FILL;
+}
+
+} // namespace
+
+CameraRecorder::CameraRecorder()
+    : frames(0) {
+}
+
+bool CameraRecorder::open(const std::string& path, unsigned int asteroidSeed) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "CameraRecorder: ne mogu da otvorim " << path << std::endl;
+        return false;
+    }
+
+    uint32_t seed = asteroidSeed;
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+    frames = 0;
+    return true;
+}
+
+bool CameraRecorder::isOpen() const {
+    return file.is_open();
+}
+
+void CameraRecorder::write(const CameraFrame& frame) {
+    if (!file.is_open()) return;
+
+    float values[9] = {
+        frame.position.x, frame.position.y, frame.position.z,
+        frame.front.x, frame.front.y, frame.front.z,
+        frame.fov, frame.speedMultiplier, frame.deltaTime,
+    };
+    char record[RECORD_SIZE];
+    std::memcpy(record, values, sizeof(values));
+    record[sizeof(values)] = frame.showOrbits ? 1 : 0;
+    record[sizeof(values) + 1] = static_cast<char>(encodePolygonMode(frame.polygonMode));
+
+    file.write(record, RECORD_SIZE);
+    frames++;
+}
+
+int CameraRecorder::frameCount() const {
+    return frames;
+}
+
+CameraReplay::CameraReplay()
+    : cursor(0), seed(0) {
+}
+
+bool CameraReplay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "CameraReplay: ne mogu da otvorim " << path << std::endl;
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0, fileSeed = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&fileSeed), sizeof(fileSeed));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+        std::cerr << "CameraReplay: " << path << " nije snimak kamere (verzija " << VERSION << ")" << std::endl;
+        return false;
+    }
+
+    frames.clear();
+    char record[RECORD_SIZE];
+    while (file.read(record, RECORD_SIZE)) {
+        float values[9];
+        std::memcpy(values, record, sizeof(values));
+
+        CameraFrame frame;
+        frame.position = glm::vec3(values[0], values[1], values[2]);
+        frame.front = glm::vec3(values[3], values[4], values[5]);
+        frame.fov = values[6];
+        frame.speedMultiplier = values[7];
+        frame.deltaTime = values[8];
+        frame.showOrbits = record[sizeof(values)] != 0;
+        frame.polygonMode = decodePolygonMode(static_cast<uint8_t>(record[sizeof(values) + 1]));
+        frames.push_back(frame);
+    }
+
+    seed = fileSeed;
+    cursor = 0;
+    std::cout << "CameraReplay: " << frames.size() << " frejmova iz " << path << " (seed " << seed << ")" << std::endl;
+    return !frames.empty();
+}
+
+bool CameraReplay::isLoaded() const {
+    return !frames.empty();
+}
+
+bool CameraReplay::next(CameraFrame& frame) {
+    if (cursor >= frames.size()) return false;
+    frame = frames[cursor++];
+    return true;
+}
+
+int CameraReplay::frameCount() const {
+    return static_cast<int>(frames.size());
+}
+
+unsigned int CameraReplay::asteroidSeed() const {
+    return seed;
+}
@@ -0,0 +1,58 @@
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Seed asteroida za snimanje i benchmark - isti raspored pojaseva u svakom pokretanju
+const unsigned int FIXED_ASTEROID_SEED = 2021;
+
+// Sve sto odredjuje sadrzaj jednog frejma 3D scene
+struct CameraFrame {
+    glm::vec3 position;
+    glm::vec3 front;
+    float fov;
+    float speedMultiplier;
+    float deltaTime;
+    bool showOrbits;
+    GLenum polygonMode;     // GL_FILL, GL_LINE ili GL_POINT
+};
+
+// Binarni zapis putanje: zaglavlje (magic "SV68CAM", verzija, seed asteroida)
+// i zatim RECORD_SIZE bajtova po frejmu (little-endian, kao na x86).
+// Frejmovi se pisu odmah, pa prekinuto snimanje ostaje citljivo.
+class CameraRecorder {
+private:
+    std::ofstream file;
+    int frames;
+
+public:
+    CameraRecorder();
+
+    bool open(const std::string& path, unsigned int asteroidSeed);
+    bool isOpen() const;
+    void write(const CameraFrame& frame);
+    int frameCount() const;
+};
+
+// Cela putanja se ucitava unapred, da citanje sa diska ne ulazi u merenje
+class CameraReplay {
+private:
+    std::vector<CameraFrame> frames;
+    size_t cursor;
+    unsigned int seed;
+
+public:
+    CameraReplay();
+
+    bool load(const std::string& path);
+    bool isLoaded() const;
+    bool next(CameraFrame& frame);      // false kada je putanja odigrana do kraja
+    int frameCount() const;
+    unsigned int asteroidSeed() const;
+};
+
+#endif // CAMERA_PATH_H
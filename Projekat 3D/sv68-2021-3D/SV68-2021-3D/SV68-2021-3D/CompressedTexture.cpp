@@ -0,0 +1,415 @@
+#include "CompressedTexture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const uint32_t DDS_MAGIC = 0x20534444;                 // "DDS "
+const uint32_t DDS_HEADER_SIZE = 124;
+const uint32_t DDS_PIXELFORMAT_SIZE = 32;
+const uint32_t DDSD_REQUIRED = 0x1 | 0x2 | 0x4 | 0x1000;     // CAPS | HEIGHT | WIDTH | PIXELFORMAT
+const uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+const uint32_t DDSD_LINEARSIZE = 0x80000;
+const uint32_t DDPF_FOURCC = 0x4;
+const uint32_t DDSCAPS_COMPLEX = 0x8;
+const uint32_t DDSCAPS_TEXTURE = 0x1000;
+const uint32_t DDSCAPS_MIPMAP = 0x400000;
+
+const uint32_t DXGI_FORMAT_BC1_UNORM = 71;
+const uint32_t DXGI_FORMAT_BC3_UNORM = 77;
+const uint32_t DXGI_FORMAT_BC7_UNORM = 98;
+const uint32_t DXGI_FORMAT_BC7_UNORM_SRGB = 99;
+const uint32_t D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3;
+
+uint32_t fourCC(char a, char b, char c, char d) {
+    return (uint32_t)(unsigned char)a | ((uint32_t)(unsigned char)b << 8) |
+        ((uint32_t)(unsigned char)c << 16) | ((uint32_t)(unsigned char)d << 24);
+}
+
+// Polja DDS_HEADER redom, kao 32-bitne reci (little-endian)
+enum DdsHeaderWord {
+    DDS_SIZE = 0, DDS_FLAGS = 1, DDS_HEIGHT = 2, DDS_WIDTH = 3, DDS_LINEAR_SIZE = 4,
+    DDS_MIPMAP_COUNT = 6, DDS_PF_SIZE = 18, DDS_PF_FLAGS = 19, DDS_PF_FOURCC = 20, DDS_CAPS = 26,
+    DDS_HEADER_WORDS = 31
+};
+
+//==================================BC1/BC3 ENKODER==================================
+
+uint16_t packColor565(const float color[3]) {
+    int r = std::min(31, std::max(0, (int)std::lround(color[0] * 31.0f / 255.0f)));
+    int g = std::min(63, std::max(0, (int)std::lround(color[1] * 63.0f / 255.0f)));
+    int b = std::min(31, std::max(0, (int)std::lround(color[2] * 31.0f / 255.0f)));
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void unpackColor565(uint16_t color, int out[3]) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Krajnje boje po glavnoj osi bloka (kovarijansa + par iteracija stepenovanja), pa najbliza od 4 boje palete
+void encodeColorBlock(const unsigned char block[16][4], unsigned char* out) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) mean[c] += block[i][c];
+    }
+    for (int c = 0; c < 3; ++c) mean[c] /= 16.0f;
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };    // rr, rg, rb, gg, gb, bb
+    for (int i = 0; i < 16; ++i) {
+        float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+        if (length < 1e-6f) break;      // Jednobojan blok - osa nije bitna
+        axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+    }
+
+    float minProjection = 1e30f, maxProjection = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        float projection = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float high[3], low[3];
+    for (int c = 0; c < 3; ++c) {
+        high[c] = mean[c] + axis[c] * maxProjection / axisLengthSquared;
+        low[c] = mean[c] + axis[c] * minProjection / axisLengthSquared;
+    }
+
+    uint16_t color0 = packColor565(high);
+    uint16_t color1 = packColor565(low);
+    if (color0 < color1) std::swap(color0, color1);    // color0 > color1 -> rezim sa 4 boje
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        unpackColor565(color0, palette[0]);
+        unpackColor565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+
+    out[0] = (unsigned char)(color0 & 0xFF); out[1] = (unsigned char)(color0 >> 8);
+    out[2] = (unsigned char)(color1 & 0xFF); out[3] = (unsigned char)(color1 >> 8);
+    for (int i = 0; i < 4; ++i) out[4 + i] = (unsigned char)((indices >> (8 * i)) & 0xFF);
+}
+
+// BC3 alfa: min/max bloka i 6 medjuvrednosti, 3 bita po pikselu
+void encodeAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    int alpha0 = 0, alpha1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        alpha0 = std::max(alpha0, (int)block[i][3]);
+        alpha1 = std::min(alpha1, (int)block[i][3]);
+    }
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        int palette[8] = { alpha0, alpha1 };
+        for (int p = 1; p <= 6; ++p) palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = 256;
+            for (int p = 0; p < 8; ++p) {
+                int error = std::abs(block[i][3] - palette[p]);
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+
+    out[0] = (unsigned char)alpha0;
+    out[1] = (unsigned char)alpha1;
+    for (int i = 0; i < 6; ++i) out[2 + i] = (unsigned char)((indices >> (8 * i)) & 0xFF);
+}
+
+// Ivicni blokovi (dimenzija nije deljiva sa 4) ponavljaju poslednji red/kolonu
+void compressLevel(const unsigned char* rgba, int width, int height, unsigned int format, unsigned char* out) {
+    int blockBytes = compressedBlockBytes(format);
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            unsigned char block[16][4];
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(bx + x, width - 1), sy = std::min(by + y, height - 1);
+                    std::memcpy(block[y * 4 + x], rgba + ((size_t)sy * width + sx) * 4, 4);
+                }
+            }
+            if (format == COMPRESSED_RGBA_BC3) {
+                encodeAlphaBlock(block, out);
+                encodeColorBlock(block, out + 8);
+            }
+            else {
+                encodeColorBlock(block, out);
+            }
+            out += blockBytes;
+        }
+    }
+}
+
+// Sledeci mip nivo: prosek 2x2 piksela (neparna ivica se ponavlja)
+std::vector<unsigned char> downsample(const std::vector<unsigned char>& rgba, int width, int height, int nextWidth, int nextHeight) {
+    std::vector<unsigned char> next((size_t)nextWidth * nextHeight * 4);
+    for (int y = 0; y < nextHeight; ++y) {
+        int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+        for (int x = 0; x < nextWidth; ++x) {
+            int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            for (int c = 0; c < 4; ++c) {
+                int sum = rgba[((size_t)y0 * width + x0) * 4 + c] + rgba[((size_t)y0 * width + x1) * 4 + c] +
+                    rgba[((size_t)y1 * width + x0) * 4 + c] + rgba[((size_t)y1 * width + x1) * 4 + c];
+                next[((size_t)y * nextWidth + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return next;
+}
+
+// Cita reci iz bafera i pomera poziciju; false ako bafer nije dovoljno dugacak
+bool readWords(const unsigned char* bytes, size_t size, size_t& position, uint32_t* words, int count) {
+    size_t length = count * sizeof(uint32_t);
+    if (size - position < length) return false;
+    std::memcpy(words, bytes + position, length);
+    position += length;
+    return true;
+}
+
+// Zaglavlje u out (bez podataka); position = pocetak nivoa u fajlu
+bool parseDdsHeader(const unsigned char* bytes, size_t size, const std::string& path, CompressedImage& out, size_t& position) {
+    position = 0;
+    uint32_t magic = 0;
+    uint32_t header[DDS_HEADER_WORDS];
+    if (!readWords(bytes, size, position, &magic, 1) || magic != DDS_MAGIC || !readWords(bytes, size, position, header, DDS_HEADER_WORDS) ||
+        header[DDS_SIZE] != DDS_HEADER_SIZE || header[DDS_PF_SIZE] != DDS_PIXELFORMAT_SIZE || !(header[DDS_PF_FLAGS] & DDPF_FOURCC)) {
+        std::cerr << "loadDds: neispravno zaglavlje: " << path << std::endl;
+        return false;
+    }
+
+    unsigned int format = 0;
+    uint32_t code = header[DDS_PF_FOURCC];
+    if (code == fourCC('D', 'X', 'T', '1')) format = COMPRESSED_RGB_BC1;
+    else if (code == fourCC('D', 'X', 'T', '5')) format = COMPRESSED_RGBA_BC3;
+    else if (code == fourCC('D', 'X', '1', '0')) {
+        uint32_t dx10[5];       // dxgiFormat, resourceDimension, miscFlag, arraySize, miscFlags2
+        if (!readWords(bytes, size, position, dx10, 5) || dx10[1] != D3D10_RESOURCE_DIMENSION_TEXTURE2D || dx10[3] > 1) {
+            std::cerr << "loadDds: podrzane su samo 2D teksture: " << path << std::endl;
+            return false;
+        }
+        if (dx10[0] == DXGI_FORMAT_BC1_UNORM) format = COMPRESSED_RGB_BC1;
+        else if (dx10[0] == DXGI_FORMAT_BC3_UNORM) format = COMPRESSED_RGBA_BC3;
+        else if (dx10[0] == DXGI_FORMAT_BC7_UNORM || dx10[0] == DXGI_FORMAT_BC7_UNORM_SRGB) format = COMPRESSED_RGBA_BC7;
+    }
+    if (format == 0) {
+        std::cerr << "loadDds: nepodrzan format: " << path << std::endl;
+        return false;
+    }
+
+    int width = (int)header[DDS_WIDTH], height = (int)header[DDS_HEIGHT];
+    int levelCount = (header[DDS_FLAGS] & DDSD_MIPMAPCOUNT) ? std::max(1, (int)header[DDS_MIPMAP_COUNT]) : 1;
+    if (width <= 0 || height <= 0 || levelCount > 32) {
+        std::cerr << "loadDds: neispravne dimenzije: " << path << std::endl;
+        return false;
+    }
+
+    out.format = format;
+    out.width = width;
+    out.height = height;
+    out.levels.clear();
+    size_t total = 0;
+    for (int i = 0; i < levelCount; ++i) {
+        CompressedLevel level;
+        level.width = std::max(1, width >> i);
+        level.height = std::max(1, height >> i);
+        level.offset = total;
+        level.size = compressedLevelSize(format, level.width, level.height);
+        total += level.size;
+        out.levels.push_back(level);
+    }
+
+    out.data.clear();
+    if (size - position < total) {
+        std::cerr << "loadDds: fajl je kraci od mip lanca: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
+
+int compressedBlockBytes(unsigned int format) {
+    switch (format) {
+    case COMPRESSED_RGB_BC1: return 8;
+    case COMPRESSED_RGBA_BC3: return 16;
+    case COMPRESSED_RGBA_BC7: return 16;
+    default: return 0;
+    }
+}
+
+size_t compressedLevelSize(unsigned int format, int width, int height) {
+    size_t blocksWide = (size_t)std::max(1, (width + 3) / 4);
+    size_t blocksHigh = (size_t)std::max(1, (height + 3) / 4);
+    return blocksWide * blocksHigh * compressedBlockBytes(format);
+}
+
+int mipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+const char* compressedFormatName(unsigned int format) {
+    switch (format) {
+    case COMPRESSED_RGB_BC1: return "BC1";
+    case COMPRESSED_RGBA_BC3: return "BC3";
+    case COMPRESSED_RGBA_BC7: return "BC7";
+    default: return "?";
+    }
+}
+
+std::string compressedPathFor(const std::string& sourcePath) {
+    size_t dot = sourcePath.find_last_of('.');
+    size_t slash = sourcePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return sourcePath + ".dds";
+    return sourcePath.substr(0, dot) + ".dds";
+}
+
+bool hasTranslucentPixels(const unsigned char* pixels, int width, int height, int channels) {
+    if (channels != 4) return false;
+    size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; ++i) {
+        if (pixels[i * 4 + 3] != 255) return true;
+    }
+    return false;
+}
+
+bool compressImage(const unsigned char* pixels, int width, int height, int channels, unsigned int format,
+    bool mipmaps, CompressedImage& out) {
+    if (format != COMPRESSED_RGB_BC1 && format != COMPRESSED_RGBA_BC3) {
+        std::cerr << "compressImage: nema enkodera za " << compressedFormatName(format) << std::endl;
+        return false;
+    }
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return false;
+
+    // Enkoder radi nad RGBA; siva i siva+alfa se sire na RGB
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    for (size_t i = 0; i < (size_t)width * height; ++i) {
+        const unsigned char* source = pixels + i * channels;
+        unsigned char* target = &rgba[i * 4];
+        if (channels < 3) {
+            target[0] = target[1] = target[2] = source[0];
+            target[3] = (channels == 2) ? source[1] : 255;
+        }
+        else {
+            target[0] = source[0]; target[1] = source[1]; target[2] = source[2];
+            target[3] = (channels == 4) ? source[3] : 255;
+        }
+    }
+
+    out.format = format;
+    out.width = width;
+    out.height = height;
+    out.levels.clear();
+    out.data.clear();
+
+    int levelWidth = width, levelHeight = height;
+    while (true) {
+        CompressedLevel level;
+        level.width = levelWidth;
+        level.height = levelHeight;
+        level.offset = out.data.size();
+        level.size = compressedLevelSize(format, levelWidth, levelHeight);
+        out.data.resize(level.offset + level.size);
+        compressLevel(rgba.data(), levelWidth, levelHeight, format, &out.data[level.offset]);
+        out.levels.push_back(level);
+
+        if (!mipmaps || (levelWidth == 1 && levelHeight == 1)) break;
+        int nextWidth = std::max(1, levelWidth / 2), nextHeight = std::max(1, levelHeight / 2);
+        rgba = downsample(rgba, levelWidth, levelHeight, nextWidth, nextHeight);
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+    return true;
+}
+
+bool loadDds(const std::string& path, CompressedImage& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    std::vector<unsigned char> bytes((size_t)std::max<std::streamoff>(0, file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), (std::streamsize)bytes.size())) return false;
+    return loadDdsFromMemory(bytes.data(), bytes.size(), path, out);
+}
+
+bool readDdsHeader(const unsigned char* bytes, size_t size, const std::string& path, CompressedImage& out) {
+    size_t position = 0;
+    return parseDdsHeader(bytes, size, path, out, position);
+}
+
+bool loadDdsFromMemory(const unsigned char* bytes, size_t size, const std::string& path, CompressedImage& out) {
+    size_t position = 0;
+    if (!parseDdsHeader(bytes, size, path, out, position)) return false;
+    const CompressedLevel& last = out.levels.back();
+    out.data.assign(bytes + position, bytes + position + last.offset + last.size);
+    return true;
+}
+
+bool writeDds(const std::string& path, const CompressedImage& image) {
+    if (image.levels.empty() || compressedBlockBytes(image.format) == 0) return false;
+
+    uint32_t header[DDS_HEADER_WORDS] = {};
+    bool mipmapped = image.levels.size() > 1;
+    header[DDS_SIZE] = DDS_HEADER_SIZE;
+    header[DDS_FLAGS] = DDSD_REQUIRED | DDSD_LINEARSIZE | (mipmapped ? DDSD_MIPMAPCOUNT : 0);
+    header[DDS_HEIGHT] = (uint32_t)image.height;
+    header[DDS_WIDTH] = (uint32_t)image.width;
+    header[DDS_LINEAR_SIZE] = (uint32_t)image.levels[0].size;
+    header[DDS_MIPMAP_COUNT] = (uint32_t)image.levels.size();
+    header[DDS_PF_SIZE] = DDS_PIXELFORMAT_SIZE;
+    header[DDS_PF_FLAGS] = DDPF_FOURCC;
+    header[DDS_CAPS] = DDSCAPS_TEXTURE | (mipmapped ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+    uint32_t dx10[5] = { DXGI_FORMAT_BC7_UNORM, D3D10_RESOURCE_DIMENSION_TEXTURE2D, 0, 1, 0 };
+    bool writeDx10 = false;
+    if (image.format == COMPRESSED_RGB_BC1) header[DDS_PF_FOURCC] = fourCC('D', 'X', 'T', '1');
+    else if (image.format == COMPRESSED_RGBA_BC3) header[DDS_PF_FOURCC] = fourCC('D', 'X', 'T', '5');
+    else {
+        header[DDS_PF_FOURCC] = fourCC('D', 'X', '1', '0');
+        writeDx10 = true;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&DDS_MAGIC), sizeof(DDS_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    if (writeDx10) file.write(reinterpret_cast<const char*>(dx10), sizeof(dx10));
+    file.write(reinterpret_cast<const char*>(image.data.data()), (std::streamsize)image.data.size());
+    return (bool)file;
+}
@@ -0,0 +1,57 @@
+#ifndef COMPRESSED_TEXTURE_H
+#define COMPRESSED_TEXTURE_H
+
+#include <string>
+#include <vector>
+
+// Blok-kompresovane teksture (BC1/BC3/BC7) u DDS fajlu, sa unapred izracunatim mip lancem.
+// DDS pored izvorne slike ima isto ime sa ekstenzijom .dds (earth-tex.jpg -> earth-tex.dds);
+// pravi ih SV68-2021-TexConvert, a ucitavanje se vraca na JPEG/PNG ako .dds ne postoji.
+//
+//   CompressedImage image;
+//   if (loadDds(compressedPathFor("earth-tex.jpg"), image)) ... glCompressedTexImage2D po nivou
+//
+// Podaci su vec okrenuti onako kako ih ocekuje crtanje (tj. kao posle stbi_set_flip_vertically_on_load),
+// pa se pri ucitavanju nista ne preracunava. Ne zavisi od GL zaglavlja: format je GL enum kao broj.
+
+// GL_EXT_texture_compression_s3tc / GL_ARB_texture_compression_bptc (nisu u GL 3.3 core glad-u)
+const unsigned int COMPRESSED_RGB_BC1 = 0x83F0;     // GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8 B po bloku 4x4
+const unsigned int COMPRESSED_RGBA_BC3 = 0x83F3;    // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16 B po bloku
+const unsigned int COMPRESSED_RGBA_BC7 = 0x8E8C;    // GL_COMPRESSED_RGBA_BPTC_UNORM, 16 B po bloku
+
+struct CompressedLevel {
+    int width, height;
+    size_t offset;              // Pocetak nivoa u CompressedImage::data
+    size_t size;
+};
+
+struct CompressedImage {
+    unsigned int format = 0;    // Jedan od COMPRESSED_* (GL internal format)
+    int width = 0, height = 0;
+    std::vector<CompressedLevel> levels;    // levels[0] je puna velicina
+    std::vector<unsigned char> data;        // Svi nivoi redom, bez razmaka
+};
+
+int compressedBlockBytes(unsigned int format);     // 0 za nepoznat format
+size_t compressedLevelSize(unsigned int format, int width, int height);
+int mipLevelCount(int width, int height);           // Ceo lanac do 1x1
+const char* compressedFormatName(unsigned int format);
+
+// "earth-tex.jpg" -> "earth-tex.dds"
+std::string compressedPathFor(const std::string& sourcePath);
+
+// RGB(A) 8-bitni pikseli, redovi bez poravnanja. BC1 ignorise alfu, BC3 je cuva;
+// BC7 enkoder ne postoji (takvi DDS-ovi se prave spoljnim alatom, npr. texconv).
+bool compressImage(const unsigned char* pixels, int width, int height, int channels, unsigned int format,
+    bool mipmaps, CompressedImage& out);
+
+bool hasTranslucentPixels(const unsigned char* pixels, int width, int height, int channels);
+
+// DDS sa FourCC DXT1/DXT5 ili DX10 zaglavljem (BC1/BC3/BC7 UNORM); samo 2D, bez nizova
+bool loadDds(const std::string& path, CompressedImage& out);
+bool loadDdsFromMemory(const unsigned char* bytes, size_t size, const std::string& name, CompressedImage& out);   // name samo za poruke
+// Samo zaglavlje: format, velicina i nivoi bez kopiranja podataka (out.data ostaje prazan)
+bool readDdsHeader(const unsigned char* bytes, size_t size, const std::string& name, CompressedImage& out);
+bool writeDds(const std::string& path, const CompressedImage& image);
+
+#endif // COMPRESSED_TEXTURE_H
@@ -0,0 +1,20 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// Sest ravni zarubljene piramide iz projection * view (Gribb-Hartmann), bez OpenGL poziva.
+// Sa projection * view * model ravni su u prostoru modela, pa se granice testiraju bez transformacije
+// (model sme da ima samo rotaciju, pomeraj i ravnomernu skalu)
+class Frustum {
+public:
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    // Sfera bar delom unutra; konzervativno (sfera blizu ugla moze da prodje)
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+
+private:
+    glm::vec4 planes[6];    // Unutra je dot(xyz, p) + w >= 0; ravni nisu normalizovane
+};
+
+#endif // FRUSTUM_H
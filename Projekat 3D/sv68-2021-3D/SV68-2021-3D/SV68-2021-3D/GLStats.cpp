@@ -0,0 +1,626 @@
+#include "GLStats.h"
+
+#include <iomanip>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const int MAX_TEXTURE_UNITS = 32;
+const int TRACKED_TEXTURE_TARGETS = 3;      // GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY
+
+// Stanje koje je aplikacija postavila kroz omotace (bez glGet* upita drajveru)
+struct TrackedState {
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint activeUnit = 0;
+    GLuint textures[MAX_TEXTURE_UNITS][TRACKED_TEXTURE_TARGETS] = {};
+    std::map<GLenum, GLuint> buffers;
+    std::map<GLenum, bool> capabilities;
+};
+
+// Sva polja GLCounters, za operacije koje vaze za svako polje isto
+long long GLCounters::* const COUNTER_FIELDS[] = {
+    &GLCounters::calls, &GLCounters::drawCalls, &GLCounters::trianglesSubmitted,
+    &GLCounters::programBinds, &GLCounters::redundantProgramBinds,
+    &GLCounters::textureBinds, &GLCounters::redundantTextureBinds,
+    &GLCounters::vertexArrayBinds, &GLCounters::redundantVertexArrayBinds,
+    &GLCounters::bufferBinds, &GLCounters::redundantBufferBinds,
+    &GLCounters::capabilityChanges, &GLCounters::redundantCapabilityChanges,
+    &GLCounters::uniformSets, &GLCounters::uniformLookups,
+    &GLCounters::objectsCreated, &GLCounters::objectsDeleted,
+    &GLCounters::textureUploadBytes,
+};
+
+bool installed = false;
+GLCounters counters;
+TrackedState state;
+
+GLCounters frameStart;
+GLCounters lastCounters;
+GLCounters peakCounters;
+GLCounters sumCounters;
+int frames = 0;
+
+// Velicine zivih objekata; kljuc slike teksture je face * 32 + level
+std::unordered_map<GLuint, long long> bufferSizes;
+std::unordered_map<GLuint, std::map<int, long long>> textureImages;
+long long liveBufferBytes = 0;
+long long liveTextureBytes = 0;
+
+int textureTargetIndex(GLenum target) {
+    switch (target) {
+    case GL_TEXTURE_2D: return 0;
+    case GL_TEXTURE_CUBE_MAP: return 1;
+    case GL_TEXTURE_2D_ARRAY: return 2;
+    default: return -1;
+    }
+}
+
+// Ime teksture vezane na aktivnoj jedinici; stranice cube mape se vode pod GL_TEXTURE_CUBE_MAP
+GLuint boundTexture(GLenum target) {
+    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) target = GL_TEXTURE_CUBE_MAP;
+    int targetIndex = textureTargetIndex(target);
+    if (targetIndex < 0 || state.activeUnit >= (GLuint)MAX_TEXTURE_UNITS) return 0;
+    return state.textures[state.activeUnit][targetIndex];
+}
+
+GLuint boundBuffer(GLenum target) {
+    auto it = state.buffers.find(target);
+    return it != state.buffers.end() ? it->second : 0;
+}
+
+// Procena koliko drajver zauzima po pikselu (RGB se u praksi cuva kao RGBX)
+long long bytesPerPixel(GLint internalFormat) {
+    switch (internalFormat) {
+    case GL_RED: case GL_R8: return 1;
+    case GL_RG: case GL_RG8: return 2;
+    case GL_RGBA16F: return 8;
+    case GL_RGBA32F: return 16;
+    default: return 4;
+    }
+}
+
+// Bajtova po pikselu u klijentskoj memoriji za upload (format/type iz glTex*Image*)
+long long uploadBytesPerPixel(GLenum format, GLenum type) {
+    long long channels;
+    switch (format) {
+    case GL_RED: channels = 1; break;
+    case GL_RG: channels = 2; break;
+    case GL_RGB: case GL_BGR: channels = 3; break;
+    default: channels = 4; break;
+    }
+    switch (type) {
+    case GL_HALF_FLOAT: return channels * 2;
+    case GL_FLOAT: return channels * 4;
+    default: return channels;
+    }
+}
+
+// Kljuc slike: stranica cube mape * 32 + nivo
+int textureImageKey(GLenum target, GLint level) {
+    int face = (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) ? (int)(target - GL_TEXTURE_CUBE_MAP_POSITIVE_X) : 0;
+    return face * 32 + level;
+}
+
+void setTextureImage(GLuint texture, int key, long long bytes) {
+    long long& stored = textureImages[texture][key];
+    liveTextureBytes += bytes - stored;
+    stored = bytes;
+}
+
+// Obrisano ime moze ponovo da se dobije iz glGen*, pa se izbacuje iz pracenog stanja
+void forgetTexture(GLuint name) {
+    for (auto& unit : state.textures) {
+        for (GLuint& bound : unit) {
+            if (bound == name) bound = 0;
+        }
+    }
+
+    auto images = textureImages.find(name);
+    if (images != textureImages.end()) {
+        for (const auto& image : images->second) liveTextureBytes -= image.second;
+        textureImages.erase(images);
+    }
+}
+
+void forgetBuffer(GLuint name) {
+    for (auto& binding : state.buffers) {
+        if (binding.second == name) binding.second = 0;
+    }
+
+    auto size = bufferSizes.find(name);
+    if (size != bufferSizes.end()) {
+        liveBufferBytes -= size->second;
+        bufferSizes.erase(size);
+    }
+}
+
+void forgetVertexArray(GLuint name) {
+    if (state.vertexArray == name) {
+        state.vertexArray = 0;
+        state.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+    }
+}
+
+void forgetProgram(GLuint name) {
+    if (state.program == name) state.program = 0;
+}
+
+void forgetNothing(GLuint) {
+}
+
+// Pravi glad pokazivac + omotac koji samo uvecava brojac
+#define GL_STATS_COUNTED(fn, counter, params, args) \
+    decltype(glad_##fn) real_##fn = nullptr; \
+    void APIENTRY counted_##fn params { counters.calls++; counters.counter++; real_##fn args; }
+
+#define GL_STATS_GEN(fn) \
+    decltype(glad_##fn) real_##fn = nullptr; \
+    void APIENTRY counted_##fn(GLsizei n, GLuint* names) { counters.calls++; counters.objectsCreated += n; real_##fn(n, names); }
+
+#define GL_STATS_DELETE(fn, forget) \
+    decltype(glad_##fn) real_##fn = nullptr; \
+    void APIENTRY counted_##fn(GLsizei n, const GLuint* names) { \
+        counters.calls++; \
+        counters.objectsDeleted += n; \
+        for (GLsizei i = 0; i < n; ++i) forget(names[i]); \
+        real_##fn(n, names); \
+    }
+
+void countDraw(GLenum mode, GLsizei count, GLsizei instances) {
+    counters.calls++;
+    counters.drawCalls++;
+
+    long long triangles = 0;
+    if (mode == GL_TRIANGLES) triangles = count / 3;
+    else if ((mode == GL_TRIANGLE_STRIP || mode == GL_TRIANGLE_FAN) && count > 2) triangles = count - 2;
+    counters.trianglesSubmitted += triangles * instances;
+}
+
+// Pozivi crtanja + broj trouglova po primitivi
+#define GL_STATS_DRAW(fn, params, args, countArg, instancesArg) \
+    decltype(glad_##fn) real_##fn = nullptr; \
+    void APIENTRY counted_##fn params { countDraw(mode, countArg, instancesArg); real_##fn args; }
+
+GL_STATS_DRAW(glDrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count), count, 1)
+GL_STATS_DRAW(glDrawElements, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices), count, 1)
+GL_STATS_DRAW(glDrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances), count, instances)
+GL_STATS_DRAW(glDrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances), (mode, count, type, indices, instances), count, instances)
+GL_STATS_DRAW(glDrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex), (mode, count, type, indices, baseVertex), count, 1)
+
+GL_STATS_COUNTED(glUniform1i, uniformSets, (GLint location, GLint v0), (location, v0))
+GL_STATS_COUNTED(glUniform1f, uniformSets, (GLint location, GLfloat v0), (location, v0))
+GL_STATS_COUNTED(glUniform2f, uniformSets, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+GL_STATS_COUNTED(glUniform3f, uniformSets, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2))
+GL_STATS_COUNTED(glUniform4f, uniformSets, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+GL_STATS_COUNTED(glUniform3fv, uniformSets, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_STATS_COUNTED(glUniform4fv, uniformSets, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_STATS_COUNTED(glUniformMatrix3fv, uniformSets, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_STATS_COUNTED(glUniformMatrix4fv, uniformSets, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+
+GL_STATS_GEN(glGenBuffers)
+GL_STATS_GEN(glGenVertexArrays)
+GL_STATS_GEN(glGenTextures)
+GL_STATS_GEN(glGenFramebuffers)
+GL_STATS_GEN(glGenRenderbuffers)
+
+GL_STATS_DELETE(glDeleteBuffers, forgetBuffer)
+GL_STATS_DELETE(glDeleteVertexArrays, forgetVertexArray)
+GL_STATS_DELETE(glDeleteTextures, forgetTexture)
+GL_STATS_DELETE(glDeleteFramebuffers, forgetNothing)
+GL_STATS_DELETE(glDeleteRenderbuffers, forgetNothing)
+
+decltype(glad_glGetUniformLocation) real_glGetUniformLocation = nullptr;
+GLint APIENTRY counted_glGetUniformLocation(GLuint program, const GLchar* name) {
+    counters.calls++;
+    counters.uniformLookups++;
+    return real_glGetUniformLocation(program, name);
+}
+
+decltype(glad_glCreateShader) real_glCreateShader = nullptr;
+GLuint APIENTRY counted_glCreateShader(GLenum type) {
+    counters.calls++;
+    counters.objectsCreated++;
+    return real_glCreateShader(type);
+}
+
+decltype(glad_glCreateProgram) real_glCreateProgram = nullptr;
+GLuint APIENTRY counted_glCreateProgram() {
+    counters.calls++;
+    counters.objectsCreated++;
+    return real_glCreateProgram();
+}
+
+decltype(glad_glDeleteShader) real_glDeleteShader = nullptr;
+void APIENTRY counted_glDeleteShader(GLuint shader) {
+    counters.calls++;
+    counters.objectsDeleted++;
+    real_glDeleteShader(shader);
+}
+
+decltype(glad_glDeleteProgram) real_glDeleteProgram = nullptr;
+void APIENTRY counted_glDeleteProgram(GLuint program) {
+    counters.calls++;
+    counters.objectsDeleted++;
+    forgetProgram(program);
+    real_glDeleteProgram(program);
+}
+
+decltype(glad_glUseProgram) real_glUseProgram = nullptr;
+void APIENTRY counted_glUseProgram(GLuint program) {
+    counters.calls++;
+    counters.programBinds++;
+    if (program == state.program) counters.redundantProgramBinds++;
+    state.program = program;
+    real_glUseProgram(program);
+}
+
+decltype(glad_glActiveTexture) real_glActiveTexture = nullptr;
+void APIENTRY counted_glActiveTexture(GLenum texture) {
+    counters.calls++;
+    state.activeUnit = texture - GL_TEXTURE0;
+    real_glActiveTexture(texture);
+}
+
+decltype(glad_glBindTexture) real_glBindTexture = nullptr;
+void APIENTRY counted_glBindTexture(GLenum target, GLuint texture) {
+    counters.calls++;
+    counters.textureBinds++;
+
+    int targetIndex = textureTargetIndex(target);
+    if (targetIndex >= 0 && state.activeUnit < (GLuint)MAX_TEXTURE_UNITS) {
+        GLuint& bound = state.textures[state.activeUnit][targetIndex];
+        if (bound == texture) counters.redundantTextureBinds++;
+        bound = texture;
+    }
+    real_glBindTexture(target, texture);
+}
+
+decltype(glad_glBindVertexArray) real_glBindVertexArray = nullptr;
+void APIENTRY counted_glBindVertexArray(GLuint array) {
+    counters.calls++;
+    counters.vertexArrayBinds++;
+    if (array == state.vertexArray) {
+        counters.redundantVertexArrayBinds++;
+    }
+    else {
+        state.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);   // EBO je deo VAO stanja
+    }
+    state.vertexArray = array;
+    real_glBindVertexArray(array);
+}
+
+decltype(glad_glBindBuffer) real_glBindBuffer = nullptr;
+void APIENTRY counted_glBindBuffer(GLenum target, GLuint buffer) {
+    counters.calls++;
+    counters.bufferBinds++;
+
+    auto it = state.buffers.find(target);
+    if (it != state.buffers.end() && it->second == buffer) counters.redundantBufferBinds++;
+    state.buffers[target] = buffer;
+    real_glBindBuffer(target, buffer);
+}
+
+decltype(glad_glBufferData) real_glBufferData = nullptr;
+void APIENTRY counted_glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    counters.calls++;
+
+    GLuint buffer = boundBuffer(target);
+    if (buffer != 0) {
+        long long& stored = bufferSizes[buffer];
+        liveBufferBytes += (long long)size - stored;
+        stored = (long long)size;
+    }
+    real_glBufferData(target, size, data, usage);
+}
+
+decltype(glad_glTexImage2D) real_glTexImage2D = nullptr;
+void APIENTRY counted_glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+    GLint border, GLenum format, GLenum type, const void* pixels) {
+    counters.calls++;
+    if (pixels) counters.textureUploadBytes += (long long)width * height * uploadBytesPerPixel(format, type);
+
+    GLuint texture = boundTexture(target);
+    if (texture != 0 && level < 32) {
+        setTextureImage(texture, textureImageKey(target, level), (long long)width * height * bytesPerPixel(internalFormat));
+    }
+    real_glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+}
+
+// Svi slojevi niza se vode kao jedna slika nivoa
+decltype(glad_glTexImage3D) real_glTexImage3D = nullptr;
+void APIENTRY counted_glTexImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth,
+    GLint border, GLenum format, GLenum type, const void* pixels) {
+    counters.calls++;
+    if (pixels) counters.textureUploadBytes += (long long)width * height * depth * uploadBytesPerPixel(format, type);
+
+    GLuint texture = boundTexture(target);
+    if (texture != 0 && level < 32) {
+        setTextureImage(texture, level, (long long)width * height * depth * bytesPerPixel(internalFormat));
+    }
+    real_glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+}
+
+// Blok-kompresovana slika zauzima tacno imageSize bajtova (DDS nivoi iz CompressedTexture)
+decltype(glad_glCompressedTexImage2D) real_glCompressedTexImage2D = nullptr;
+void APIENTRY counted_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+    GLint border, GLsizei imageSize, const void* data) {
+    counters.calls++;
+    if (data) counters.textureUploadBytes += imageSize;
+
+    GLuint texture = boundTexture(target);
+    if (texture != 0 && level < 32) setTextureImage(texture, textureImageKey(target, level), imageSize);
+    real_glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data);
+}
+
+decltype(glad_glCompressedTexImage3D) real_glCompressedTexImage3D = nullptr;
+void APIENTRY counted_glCompressedTexImage3D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+    GLsizei depth, GLint border, GLsizei imageSize, const void* data) {
+    counters.calls++;
+    if (data) counters.textureUploadBytes += imageSize;
+
+    GLuint texture = boundTexture(target);
+    if (texture != 0 && level < 32) setTextureImage(texture, level, imageSize);
+    real_glCompressedTexImage3D(target, level, internalFormat, width, height, depth, border, imageSize, data);
+}
+
+// Pod-slike ne menjaju zauzece, samo se broje poslati bajtovi (slojevi nizova, celije atlasa, PBO stranice)
+decltype(glad_glTexSubImage2D) real_glTexSubImage2D = nullptr;
+void APIENTRY counted_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, const void* pixels) {
+    counters.calls++;
+    counters.textureUploadBytes += (long long)width * height * uploadBytesPerPixel(format, type);
+    real_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+decltype(glad_glTexSubImage3D) real_glTexSubImage3D = nullptr;
+void APIENTRY counted_glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+    GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+    counters.calls++;
+    counters.textureUploadBytes += (long long)width * height * depth * uploadBytesPerPixel(format, type);
+    real_glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+}
+
+decltype(glad_glCompressedTexSubImage2D) real_glCompressedTexSubImage2D = nullptr;
+void APIENTRY counted_glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+    GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data) {
+    counters.calls++;
+    counters.textureUploadBytes += imageSize;
+    real_glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+}
+
+decltype(glad_glCompressedTexSubImage3D) real_glCompressedTexSubImage3D = nullptr;
+void APIENTRY counted_glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+    GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data) {
+    counters.calls++;
+    counters.textureUploadBytes += imageSize;
+    real_glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+}
+
+// Ceo mip lanac je ~1/3 nivoa 0; vodi se pod kljucem nivoa 1 svake stranice
+decltype(glad_glGenerateMipmap) real_glGenerateMipmap = nullptr;
+void APIENTRY counted_glGenerateMipmap(GLenum target) {
+    counters.calls++;
+
+    GLuint texture = boundTexture(target);
+    auto images = textureImages.find(texture);
+    if (texture != 0 && images != textureImages.end()) {
+        std::vector<std::pair<int, long long>> baseLevels;
+        for (const auto& image : images->second) {
+            if (image.first % 32 == 0) baseLevels.push_back(image);
+        }
+        for (const auto& base : baseLevels) setTextureImage(texture, base.first + 1, base.second / 3);
+    }
+    real_glGenerateMipmap(target);
+}
+
+void countCapability(GLenum cap, bool enable) {
+    counters.calls++;
+    counters.capabilityChanges++;
+
+    auto it = state.capabilities.find(cap);
+    if (it != state.capabilities.end() && it->second == enable) counters.redundantCapabilityChanges++;
+    state.capabilities[cap] = enable;
+}
+
+decltype(glad_glEnable) real_glEnable = nullptr;
+void APIENTRY counted_glEnable(GLenum cap) {
+    countCapability(cap, true);
+    real_glEnable(cap);
+}
+
+decltype(glad_glDisable) real_glDisable = nullptr;
+void APIENTRY counted_glDisable(GLenum cap) {
+    countCapability(cap, false);
+    real_glDisable(cap);
+}
+
+#define GL_STATS_HOOK(fn) \
+    if (glad_##fn) { real_##fn = glad_##fn; glad_##fn = counted_##fn; }
+
+void printRow(std::ostream& out, const char* label, long long GLCounters::* field, const GLCounters& average) {
+    out << std::left << std::setw(28) << label << std::right
+        << std::setw(10) << lastCounters.*field
+        << std::setw(10) << average.*field
+        << std::setw(10) << peakCounters.*field << std::endl;
+}
+
+} // namespace
+
+long long GLCounters::redundantStateSets() const {
+    return redundantProgramBinds + redundantTextureBinds + redundantVertexArrayBinds
+        + redundantBufferBinds + redundantCapabilityChanges;
+}
+
+GLCounters& GLCounters::operator+=(const GLCounters& other) {
+    for (long long GLCounters::* field : COUNTER_FIELDS) {
+        this->*field += other.*field;
+    }
+    return *this;
+}
+
+GLCounters GLCounters::operator-(const GLCounters& other) const {
+    GLCounters result;
+    for (long long GLCounters::* field : COUNTER_FIELDS) {
+        result.*field = this->*field - other.*field;
+    }
+    return result;
+}
+
+void GLCounters::keepMax(const GLCounters& other) {
+    for (long long GLCounters::* field : COUNTER_FIELDS) {
+        if (other.*field > this->*field) this->*field = other.*field;
+    }
+}
+
+void GLCounters::divide(long long count) {
+    if (count <= 0) return;
+
+    for (long long GLCounters::* field : COUNTER_FIELDS) {
+        this->*field = (this->*field + count / 2) / count;
+    }
+}
+
+void GLStats::install() {
+    if (installed) return;
+
+    GL_STATS_HOOK(glDrawArrays);
+    GL_STATS_HOOK(glDrawElements);
+    GL_STATS_HOOK(glDrawArraysInstanced);
+    GL_STATS_HOOK(glDrawElementsInstanced);
+    GL_STATS_HOOK(glDrawElementsBaseVertex);
+
+    GL_STATS_HOOK(glUniform1i);
+    GL_STATS_HOOK(glUniform1f);
+    GL_STATS_HOOK(glUniform2f);
+    GL_STATS_HOOK(glUniform3f);
+    GL_STATS_HOOK(glUniform4f);
+    GL_STATS_HOOK(glUniform3fv);
+    GL_STATS_HOOK(glUniform4fv);
+    GL_STATS_HOOK(glUniformMatrix3fv);
+    GL_STATS_HOOK(glUniformMatrix4fv);
+    GL_STATS_HOOK(glGetUniformLocation);
+
+    GL_STATS_HOOK(glGenBuffers);
+    GL_STATS_HOOK(glGenVertexArrays);
+    GL_STATS_HOOK(glGenTextures);
+    GL_STATS_HOOK(glGenFramebuffers);
+    GL_STATS_HOOK(glGenRenderbuffers);
+    GL_STATS_HOOK(glCreateShader);
+    GL_STATS_HOOK(glCreateProgram);
+
+    GL_STATS_HOOK(glDeleteBuffers);
+    GL_STATS_HOOK(glDeleteVertexArrays);
+    GL_STATS_HOOK(glDeleteTextures);
+    GL_STATS_HOOK(glDeleteFramebuffers);
+    GL_STATS_HOOK(glDeleteRenderbuffers);
+    GL_STATS_HOOK(glDeleteShader);
+    GL_STATS_HOOK(glDeleteProgram);
+
+    GL_STATS_HOOK(glUseProgram);
+    GL_STATS_HOOK(glActiveTexture);
+    GL_STATS_HOOK(glBindTexture);
+    GL_STATS_HOOK(glBindVertexArray);
+    GL_STATS_HOOK(glBindBuffer);
+    GL_STATS_HOOK(glEnable);
+    GL_STATS_HOOK(glDisable);
+
+    GL_STATS_HOOK(glBufferData);
+    GL_STATS_HOOK(glTexImage2D);
+    GL_STATS_HOOK(glTexImage3D);
+    GL_STATS_HOOK(glCompressedTexImage2D);
+    GL_STATS_HOOK(glCompressedTexImage3D);
+    GL_STATS_HOOK(glTexSubImage2D);
+    GL_STATS_HOOK(glTexSubImage3D);
+    GL_STATS_HOOK(glCompressedTexSubImage2D);
+    GL_STATS_HOOK(glCompressedTexSubImage3D);
+    GL_STATS_HOOK(glGenerateMipmap);
+
+    installed = true;
+}
+
+bool GLStats::isInstalled() {
+    return installed;
+}
+
+const GLCounters& GLStats::total() {
+    return counters;
+}
+
+void GLStats::beginFrame() {
+    frameStart = counters;
+}
+
+void GLStats::endFrame() {
+    lastCounters = counters - frameStart;
+    peakCounters.keepMax(lastCounters);
+    sumCounters += lastCounters;
+    frames++;
+}
+
+void GLStats::resetFrameHistory() {
+    peakCounters = GLCounters();
+    sumCounters = GLCounters();
+    frames = 0;
+}
+
+const GLCounters& GLStats::lastFrame() {
+    return lastCounters;
+}
+
+const GLCounters& GLStats::peakFrame() {
+    return peakCounters;
+}
+
+GLCounters GLStats::averageFrame() {
+    GLCounters average = sumCounters;
+    average.divide(frames);
+    return average;
+}
+
+int GLStats::frameCount() {
+    return frames;
+}
+
+void GLStats::print(std::ostream& out) {
+    if (!installed) {
+        out << "GLStats: nije instaliran (Debug build ili --gl-stats)" << std::endl;
+        return;
+    }
+
+    GLCounters average = averageFrame();
+
+    out << "==================== GL CALLS PER FRAME ====================" << std::endl;
+    out << std::left << std::setw(28) << "counter" << std::right
+        << std::setw(10) << "last" << std::setw(10) << "average" << std::setw(10) << "peak" << std::endl;
+    printRow(out, "calls", &GLCounters::calls, average);
+    printRow(out, "draw calls", &GLCounters::drawCalls, average);
+    printRow(out, "triangles submitted", &GLCounters::trianglesSubmitted, average);
+    printRow(out, "glUseProgram", &GLCounters::programBinds, average);
+    printRow(out, "  redundant", &GLCounters::redundantProgramBinds, average);
+    printRow(out, "glBindTexture", &GLCounters::textureBinds, average);
+    printRow(out, "  redundant", &GLCounters::redundantTextureBinds, average);
+    printRow(out, "glBindVertexArray", &GLCounters::vertexArrayBinds, average);
+    printRow(out, "  redundant", &GLCounters::redundantVertexArrayBinds, average);
+    printRow(out, "glBindBuffer", &GLCounters::bufferBinds, average);
+    printRow(out, "  redundant", &GLCounters::redundantBufferBinds, average);
+    printRow(out, "glEnable / glDisable", &GLCounters::capabilityChanges, average);
+    printRow(out, "  redundant", &GLCounters::redundantCapabilityChanges, average);
+    printRow(out, "glUniform*", &GLCounters::uniformSets, average);
+    printRow(out, "glGetUniformLocation", &GLCounters::uniformLookups, average);
+    printRow(out, "objects created", &GLCounters::objectsCreated, average);
+    printRow(out, "objects deleted", &GLCounters::objectsDeleted, average);
+    printRow(out, "texture upload bytes", &GLCounters::textureUploadBytes, average);
+    out << "frames: " << frames << std::endl;
+    out << "live buffers: " << liveBufferBytes / 1024 << " KB, live textures: " << liveTextureBytes / 1024 << " KB" << std::endl;
+}
+
+long long GLStats::bufferBytes() {
+    return liveBufferBytes;
+}
+
+long long GLStats::textureBytes() {
+    return liveTextureBytes;
+}
@@ -0,0 +1,66 @@
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+#include <glad/glad.h>
+#include <ostream>
+
+// Brojaci presretnutih GL poziva. "Redundant" je bind/enable koji postavlja vrednost
+// koja je vec postavljena - drajver ga i dalje obradjuje, a nista se ne menja.
+struct GLCounters {
+    long long calls = 0;                    // Svi presretnuti pozivi
+    long long drawCalls = 0;
+    long long trianglesSubmitted = 0;       // Ukljucujuci sve instance instanciranih poziva
+    long long programBinds = 0;
+    long long redundantProgramBinds = 0;
+    long long textureBinds = 0;
+    long long redundantTextureBinds = 0;
+    long long vertexArrayBinds = 0;
+    long long redundantVertexArrayBinds = 0;
+    long long bufferBinds = 0;
+    long long redundantBufferBinds = 0;
+    long long capabilityChanges = 0;        // glEnable / glDisable
+    long long redundantCapabilityChanges = 0;
+    long long uniformSets = 0;
+    long long uniformLookups = 0;           // glGetUniformLocation
+    long long objectsCreated = 0;           // glGen* / glCreate*
+    long long objectsDeleted = 0;           // glDelete*
+    long long textureUploadBytes = 0;       // glTex(Sub)Image* i glCompressedTex(Sub)Image*
+
+    long long redundantStateSets() const;
+
+    GLCounters& operator+=(const GLCounters& other);
+    GLCounters operator-(const GLCounters& other) const;
+    void keepMax(const GLCounters& other);  // Maksimum po svakom polju (najgori frejm)
+    void divide(long long count);           // Prosek, zaokruzeno
+};
+
+// Opcioni sloj koji broji GL pozive: install() zamenjuje glad pokazivace funkcija
+// omotacima, pa se ostatak koda ne menja. Bez install() nema nikakvog troska.
+// Stanje (program, VAO, teksture po jedinici, baferi) se prati samo kroz omotace,
+// pa poziv mora biti odmah posle gladLoadGLLoader, pre prvog bind-a.
+class GLStats {
+public:
+    static void install();
+    static bool isInstalled();
+
+    // Ukupno od install(); PassTimer racuna razliku oko svakog prolaza
+    static const GLCounters& total();
+
+    static void beginFrame();
+    static void endFrame();
+    static void resetFrameHistory();        // Npr. posle warmup frejmova u benchmarku
+
+    static const GLCounters& lastFrame();
+    static const GLCounters& peakFrame();
+    static GLCounters averageFrame();
+    static int frameCount();
+
+    static void print(std::ostream& out);
+
+    // Zivi bajtovi iz glBufferData / glTexImage2D/3D / glCompressedTexImage2D/3D (+ mip lanac iz glGenerateMipmap),
+    // umanjeno za glDelete*
+    static long long bufferBytes();
+    static long long textureBytes();
+};
+
+#endif // GL_STATS_H
@@ -0,0 +1,13 @@
+#ifndef GL_HEADERS_H
+#define GL_HEADERS_H
+
+// GL zaglavlja za fajlove koje prevode oba projekta (UiAtlas, UiBatch): 3D ucitava funkcije kroz glad,
+// a 2D kroz GLEW, pa 2D projekat definise SV68_USE_GLEW. Fajlovi samo 3D projekta ukljucuju glad direktno.
+#ifdef SV68_USE_GLEW
+#include <GL/glew.h>
+#else
+#include <glad/glad.h>
+#endif
+#include <GLFW/glfw3.h>
+
+#endif // GL_HEADERS_H
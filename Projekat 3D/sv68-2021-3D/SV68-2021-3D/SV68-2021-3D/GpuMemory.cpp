@@ -0,0 +1,209 @@
+#include "GpuMemory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const int MAX_REPORT_GROUPS = 20;
+
+// Svi objekti istog vlasnika napravljeni na istom mestu
+struct AllocationGroup {
+    GpuResourceKind kind;
+    std::string owner;
+    std::string site;
+    std::string lastLabel;
+    long long liveObjects = 0;
+    long long liveBytes = 0;
+    long long peakBytes = 0;
+    long long created = 0;
+    long long sampledBytes = 0;     // Zivi bajtovi u poslednjem uzorku
+    int growingSamples = 0;         // Uzastopni uzorci u kojima je grupa rasla
+    bool suspectedLeak = false;
+};
+
+struct Allocation {
+    long long bytes;
+    size_t group;
+};
+
+std::vector<AllocationGroup> groups;
+std::unordered_map<std::string, size_t> groupIndex;
+std::unordered_map<uint64_t, Allocation> allocations;
+
+long long liveBytesByKind[GPU_RESOURCE_KINDS] = {};
+long long liveObjectsByKind[GPU_RESOURCE_KINDS] = {};
+long long peakBytesByKind[GPU_RESOURCE_KINDS] = {};
+
+const char* owner = "main";
+int framesSinceSample = 0;
+int leakCount = 0;
+
+const char* KIND_NAMES[GPU_RESOURCE_KINDS] = { "texture", "buffer" };
+
+uint64_t allocationKey(GpuResourceKind kind, unsigned int name) {
+    return ((uint64_t)kind << 32) | name;
+}
+
+// __FILE__ je u MSVC-u puna putanja; u izvestaju je dovoljno ime fajla i linija
+std::string shortSite(const char* site) {
+    std::string text = site ? site : "?";
+    size_t slash = text.find_last_of("/\\");
+    return slash == std::string::npos ? text : text.substr(slash + 1);
+}
+
+size_t findGroup(GpuResourceKind kind, const std::string& site) {
+    std::string key = std::to_string((int)kind) + "|" + owner + "|" + site;
+    auto it = groupIndex.find(key);
+    if (it != groupIndex.end()) return it->second;
+
+    AllocationGroup group;
+    group.kind = kind;
+    group.owner = owner;
+    group.site = site;
+    groups.push_back(group);
+    groupIndex[key] = groups.size() - 1;
+    return groups.size() - 1;
+}
+
+void addBytes(GpuResourceKind kind, AllocationGroup& group, long long bytes) {
+    group.liveBytes += bytes;
+    group.peakBytes = std::max(group.peakBytes, group.liveBytes);
+    liveBytesByKind[kind] += bytes;
+    peakBytesByKind[kind] = std::max(peakBytesByKind[kind], liveBytesByKind[kind]);
+}
+
+std::string formatKB(long long bytes) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+    return text;
+}
+
+}
+
+void GpuMemory::track(GpuResourceKind kind, unsigned int name, long long bytes, const char* label, const char* site) {
+    if (name == 0) return;
+
+    auto existing = allocations.find(allocationKey(kind, name));
+    if (existing != allocations.end()) {
+        AllocationGroup& group = groups[existing->second.group];
+        addBytes(kind, group, bytes - existing->second.bytes);
+        existing->second.bytes = bytes;
+        return;
+    }
+
+    size_t index = findGroup(kind, shortSite(site));
+    AllocationGroup& group = groups[index];
+    group.liveObjects++;
+    group.created++;
+    if (label) group.lastLabel = label;
+    addBytes(kind, group, bytes);
+    liveObjectsByKind[kind]++;
+
+    allocations[allocationKey(kind, name)] = Allocation{ bytes, index };
+}
+
+void GpuMemory::release(GpuResourceKind kind, unsigned int name) {
+    auto it = allocations.find(allocationKey(kind, name));
+    if (it == allocations.end()) return;
+
+    AllocationGroup& group = groups[it->second.group];
+    group.liveObjects--;
+    group.liveBytes -= it->second.bytes;
+    liveBytesByKind[kind] -= it->second.bytes;
+    liveObjectsByKind[kind]--;
+    allocations.erase(it);
+}
+
+long long GpuMemory::liveBytes(GpuResourceKind kind) {
+    return liveBytesByKind[kind];
+}
+
+long long GpuMemory::liveObjects(GpuResourceKind kind) {
+    return liveObjectsByKind[kind];
+}
+
+long long GpuMemory::peakBytes(GpuResourceKind kind) {
+    return peakBytesByKind[kind];
+}
+
+long long GpuMemory::objectBytes(GpuResourceKind kind, unsigned int name) {
+    auto it = allocations.find(allocationKey(kind, name));
+    return it == allocations.end() ? 0 : it->second.bytes;
+}
+
+long long GpuMemory::imageBytes(int width, int height, int channels, bool mipmapped) {
+    long long bytes = (long long)width * height * channels;
+    return mipmapped ? bytes + bytes / 3 : bytes;
+}
+
+void GpuMemory::endFrame() {
+    if (++framesSinceSample < SAMPLE_FRAMES) return;
+    framesSinceSample = 0;
+
+    for (AllocationGroup& group : groups) {
+        group.growingSamples = group.liveBytes > group.sampledBytes ? group.growingSamples + 1 : 0;
+        group.sampledBytes = group.liveBytes;
+
+        if (group.growingSamples >= LEAK_SAMPLES && !group.suspectedLeak) {
+            group.suspectedLeak = true;
+            leakCount++;
+            std::cerr << "GpuMemory: " << KIND_NAMES[group.kind] << " grupa " << group.owner << " @ " << group.site
+                << " raste " << LEAK_SAMPLES * SAMPLE_FRAMES << " frejmova zaredom (" << group.liveObjects << " objekata, "
+                << formatKB(group.liveBytes) << ", poslednji: " << group.lastLabel << ") - moguce curenje" << std::endl;
+        }
+    }
+}
+
+int GpuMemory::suspectedLeakCount() {
+    return leakCount;
+}
+
+void GpuMemory::printReport(std::ostream& out) {
+    out << "==================== GPU MEMORY ====================" << std::endl;
+    for (int kind = 0; kind < GPU_RESOURCE_KINDS; ++kind) {
+        out << std::left << std::setw(10) << KIND_NAMES[kind] << std::right
+            << std::setw(8) << liveObjectsByKind[kind] << " objekata"
+            << std::setw(14) << formatKB(liveBytesByKind[kind])
+            << "   peak " << formatKB(peakBytesByKind[kind]) << std::endl;
+    }
+
+    std::vector<const AllocationGroup*> sorted;
+    for (const AllocationGroup& group : groups) sorted.push_back(&group);
+    std::sort(sorted.begin(), sorted.end(), [](const AllocationGroup* a, const AllocationGroup* b) {
+        return a->liveBytes > b->liveBytes;
+    });
+
+    out << std::left << std::setw(8) << "kind" << std::setw(20) << "owner" << std::setw(28) << "site" << std::right
+        << std::setw(8) << "live" << std::setw(10) << "created" << std::setw(14) << "bytes" << std::setw(14) << "peak" << std::endl;
+    int shown = 0;
+    for (const AllocationGroup* group : sorted) {
+        if (shown++ >= MAX_REPORT_GROUPS) {
+            out << "... jos " << sorted.size() - MAX_REPORT_GROUPS << " grupa" << std::endl;
+            break;
+        }
+        out << std::left << std::setw(8) << KIND_NAMES[group->kind] << std::setw(20) << group->owner << std::setw(28) << group->site
+            << std::right << std::setw(8) << group->liveObjects << std::setw(10) << group->created
+            << std::setw(14) << formatKB(group->liveBytes) << std::setw(14) << formatKB(group->peakBytes)
+            << (group->suspectedLeak ? "   LEAK?" : "") << std::endl;
+    }
+
+    if (leakCount > 0) {
+        out << "sumnjiva curenja: " << leakCount << " (grupa raste " << LEAK_SAMPLES << " uzoraka po "
+            << SAMPLE_FRAMES << " frejmova zaredom)" << std::endl;
+    }
+}
+
+const char* GpuMemory::currentOwner() {
+    return owner;
+}
+
+void GpuMemory::setCurrentOwner(const char* newOwner) {
+    owner = newOwner;
+}
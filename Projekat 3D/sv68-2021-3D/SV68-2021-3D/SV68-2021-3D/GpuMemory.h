@@ -0,0 +1,72 @@
+#ifndef GPU_MEMORY_H
+#define GPU_MEMORY_H
+
+#include <ostream>
+
+enum GpuResourceKind {
+    GPU_TEXTURE = 0,
+    GPU_BUFFER = 1,
+    GPU_RESOURCE_KINDS = 2
+};
+
+// Evidencija GPU memorije koju program sam alocira (teksture i baferi).
+// Svaki objekat se upisuje pri kreiranju sa velicinom, vlasnikom i mestom kreiranja:
+//
+//   GPU_MEMORY_OWNER("renderInfoBox");     // vlasnik za sve alokacije do kraja bloka
+//   GpuMemory::track(GPU_TEXTURE, id, GpuMemory::imageBytes(w, h, 4, true), filePath, GPU_MEMORY_SITE);
+//   GpuMemory::release(GPU_TEXTURE, id);   // uz glDeleteTextures
+//
+// Objekti se grupisu po (vrsta, vlasnik, mesto). endFrame() svakih SAMPLE_FRAMES frejmova uzima
+// uzorak zivih bajtova po grupi; grupa koja raste LEAK_SAMPLES uzoraka zaredom se oznacava kao
+// sumnjivo curenje i jednom se prijavljuje na std::cerr. Ne zavisi od GL zaglavlja (imena su unsigned int);
+// poziva se samo iz GL niti.
+class GpuMemory {
+public:
+    static const int SAMPLE_FRAMES = 60;
+    static const int LEAK_SAMPLES = 5;
+
+    // Ponovni track istog imena samo menja velicinu (npr. glBufferData nad postojecim baferom)
+    static void track(GpuResourceKind kind, unsigned int name, long long bytes, const char* label, const char* site);
+    static void release(GpuResourceKind kind, unsigned int name);
+
+    static long long liveBytes(GpuResourceKind kind);
+    static long long liveObjects(GpuResourceKind kind);
+    static long long peakBytes(GpuResourceKind kind);
+    static long long objectBytes(GpuResourceKind kind, unsigned int name);    // 0 ako objekat nije upisan
+
+    // Bajtovi slike sa channels bajtova po pikselu; mip lanac dodaje jos 1/3 nivoa 0
+    static long long imageBytes(int width, int height, int channels, bool mipmapped);
+
+    static void endFrame();
+    static int suspectedLeakCount();
+
+    // Ukupno po vrsti, grupe sortirane po zivim bajtovima i sumnjiva curenja
+    static void printReport(std::ostream& out);
+
+    static const char* currentOwner();
+    static void setCurrentOwner(const char* owner);
+};
+
+class GpuMemoryOwnerScope {
+private:
+    const char* previous;
+
+public:
+    explicit GpuMemoryOwnerScope(const char* owner) : previous(GpuMemory::currentOwner()) {
+        GpuMemory::setCurrentOwner(owner);
+    }
+    ~GpuMemoryOwnerScope() {
+        GpuMemory::setCurrentOwner(previous);
+    }
+    GpuMemoryOwnerScope(const GpuMemoryOwnerScope&) = delete;
+    GpuMemoryOwnerScope& operator=(const GpuMemoryOwnerScope&) = delete;
+};
+
+#define GPU_MEMORY_STRINGIFY_INNER(x) #x
+#define GPU_MEMORY_STRINGIFY(x) GPU_MEMORY_STRINGIFY_INNER(x)
+#define GPU_MEMORY_CONCAT_INNER(a, b) a##b
+#define GPU_MEMORY_CONCAT(a, b) GPU_MEMORY_CONCAT_INNER(a, b)
+#define GPU_MEMORY_SITE (__FILE__ ":" GPU_MEMORY_STRINGIFY(__LINE__))
+#define GPU_MEMORY_OWNER(owner) GpuMemoryOwnerScope GPU_MEMORY_CONCAT(gpuMemoryOwner_, __LINE__)(owner)
+
+#endif // GPU_MEMORY_H
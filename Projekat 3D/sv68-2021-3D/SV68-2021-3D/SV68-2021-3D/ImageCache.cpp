@@ -0,0 +1,336 @@
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ImageCache.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Zaglavlje, pa levelCount opisa nivoa, pa pikseli svih nivoa od PIXEL_ALIGNMENT
+const char CACHE_MAGIC[8] = { 'S', 'V', '6', '8', 'I', 'M', 'G', '\0' };
+const uint32_t CACHE_VERSION = 1;
+const size_t PIXEL_ALIGNMENT = 16;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t channels;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    uint64_t decodeHash;
+    uint32_t levelCount;
+    uint32_t reserved;
+};
+
+struct FileLevel {
+    uint32_t width, height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+std::string cacheDirectory;
+std::atomic<int> hits(0);
+std::atomic<int> misses(0);
+std::atomic<int> tempCounter(0);
+
+uint64_t mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+uint64_t decodeHashFor(const ImageDecode& decode) {
+    uint64_t hash = CACHE_VERSION;
+    hash = mix(hash, decode.flip ? 1 : 0);
+    hash = mix(hash, (uint64_t)decode.channels);
+    hash = mix(hash, (uint64_t)decode.width);
+    hash = mix(hash, (uint64_t)decode.height);
+    hash = mix(hash, decode.mipmaps ? 1 : 0);
+    return hash;
+}
+
+// "textures/earth-tex.jpg" -> "<folder>/textures_earth-tex.jpg.1a2b3c4d.img"
+std::string entryPathFor(const std::string& name, uint64_t decodeHash) {
+    std::string file = name;
+    for (char& c : file) {
+        if (c == '/' || c == '\\' || c == ':') c = '_';
+    }
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%08x.img", (unsigned)(decodeHash ^ (decodeHash >> 32)));
+    return cacheDirectory + "/" + file + suffix;
+}
+
+void makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+// Sledeci mip nivo kao glGenerateMipmap: max(1, w / 2) x max(1, h / 2), prosek 2x2 (ivica se ponavlja)
+void halveLevel(const unsigned char* pixels, int width, int height, int channels, std::vector<unsigned char>& out,
+    int& outWidth, int& outHeight) {
+    outWidth = std::max(1, width / 2);
+    outHeight = std::max(1, height / 2);
+    out.resize((size_t)outWidth * outHeight * channels);
+    for (int y = 0; y < outHeight; ++y) {
+        int y0 = std::min(y * 2, height - 1);
+        int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            int x0 = std::min(x * 2, width - 1);
+            int x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < channels; ++c) {
+                int sum = pixels[((size_t)y0 * width + x0) * channels + c] + pixels[((size_t)y0 * width + x1) * channels + c] +
+                    pixels[((size_t)y1 * width + x0) * channels + c] + pixels[((size_t)y1 * width + x1) * channels + c];
+                out[((size_t)y * outWidth + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+}
+
+CachedImage::CachedImage()
+    : base(nullptr), length(0), pixelData(nullptr), pixelSize(0), pixelChannels(0)
+#ifdef _WIN32
+    , file(INVALID_HANDLE_VALUE), mapping(nullptr)
+#endif
+{
+}
+
+CachedImage::~CachedImage() {
+    unmap();
+}
+
+CachedImage::CachedImage(CachedImage&& other)
+    : CachedImage() {
+    *this = std::move(other);
+}
+
+CachedImage& CachedImage::operator=(CachedImage&& other) {
+    if (this == &other) return *this;
+    unmap();
+    base = other.base;
+    length = other.length;
+    pixelData = other.pixelData;
+    pixelSize = other.pixelSize;
+    pixelChannels = other.pixelChannels;
+    levels = std::move(other.levels);
+#ifdef _WIN32
+    file = other.file;
+    mapping = other.mapping;
+    other.file = INVALID_HANDLE_VALUE;
+    other.mapping = nullptr;
+#endif
+    other.base = nullptr;
+    other.length = 0;
+    other.pixelData = nullptr;
+    other.pixelSize = 0;
+    other.levels.clear();
+    return *this;
+}
+
+void CachedImage::unmap() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle((HANDLE)mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)file);
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (base) munmap((void*)base, length);
+#endif
+    base = nullptr;
+    length = 0;
+    pixelData = nullptr;
+    pixelSize = 0;
+    levels.clear();
+}
+
+const char* ImageCache::DEFAULT_DIRECTORY = "image-cache";
+
+void ImageCache::setDirectory(const std::string& directory) {
+    cacheDirectory = directory;
+    while (!cacheDirectory.empty() && (cacheDirectory.back() == '/' || cacheDirectory.back() == '\\')) cacheDirectory.pop_back();
+    if (!cacheDirectory.empty()) makeDirectory(cacheDirectory);
+}
+
+const std::string& ImageCache::directory() {
+    return cacheDirectory;
+}
+
+bool ImageCache::isEnabled() {
+    return !cacheDirectory.empty();
+}
+
+uint64_t ImageCache::hashBytes(const unsigned char* data, size_t size) {
+    // FNV-1a po 8 bajtova: brzo kao citanje memorije, dovoljno za otkrivanje promene fajla
+    const uint64_t prime = 0x100000001b3ull;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, data + i * 8, 8);
+        hash = (hash ^ word) * prime;
+    }
+    for (size_t i = words * 8; i < size; ++i) {
+        hash = (hash ^ data[i]) * prime;
+    }
+    return mix(hash, (uint64_t)size);
+}
+
+CachedImage ImageCache::load(const std::string& name, const unsigned char* source, size_t sourceSize, const ImageDecode& decode) {
+    CachedImage image;
+    if (!isEnabled() || !source) return image;
+    TRACE_SCOPE_DETAIL("ImageCache::load", name.c_str());
+
+    uint64_t decodeHash = decodeHashFor(decode);
+    std::string path = entryPathFor(name, decodeHash);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    image.file = file;
+    LARGE_INTEGER fileSize;
+    if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        image.mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (image.mapping) {
+            image.base = (const unsigned char*)MapViewOfFile((HANDLE)image.mapping, FILE_MAP_READ, 0, 0, 0);
+            image.length = (size_t)fileSize.QuadPart;
+        }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            image.base = (const unsigned char*)mapped;
+            image.length = (size_t)info.st_size;
+        }
+    }
+    if (fd >= 0) ::close(fd);       // Mapiranje ostaje vazece i bez deskriptora
+#endif
+
+    // Unos vazi samo za isti izvor i isti nacin dekodiranja; svaki nivo mora stati u fajl
+    FileHeader header;
+    bool valid = image.base && image.length >= sizeof(FileHeader);
+    if (valid) {
+        std::memcpy(&header, image.base, sizeof(header));
+        valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 && header.version == CACHE_VERSION &&
+            header.decodeHash == decodeHash && header.sourceSize == sourceSize && header.levelCount > 0 &&
+            header.channels >= 1 && header.channels <= 4 &&
+            image.length >= sizeof(FileHeader) + (size_t)header.levelCount * sizeof(FileLevel);
+    }
+    if (valid) valid = header.sourceHash == hashBytes(source, sourceSize);
+
+    size_t pixelStart = (sizeof(FileHeader) + (valid ? header.levelCount : 0) * sizeof(FileLevel) + PIXEL_ALIGNMENT - 1) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+    for (uint32_t i = 0; valid && i < header.levelCount; ++i) {
+        FileLevel level;
+        std::memcpy(&level, image.base + sizeof(FileHeader) + i * sizeof(FileLevel), sizeof(level));
+        valid = level.width > 0 && level.height > 0 && level.size == (uint64_t)level.width * level.height * header.channels &&
+            pixelStart <= image.length && level.offset <= image.length - pixelStart && level.size <= image.length - pixelStart - level.offset;
+        image.levels.push_back(CachedLevel{ (int)level.width, (int)level.height, (size_t)level.offset, (size_t)level.size });
+    }
+
+    if (!valid) {
+        image.unmap();
+        misses++;
+        return image;
+    }
+    image.pixelData = image.base + pixelStart;
+    image.pixelSize = image.levels.back().offset + image.levels.back().size;
+    image.pixelChannels = (int)header.channels;
+    hits++;
+    return image;
+}
+
+bool ImageCache::store(const std::string& name, const unsigned char* source, size_t sourceSize, const ImageDecode& decode,
+    const unsigned char* pixels, int width, int height, int channels) {
+    if (!isEnabled() || !source || !pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return false;
+    TRACE_SCOPE_DETAIL("ImageCache::store", name.c_str());
+
+    // Mip lanac se racuna ovde, na niti koja je dekodirala, pa pogodak ne treba glGenerateMipmap
+    std::vector<std::vector<unsigned char>> mips;
+    std::vector<FileLevel> levels;
+    levels.push_back(FileLevel{ (uint32_t)width, (uint32_t)height, 0, (uint64_t)width * height * channels });
+    if (decode.mipmaps) {
+        const unsigned char* current = pixels;
+        int levelWidth = width, levelHeight = height;
+        while (levelWidth > 1 || levelHeight > 1) {
+            mips.emplace_back();
+            halveLevel(current, levelWidth, levelHeight, channels, mips.back(), levelWidth, levelHeight);
+            current = mips.back().data();
+            const FileLevel& previous = levels.back();
+            levels.push_back(FileLevel{ (uint32_t)levelWidth, (uint32_t)levelHeight, previous.offset + previous.size, (uint64_t)mips.back().size() });
+        }
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.channels = (uint32_t)channels;
+    header.sourceHash = hashBytes(source, sourceSize);
+    header.sourceSize = sourceSize;
+    header.decodeHash = decodeHashFor(decode);
+    header.levelCount = (uint32_t)levels.size();
+
+    std::string path = entryPathFor(name, header.decodeHash);
+    std::string tempPath = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000) +
+        "-" + std::to_string(tempCounter++);
+    {
+        std::ofstream out(tempPath, std::ios::binary);
+        if (!out) {
+            std::cerr << "ImageCache: ne mogu da pisem " << tempPath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(levels.data()), (std::streamsize)(levels.size() * sizeof(FileLevel)));
+        size_t written = sizeof(FileHeader) + levels.size() * sizeof(FileLevel);
+        const char padding[PIXEL_ALIGNMENT] = {};
+        out.write(padding, (std::streamsize)((PIXEL_ALIGNMENT - written % PIXEL_ALIGNMENT) % PIXEL_ALIGNMENT));
+        out.write(reinterpret_cast<const char*>(pixels), (std::streamsize)levels[0].size);
+        for (const std::vector<unsigned char>& mip : mips) {
+            out.write(reinterpret_cast<const char*>(mip.data()), (std::streamsize)mip.size());
+        }
+        if (!out) {
+            out.close();
+            std::remove(tempPath.c_str());
+            std::cerr << "ImageCache: ne mogu da pisem " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    // Na Windows-u rename ne prepisuje postojeci fajl; zastareli unos se prvo brise
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+int ImageCache::hitCount() {
+    return hits;
+}
+
+int ImageCache::missCount() {
+    return misses;
+}
@@ -0,0 +1,94 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Kako je slika dekodirana; deo kljuca, pa ista slika ucitana na dva nacina ima dva unosa u kesu
+struct ImageDecode {
+    bool flip = false;          // Kao stbi_set_flip_vertically_on_load
+    int channels = 0;           // stbi desired_channels; 0 = kao u fajlu
+    int width = 0, height = 0;  // Preuzorkovana velicina (resampleImage); 0 = originalna
+    bool mipmaps = false;       // Kes cuva ceo mip lanac (2x2 box filter), ne samo nivo 0
+};
+
+// Jedan mip nivo; offset je u odnosu na pixels()
+struct CachedLevel {
+    int width, height;
+    size_t offset;
+    size_t size;
+};
+
+// Slika iz kesa, mapirana u memoriju: pikseli idu direktno u glTexImage2D (ili u PBO) bez kopije.
+// Vazi dok postoji objekat; empty() ako unosa nema ili ne odgovara izvoru.
+class CachedImage {
+public:
+    CachedImage();
+    ~CachedImage();
+    CachedImage(CachedImage&& other);
+    CachedImage& operator=(CachedImage&& other);
+    CachedImage(const CachedImage&) = delete;
+    CachedImage& operator=(const CachedImage&) = delete;
+
+    bool empty() const { return base == nullptr; }
+    int width() const { return levels.empty() ? 0 : levels[0].width; }
+    int height() const { return levels.empty() ? 0 : levels[0].height; }
+    int channels() const { return pixelChannels; }
+    int levelCount() const { return (int)levels.size(); }
+    const CachedLevel& level(int index) const { return levels[index]; }
+
+    // Svi nivoi redom, bez razmaka: jedno punjenje PBO-a za celu sliku
+    const unsigned char* pixels() const { return pixelData; }
+    size_t pixelBytes() const { return pixelSize; }
+
+private:
+    friend class ImageCache;
+    const unsigned char* base;
+    size_t length;
+    const unsigned char* pixelData;
+    size_t pixelSize;
+    int pixelChannels;
+    std::vector<CachedLevel> levels;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+
+    void unmap();
+};
+
+// Dekodirane slike na disku (image-cache/), da sledece pokretanje preskoci stbi_load:
+//
+//   ImageCache::setDirectory(ImageCache::DEFAULT_DIRECTORY);     // 3D: pored exe fajla, 2D: radni folder
+//   CachedImage cached = ImageCache::load("earth-tex.jpg", file.data(), file.size(), decode);
+//   if (cached.empty()) { pixels = stbi_load_from_memory(...); ImageCache::store(...); }
+//
+// Unos je po imenu i nacinu dekodiranja (earth-tex.jpg.1a2b3c4d.img), a u zaglavlju je hes sadrzaja
+// izvora: kad se slika promeni hes se ne poklapa, load() vraca empty(), a store() prepisuje unos.
+// Hesira se ceo izvor (par ms za JPEG od nekoliko MB, naspram stotina ms dekodiranja).
+// Fajl se pise pod privremenim imenom i preimenuje, pa drugi proces nikad ne vidi pola unosa.
+// Folder se moze obrisati u svakom trenutku. load/store su bezbedni iz vise niti.
+// Ne zavisi od GL zaglavlja ni od stb_image; dekodiranje i slanje na GPU su posao pozivaoca.
+class ImageCache {
+public:
+    static const char* DEFAULT_DIRECTORY;
+
+    // Pre radnih niti; prazan = kes iskljucen (load uvek promasuje, store ne pise)
+    static void setDirectory(const std::string& directory);
+    static const std::string& directory();
+    static bool isEnabled();
+
+    static CachedImage load(const std::string& name, const unsigned char* source, size_t sourceSize, const ImageDecode& decode);
+    // Pikseli posle dekodiranja (i preuzorkovanja); redovi onako kako idu u glTexImage2D
+    static bool store(const std::string& name, const unsigned char* source, size_t sourceSize, const ImageDecode& decode,
+        const unsigned char* pixels, int width, int height, int channels);
+
+    static int hitCount();
+    static int missCount();
+
+    static uint64_t hashBytes(const unsigned char* data, size_t size);
+};
+
+#endif // IMAGE_CACHE_H
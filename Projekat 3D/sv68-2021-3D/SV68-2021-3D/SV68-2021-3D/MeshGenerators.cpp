@@ -0,0 +1,486 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include <utility>
+#include <glm/glm.hpp>
+#include "MeshGenerators.h"
+
+namespace {
+
+// Forsyth: velicina simuliranog kesa i tezine bodovanja iz originalnog teksta
+const int FORSYTH_CACHE_SIZE = 32;
+const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+const int ICOSPHERE_MAX_SUBDIVISIONS = 6;     // 40962 verteksa + sav; 7 ne staje u 16 bita
+
+float forsythVertexScore(int cachePosition, int remainingTriangles) {
+    if (remainingTriangles == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // Verteksi poslednjeg trougla dobijaju fiksno manje, da se ne bi uvek nastavljala ista traka
+        if (cachePosition < 3) score = FORSYTH_LAST_TRIANGLE_SCORE;
+        else score = powf(1.0f - (float)(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3), FORSYTH_CACHE_DECAY_POWER);
+    }
+    // Verteks sa malo preostalih trouglova treba zavrsiti dok je jos u kesu
+    score += FORSYTH_VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -FORSYTH_VALENCE_BOOST_POWER);
+    return score;
+}
+
+template <typename Index>
+float fifoCacheMissRatio(const std::vector<Index>& indices, int cacheSize) {
+    if (indices.size() < 3 || cacheSize <= 0) return 0.0f;
+
+    std::vector<Index> fifo;
+    size_t oldest = 0;
+    int misses = 0;
+    for (Index index : indices) {
+        if (std::find(fifo.begin(), fifo.end(), index) != fifo.end()) continue;
+        misses++;
+        if ((int)fifo.size() < cacheSize) {
+            fifo.push_back(index);
+        }
+        else {
+            fifo[oldest] = index;
+            oldest = (oldest + 1) % cacheSize;
+        }
+    }
+    return (float)misses / (float)(indices.size() / 3);
+}
+
+short packSnorm16(float value) {
+    value = std::max(-1.0f, std::min(1.0f, value));
+    return (short)lroundf(value * 32767.0f);
+}
+
+// Asteroidne varijante: jacina i ucestalost pomeraja, najvece suzenje po osi
+const float ASTEROID_NOISE_AMPLITUDE = 0.35f;
+const float ASTEROID_NOISE_FREQUENCY = 1.8f;
+const float ASTEROID_MAX_SQUASH = 0.35f;
+
+uint32_t hashInts(uint32_t seed, int x, int y, int z) {
+    uint32_t h = seed ^ ((uint32_t)x * 0x8da6b343u) ^ ((uint32_t)y * 0xd8163841u) ^ ((uint32_t)z * 0xcb1ab31fu);
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+float hashUnit(uint32_t seed, int x, int y, int z) {
+    return (hashInts(seed, x, y, z) & 0xffffu) / 65535.0f;
+}
+
+// Trilinearna interpolacija slucajnih vrednosti u cvorovima celobrojne resetke, rezultat u [0, 1]
+float valueNoise(const glm::vec3& p, uint32_t seed) {
+    glm::vec3 cell(floorf(p.x), floorf(p.y), floorf(p.z));
+    glm::vec3 f = p - cell;
+    glm::vec3 w(f.x * f.x * (3.0f - 2.0f * f.x), f.y * f.y * (3.0f - 2.0f * f.y), f.z * f.z * (3.0f - 2.0f * f.z));
+    int x = (int)cell.x, y = (int)cell.y, z = (int)cell.z;
+
+    float corners[2][2][2];
+    for (int dz = 0; dz < 2; ++dz)
+        for (int dy = 0; dy < 2; ++dy)
+            for (int dx = 0; dx < 2; ++dx)
+                corners[dz][dy][dx] = hashUnit(seed, x + dx, y + dy, z + dz);
+
+    float value = 0.0f;
+    for (int dz = 0; dz < 2; ++dz) {
+        for (int dy = 0; dy < 2; ++dy) {
+            float row = corners[dz][dy][0] + (corners[dz][dy][1] - corners[dz][dy][0]) * w.x;
+            value += row * (dy ? w.y : 1.0f - w.y) * (dz ? w.z : 1.0f - w.z);
+        }
+    }
+    return value;
+}
+
+void buildAsteroidVariant(const std::vector<float>& baseVertices, uint32_t seed, short* out) {
+    size_t vertexCount = baseVertices.size() / 5;
+    glm::vec3 axes(1.0f - ASTEROID_MAX_SQUASH * hashUnit(seed, 1, 0, 0),
+        1.0f - ASTEROID_MAX_SQUASH * hashUnit(seed, 0, 1, 0),
+        1.0f - ASTEROID_MAX_SQUASH * hashUnit(seed, 0, 0, 1));
+    glm::vec3 offset(hashUnit(seed, 2, 0, 0) * 64.0f, hashUnit(seed, 0, 2, 0) * 64.0f, hashUnit(seed, 0, 0, 2) * 64.0f);
+
+    std::vector<glm::vec3> displaced(vertexCount);
+    float maxRadius = 0.0f;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        glm::vec3 p(baseVertices[i * 5], baseVertices[i * 5 + 1], baseVertices[i * 5 + 2]);
+
+        float noise = 0.0f, amplitude = 0.5f, frequency = ASTEROID_NOISE_FREQUENCY;
+        for (int octave = 0; octave < 3; ++octave) {
+            glm::vec3 q(p.x * frequency, p.y * frequency, p.z * frequency);
+            noise += amplitude * (valueNoise(q + offset, seed + octave) * 2.0f - 1.0f);
+            amplitude *= 0.5f;
+            frequency *= 2.0f;
+        }
+
+        float radius = 1.0f + ASTEROID_NOISE_AMPLITUDE * noise;
+        displaced[i] = glm::vec3(p.x * axes.x * radius, p.y * axes.y * radius, p.z * axes.z * radius);
+        maxRadius = std::max(maxRadius, glm::length(displaced[i]));
+    }
+
+    // Najdalji verteks na 1: stena staje u jedinicnu sferu (velicina instance, SNORM opseg)
+    float scale = maxRadius > 0.0f ? 1.0f / maxRadius : 1.0f;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        out[i * 4] = packSnorm16(displaced[i].x * scale);
+        out[i * 4 + 1] = packSnorm16(displaced[i].y * scale);
+        out[i * 4 + 2] = packSnorm16(displaced[i].z * scale);
+        out[i * 4 + 3] = 0;
+    }
+}
+
+int icosphereMidpoint(std::map<std::pair<int, int>, int>& midpoints, std::vector<glm::vec3>& positions, int a, int b) {
+    std::pair<int, int> edge(std::min(a, b), std::max(a, b));
+    auto found = midpoints.find(edge);
+    if (found != midpoints.end()) return found->second;
+
+    positions.push_back(glm::normalize(positions[a] + positions[b]));
+    int index = (int)positions.size() - 1;
+    midpoints[edge] = index;
+    return index;
+}
+
+}
+
+void generateSphereVertices(float radius, int sectorCount, int stackCount, SphereUVLayout layout, std::vector<float>& vertices) {
+    float x, y, z, xy;
+    float s, t;
+    float sectorStep = (float)(2 * M_PI / sectorCount);
+    float stackStep = (float)(M_PI / stackCount);
+    float sectorAngle, stackAngle;
+
+    for (int i = 0; i <= stackCount; ++i) {
+        stackAngle = (float)(M_PI / 2 - i * stackStep);
+        xy = radius * cosf(stackAngle);
+        z = radius * sinf(stackAngle);
+
+        for (int j = 0; j <= sectorCount; ++j) {
+            sectorAngle = j * sectorStep;
+
+            // UV koordinate
+            s = (float)j / (float)(sectorCount);
+            if (layout == SPHERE_UV_PLANET) {
+                y = xy * cosf(sectorAngle); // Ranije x, sada y
+                x = xy * sinf(sectorAngle); // Ranije y, sada x
+                t = 1.0f - (float)i / (float)(stackCount);
+            }
+            else {
+                x = xy * cosf(sectorAngle);
+                y = xy * sinf(sectorAngle);
+                t = (float)i / stackCount;
+            }
+
+            if (i == 0) t = 0.01f; // Avoid collapsing at the north pole
+            if (i == stackCount) t = 0.99f; // Avoid collapsing at the south pole
+
+            // Dodavanje verteksa
+            vertices.push_back(x);
+            vertices.push_back(y);
+            vertices.push_back(z);
+            vertices.push_back(s);
+            vertices.push_back(t);
+        }
+    }
+}
+
+void generateSphereIndices(int sectorCount, int stackCount, int vertexCount, std::vector<int>& indices) {
+    int k1, k2;
+    for (int i = 0; i < stackCount; ++i) {
+        k1 = i * (sectorCount + 1);
+        k2 = k1 + sectorCount + 1;
+
+        for (int j = 0; j < sectorCount; ++j, ++k1, ++k2) {
+            if (i != 0) {
+                indices.push_back(k1);
+                indices.push_back(k2);
+                indices.push_back(k1 + 1);
+            }
+            if (i != (stackCount - 1)) {
+                indices.push_back(k1 + 1);
+                indices.push_back(k2);
+                indices.push_back(k2 + 1);
+            }
+        }
+    }
+
+    // Zatvaranje donjeg pola
+    int bottomCenterIndex = vertexCount - 1;
+    int lastRowStart = bottomCenterIndex - sectorCount;
+    for (int j = 0; j < sectorCount; ++j) {
+        int next = (j == sectorCount - 1) ? lastRowStart : lastRowStart + j + 1;
+        indices.push_back(bottomCenterIndex);
+        indices.push_back(lastRowStart + j);
+        indices.push_back(next);
+    }
+}
+
+void generateIcosphere(int subdivisions, std::vector<float>& vertices, std::vector<unsigned short>& indices) {
+    subdivisions = std::max(0, std::min(subdivisions, ICOSPHERE_MAX_SUBDIVISIONS));
+
+    // Ikosaedar; trouglovi su CCW gledano spolja, kao i UV sfera (GL_CULL_FACE)
+    const float phi = (1.0f + sqrtf(5.0f)) * 0.5f;
+    std::vector<glm::vec3> positions = {
+        { -1.0f, phi, 0.0f }, { 1.0f, phi, 0.0f }, { -1.0f, -phi, 0.0f }, { 1.0f, -phi, 0.0f },
+        { 0.0f, -1.0f, phi }, { 0.0f, 1.0f, phi }, { 0.0f, -1.0f, -phi }, { 0.0f, 1.0f, -phi },
+        { phi, 0.0f, -1.0f }, { phi, 0.0f, 1.0f }, { -phi, 0.0f, -1.0f }, { -phi, 0.0f, 1.0f }
+    };
+    for (glm::vec3& position : positions) position = glm::normalize(position);
+
+    std::vector<int> triangles = {
+        0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,   0, 10, 11,
+        1, 5, 9,    5, 11, 4,   11, 10, 2,  10, 7, 6,   7, 1, 8,
+        3, 9, 4,    3, 4, 2,    3, 2, 6,    3, 6, 8,    3, 8, 9,
+        4, 9, 5,    2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1
+    };
+
+    // Svaki trougao na cetiri; verteks na sredini ivice je zajednicki za oba susedna trougla
+    for (int level = 0; level < subdivisions; ++level) {
+        std::map<std::pair<int, int>, int> midpoints;
+        std::vector<int> refined;
+        refined.reserve(triangles.size() * 4);
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            int a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+            int ab = icosphereMidpoint(midpoints, positions, a, b);
+            int bc = icosphereMidpoint(midpoints, positions, b, c);
+            int ca = icosphereMidpoint(midpoints, positions, c, a);
+            int children[12] = { a, ab, ca,   b, bc, ab,   c, ca, bc,   ab, bc, ca };
+            refined.insert(refined.end(), children, children + 12);
+        }
+        triangles.swap(refined);
+    }
+
+    // UV kao SPHERE_UV_STANDARD: s po uglu oko Z ose, t od severnog pola (z = 1)
+    std::vector<glm::vec2> uvs(positions.size());
+    std::vector<bool> pole(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const glm::vec3& p = positions[i];
+        float s = atan2f(p.y, p.x) / (float)(2 * M_PI);
+        uvs[i] = glm::vec2(s < 0.0f ? s + 1.0f : s, acosf(std::max(-1.0f, std::min(1.0f, p.z))) / (float)M_PI);
+        pole[i] = fabsf(p.x) < 1e-6f && fabsf(p.y) < 1e-6f;
+    }
+
+    // Trougao preko sava (s skace sa ~1 na ~0) dobija kopije verteksa sa s - 1 (tekstura je GL_REPEAT, a
+    // s ostaje u [-1, 1] za packSphereVertices), a trougao na polu svoju kopiju pola sa s izmedju druga
+    // dva verteksa; inace bi tekstura bila razvucena
+    std::vector<int> seamCopy(positions.size(), -1);
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        float minS = 1.0f, maxS = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            int v = triangles[i + k];
+            if (pole[v]) continue;
+            minS = std::min(minS, uvs[v].x);
+            maxS = std::max(maxS, uvs[v].x);
+        }
+        if (maxS - minS > 0.5f) {
+            for (int k = 0; k < 3; ++k) {
+                int v = triangles[i + k];
+                if (pole[v] || uvs[v].x < 0.5f) continue;
+                if (seamCopy[v] < 0) {
+                    seamCopy[v] = (int)positions.size();
+                    positions.push_back(positions[v]);
+                    uvs.push_back(glm::vec2(uvs[v].x - 1.0f, uvs[v].y));
+                    pole.push_back(false);
+                }
+                triangles[i + k] = seamCopy[v];
+            }
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            int v = triangles[i + k];
+            if (!pole[v]) continue;
+            float s = (uvs[triangles[i + (k + 1) % 3]].x + uvs[triangles[i + (k + 2) % 3]].x) * 0.5f;
+            triangles[i + k] = (int)positions.size();
+            positions.push_back(positions[v]);
+            uvs.push_back(glm::vec2(s, uvs[v].y));
+            pole.push_back(true);
+        }
+    }
+
+    size_t firstVertex = vertices.size() / 5;
+    vertices.reserve(vertices.size() + positions.size() * 5);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        vertices.push_back(positions[i].x);
+        vertices.push_back(positions[i].y);
+        vertices.push_back(positions[i].z);
+        vertices.push_back(uvs[i].x);
+        vertices.push_back(uvs[i].y);
+    }
+    indices.reserve(indices.size() + triangles.size());
+    for (int index : triangles) indices.push_back((unsigned short)(firstVertex + index));
+}
+
+void optimizeVertexCache(std::vector<unsigned short>& indices, int vertexCount) {
+    int triangleCount = (int)indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Trouglovi po verteksu (CSR); neemitovani su na pocetku liste svakog verteksa
+    std::vector<int> remaining(vertexCount, 0);
+    for (unsigned short index : indices) remaining[index]++;
+    std::vector<int> firstTriangle(vertexCount + 1, 0);
+    for (int v = 0; v < vertexCount; ++v) firstTriangle[v + 1] = firstTriangle[v] + remaining[v];
+    std::vector<int> adjacency(indices.size());
+    std::vector<int> filled(vertexCount, 0);
+    for (int t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            int v = indices[t * 3 + k];
+            adjacency[firstTriangle[v] + filled[v]++] = t;
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) vertexScore[v] = forsythVertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    int best = 0;
+    for (int t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (triangleScore[t] > triangleScore[best]) best = t;
+    }
+
+    std::vector<unsigned short> ordered;
+    ordered.reserve(indices.size());
+    std::vector<int> cache, nextCache;
+    int scanFrom = 0;
+
+    for (int emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (best < 0) {
+            // Nista u kesu nema preostalih trouglova: sledeci neemitovani po redu
+            while (emitted[scanFrom]) scanFrom++;
+            best = scanFrom;
+        }
+
+        emitted[best] = true;
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            int v = indices[best * 3 + k];
+            ordered.push_back((unsigned short)v);
+            nextCache.push_back(v);
+
+            // Izbaci trougao iz liste verteksa
+            int* list = &adjacency[firstTriangle[v]];
+            int* end = list + remaining[v];
+            *std::find(list, end, best) = *(end - 1);
+            remaining[v]--;
+        }
+        for (int v : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+        }
+
+        // Novi polozaji u kesu; ko ispadne vraca se na -1
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            int v = nextCache[i];
+            cachePosition[v] = i < (size_t)FORSYTH_CACHE_SIZE ? (int)i : -1;
+            vertexScore[v] = forsythVertexScore(cachePosition[v], remaining[v]);
+        }
+        if (nextCache.size() > (size_t)FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+        cache.swap(nextCache);
+
+        // Sledeci je najbolji trougao nekog verteksa iz kesa
+        best = -1;
+        float bestScore = -1.0f;
+        for (int v : cache) {
+            for (int i = 0; i < remaining[v]; ++i) {
+                int t = adjacency[firstTriangle[v] + i];
+                triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+    }
+
+    indices.swap(ordered);
+}
+
+void optimizeVertexFetch(std::vector<float>& vertices, int floatsPerVertex, std::vector<unsigned short>& indices) {
+    int vertexCount = (int)vertices.size() / floatsPerVertex;
+    std::vector<int> remap(vertexCount, -1);
+    std::vector<float> ordered;
+    ordered.reserve(vertices.size());
+
+    int next = 0;
+    for (unsigned short& index : indices) {
+        if (remap[index] < 0) {
+            remap[index] = next++;
+            ordered.insert(ordered.end(), vertices.begin() + index * floatsPerVertex, vertices.begin() + (index + 1) * floatsPerVertex);
+        }
+        index = (unsigned short)remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+void packSphereVertices(const std::vector<float>& vertices, std::vector<short>& packed) {
+    packed.clear();
+    packed.reserve(vertices.size() / 5 * PACKED_SPHERE_VERTEX_SHORTS);
+    for (size_t i = 0; i + 5 <= vertices.size(); i += 5) {
+        packed.push_back(packSnorm16(vertices[i]));
+        packed.push_back(packSnorm16(vertices[i + 1]));
+        packed.push_back(packSnorm16(vertices[i + 2]));
+        packed.push_back(0);                                // Poravnanje UV-a na 4 bajta
+        packed.push_back(packSnorm16(vertices[i + 3]));
+        packed.push_back(packSnorm16(vertices[i + 4]));
+    }
+}
+
+void generateAsteroidVariants(const std::vector<float>& baseVertices, int variantCount, unsigned int seed,
+    int workerCount, std::vector<short>& positions) {
+    size_t vertexCount = baseVertices.size() / 5;
+    positions.assign(vertexCount * 4 * std::max(0, variantCount), 0);
+    if (variantCount <= 0 || vertexCount == 0) return;
+
+    if (workerCount <= 0) workerCount = std::max(1, (int)std::thread::hardware_concurrency());
+    workerCount = std::min(workerCount, variantCount);
+
+    // Svaka nit pravi svaku workerCount-tu varijantu u svoj deo izlaza, pa nema deljenog stanja
+    auto work = [&](int first) {
+        for (int v = first; v < variantCount; v += workerCount) {
+            buildAsteroidVariant(baseVertices, hashInts(seed, v, 0, 0), &positions[v * vertexCount * 4]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < workerCount; ++w) workers.emplace_back(work, w);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+}
+
+float vertexCacheMissRatio(const std::vector<int>& indices, int cacheSize) {
+    return fifoCacheMissRatio(indices, cacheSize);
+}
+
+float vertexCacheMissRatio(const std::vector<unsigned short>& indices, int cacheSize) {
+    return fifoCacheMissRatio(indices, cacheSize);
+}
+
+void generateRingVertices(int segments, float innerRadius, float outerRadius, std::vector<float>& vertices) {
+    vertices.clear();
+    for (int i = 0; i <= segments; i++) {
+        float angle = (2.0f * M_PI * i) / segments;
+        float x = cos(angle);
+        float y = sin(angle);
+
+        // Inner ring
+        vertices.push_back(innerRadius * x);
+        vertices.push_back(innerRadius * y);
+        vertices.push_back(0.0f);
+        vertices.push_back((x + 1.0f) * 0.5f);
+        vertices.push_back((y + 1.0f) * 0.5f);
+
+        // Outer ring
+        vertices.push_back(outerRadius * x);
+        vertices.push_back(outerRadius * y);
+        vertices.push_back(0.0f);
+        vertices.push_back((x + 1.0f) * 0.5f);
+        vertices.push_back((y + 1.0f) * 0.5f);
+    }
+}
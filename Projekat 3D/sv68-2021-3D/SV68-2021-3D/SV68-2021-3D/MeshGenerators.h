@@ -0,0 +1,55 @@
+#ifndef MESH_GENERATORS_H
+#define MESH_GENERATORS_H
+
+#include <vector>
+
+// Geometrija bez OpenGL poziva - koriste je klase tela i microbenchmark
+
+// Raspored sfere se razlikuje samo po osama i UV koordinatama
+enum SphereUVLayout {
+    SPHERE_UV_STANDARD,     // Sun, Asteroid: x = cos, y = sin, t raste od severnog pola
+    SPHERE_UV_PLANET        // Planet, Moon: zamenjene x/y ose, t obrnuto (tekstura nije naopako)
+};
+
+// Dodaje (stackCount + 1) * (sectorCount + 1) verteksa, 5 float-ova po verteksu (x, y, z, s, t)
+void generateSphereVertices(float radius, int sectorCount, int stackCount, SphereUVLayout layout, std::vector<float>& vertices);
+
+// vertexCount je broj verteksa iz generateSphereVertices (potreban za zatvaranje donjeg pola)
+void generateSphereIndices(int sectorCount, int stackCount, int vertexCount, std::vector<int>& indices);
+
+// Ikosfera poluprecnika 1 (x, y, z, s, t kao SPHERE_UV_STANDARD): podeljen ikosaedar, trouglovi
+// skoro iste velicine. subdivisions 0..6 (20 * 4^n trouglova), pa indeksi staju u 16 bita.
+// Verteksi na savu teksture (s = 0/1) i na polovima su duplirani. Redosled je onakav kako podela
+// pravi trouglove; za crtanje ide kroz optimizeVertexCache i optimizeVertexFetch
+void generateIcosphere(int subdivisions, std::vector<float>& vertices, std::vector<unsigned short>& indices);
+
+// Redosled trouglova za post-transform kes verteksa (Forsyth, "Linear-Speed Vertex Cache Optimisation"):
+// pohlepno bira trougao ciji su verteksi vec u kesu ili im je ostalo malo trouglova
+void optimizeVertexCache(std::vector<unsigned short>& indices, int vertexCount);
+
+// Verteksi redom prvog koriscenja u indeksima (citanje bafera ide unapred); nekorisceni se izbacuju
+void optimizeVertexFetch(std::vector<float>& vertices, int floatsPerVertex, std::vector<unsigned short>& indices);
+
+// Zbijeni verteks sfere za GPU, 12 bajtova umesto 20: x, y, z, 0, s, t kao GL_SHORT normalizovan na [-1, 1].
+// Normala se ne cuva: na jedinicnoj sferi je jednaka poziciji. Ulaz je 5 float-ova po verteksu
+const int PACKED_SPHERE_VERTEX_SHORTS = 6;
+const int PACKED_SPHERE_VERTEX_BYTES = PACKED_SPHERE_VERTEX_SHORTS * sizeof(short);
+void packSphereVertices(const std::vector<float>& vertices, std::vector<short>& packed);
+
+// Nepravilne stene od iste mreze (asteroidi): poluprecnik svakog verteksa pomeren 3D value noise-om
+// (3 oktave) i izduzen po osama, pa skaliran da najdalji verteks bude na 1. Pomeraj zavisi samo od
+// pozicije, pa duplirani verteksi sava i polova ostaju spojeni. Varijanta v koristi seed izveden iz
+// (seed, v): isti ulaz uvek daje iste stene, bez obzira na broj niti.
+// Izlaz: varijante jedna za drugom, po verteksu x, y, z, 0 kao short normalizovan na [-1, 1]
+// (GL_RGBA16I tekstura bafera). workerCount 0 = hardware_concurrency
+void generateAsteroidVariants(const std::vector<float>& baseVertices, int variantCount, unsigned int seed,
+    int workerCount, std::vector<short>& positions);
+
+// ACMR: transformisanih verteksa po trouglu za FIFO kes date velicine (0.5 je idealno za veliku mrezu, 3 najgore)
+float vertexCacheMissRatio(const std::vector<int>& indices, int cacheSize);
+float vertexCacheMissRatio(const std::vector<unsigned short>& indices, int cacheSize);
+
+// Prsten u XY ravni: unutrasnji i spoljasnji verteks za svaki segment, za GL_TRIANGLE_STRIP
+void generateRingVertices(int segments, float innerRadius, float outerRadius, std::vector<float>& vertices);
+
+#endif // MESH_GENERATORS_H
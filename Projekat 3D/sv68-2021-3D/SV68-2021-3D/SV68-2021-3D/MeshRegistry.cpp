@@ -0,0 +1,264 @@
+#include "MeshRegistry.h"
+#include "GpuMemory.h"
+#include "Trace.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+typedef std::tuple<int, int, int> SphereKey;       // sectors, stacks, SphereUVLayout
+
+std::map<SphereKey, std::weak_ptr<const SphereMesh>> spheres;
+std::map<int, std::weak_ptr<const SphereMesh>> icospheres;     // Po nivou podele
+std::map<std::tuple<int, int, unsigned int>, std::weak_ptr<const AsteroidVariantSet>> asteroidVariantSets;
+
+// FIFO kes post-transform verteksa za ACMR u izvestaju; manji od danasnjih GPU-ova, pa je procena konzervativna
+const int VERTEX_CACHE_SIZE = 16;
+
+int lodViewportHeight = 800;
+int lodSelections[SPHERE_LOD_COUNT] = {};
+long long lodTriangles = 0;
+int lastLodSelections[SPHERE_LOD_COUNT] = {};
+long long lastLodTriangles = 0;
+
+// Procena pokretanja verteks sejdera po crtanju (po instanci kod asteroida)
+int vertexShaderRuns(const SphereMesh& mesh) {
+    return (int)(mesh.cacheMissRatio() * mesh.indexCount() / 3 + 0.5f);
+}
+
+// Ikosfera u redosledu za crtanje; SphereMesh i AsteroidVariantSet moraju imati iste vertekse istim redom
+void prepareIcosphere(int subdivisions, std::vector<float>& vertices, std::vector<unsigned short>& indices) {
+    generateIcosphere(subdivisions, vertices, indices);
+    optimizeVertexCache(indices, (int)vertices.size() / 5);
+    optimizeVertexFetch(vertices, 5, indices);
+}
+
+void setupSphereAttributes(GLuint VBO, GLuint EBO) {
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    // packSphereVertices: normalizovani short-ovi, sejder i dalje dobija vec3/vec2 u float-u
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, PACKED_SPHERE_VERTEX_BYTES, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, PACKED_SPHERE_VERTEX_BYTES, (void*)(4 * sizeof(short)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+}
+
+SphereMesh::SphereMesh(int sectors, int stacks, SphereUVLayout layout)
+    : VBO(0), EBO(0), VAO(0), indices(0), type(GL_UNSIGNED_INT), vertices(0), sectors(sectors), stacks(stacks), missRatio(0.0f) {
+    TRACE_SCOPE("SphereMesh");
+
+    // CPU kopije zive samo do kraja konstruktora
+    std::vector<float> sphereVertices;
+    std::vector<int> sphereIndices;
+    generateSphereVertices(1.0f, sectors, stacks, layout, sphereVertices);
+    generateSphereIndices(sectors, stacks, (int)sphereVertices.size() / 5, sphereIndices);
+    indices = (GLsizei)sphereIndices.size();
+    missRatio = vertexCacheMissRatio(sphereIndices, VERTEX_CACHE_SIZE);
+
+    upload(sphereVertices, sphereIndices.data(), sphereIndices.size() * sizeof(int),
+        "Sphere " + std::to_string(sectors) + "x" + std::to_string(stacks));
+}
+
+SphereMesh::SphereMesh(int icosphereSubdivisions)
+    : VBO(0), EBO(0), VAO(0), indices(0), type(GL_UNSIGNED_SHORT), vertices(0), sectors(0), stacks(0), missRatio(0.0f) {
+    TRACE_SCOPE("SphereMesh");
+
+    std::vector<float> sphereVertices;
+    std::vector<unsigned short> sphereIndices;
+    prepareIcosphere(icosphereSubdivisions, sphereVertices, sphereIndices);
+    indices = (GLsizei)sphereIndices.size();
+    missRatio = vertexCacheMissRatio(sphereIndices, VERTEX_CACHE_SIZE);
+
+    upload(sphereVertices, sphereIndices.data(), sphereIndices.size() * sizeof(unsigned short),
+        "Icosphere " + std::to_string(icosphereSubdivisions));
+}
+
+void SphereMesh::upload(const std::vector<float>& vertexData, const void* indexData, size_t indexBytes, const std::string& label) {
+    vertices = (int)vertexData.size() / 5;
+    std::vector<short> packed;
+    packSphereVertices(vertexData, packed);
+
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(short), packed.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    VAO = createVertexArray();
+    glBindVertexArray(VAO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexData, GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    GpuMemory::track(GPU_BUFFER, VBO, packed.size() * sizeof(short), (label + " vertices").c_str(), GPU_MEMORY_SITE);
+    GpuMemory::track(GPU_BUFFER, EBO, indexBytes, (label + " indices").c_str(), GPU_MEMORY_SITE);
+}
+
+SphereMesh::~SphereMesh() {
+    glDeleteVertexArrays(1, &VAO);
+    GpuMemory::release(GPU_BUFFER, VBO);
+    GpuMemory::release(GPU_BUFFER, EBO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
+long long SphereMesh::bufferBytes() const {
+    return (long long)vertices * PACKED_SPHERE_VERTEX_BYTES + (long long)indices * (type == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(int));
+}
+
+GLuint SphereMesh::createVertexArray() const {
+    GLuint vertexArray;
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+    setupSphereAttributes(VBO, EBO);
+    glBindVertexArray(0);
+    return vertexArray;
+}
+
+AsteroidVariantSet::AsteroidVariantSet(int subdivisions, int variantCount, unsigned int seed)
+    : buffer(0), texture(0), variants(variantCount), vertices(0), buildMs(0.0) {
+    TRACE_SCOPE("AsteroidVariantSet");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<float> baseVertices;
+    std::vector<unsigned short> baseIndices;
+    prepareIcosphere(subdivisions, baseVertices, baseIndices);
+    vertices = (int)baseVertices.size() / 5;
+
+    std::vector<short> positions;
+    generateAsteroidVariants(baseVertices, variantCount, seed, 0, positions);
+    buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, positions.size() * sizeof(short), positions.data(), GL_STATIC_DRAW);
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA16I, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    GpuMemory::track(GPU_BUFFER, buffer, positions.size() * sizeof(short), "Asteroid variants", GPU_MEMORY_SITE);
+}
+
+AsteroidVariantSet::~AsteroidVariantSet() {
+    glDeleteTextures(1, &texture);
+    GpuMemory::release(GPU_BUFFER, buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+long long AsteroidVariantSet::bufferBytes() const {
+    return (long long)variants * vertices * 4 * sizeof(short);
+}
+
+std::shared_ptr<const SphereMesh> MeshRegistry::sphere(int sectors, int stacks, SphereUVLayout layout) {
+    SphereKey key(sectors, stacks, (int)layout);
+    std::shared_ptr<const SphereMesh> mesh = spheres[key].lock();
+    if (!mesh) {
+        mesh = std::make_shared<const SphereMesh>(sectors, stacks, layout);
+        spheres[key] = mesh;
+    }
+    return mesh;
+}
+
+std::shared_ptr<const SphereMesh> MeshRegistry::icosphere(int subdivisions) {
+    std::shared_ptr<const SphereMesh> mesh = icospheres[subdivisions].lock();
+    if (!mesh) {
+        mesh = std::make_shared<const SphereMesh>(subdivisions);
+        icospheres[subdivisions] = mesh;
+    }
+    return mesh;
+}
+
+std::shared_ptr<const AsteroidVariantSet> MeshRegistry::asteroidVariants(int subdivisions, int variantCount, unsigned int seed) {
+    std::tuple<int, int, unsigned int> key(subdivisions, variantCount, seed);
+    std::shared_ptr<const AsteroidVariantSet> variants = asteroidVariantSets[key].lock();
+    if (!variants) {
+        variants = std::make_shared<const AsteroidVariantSet>(subdivisions, variantCount, seed);
+        asteroidVariantSets[key] = variants;
+    }
+    return variants;
+}
+
+int MeshRegistry::liveMeshCount() {
+    int count = 0;
+    for (const auto& entry : spheres) {
+        if (!entry.second.expired()) count++;
+    }
+    for (const auto& entry : icospheres) {
+        if (!entry.second.expired()) count++;
+    }
+    return count;
+}
+
+void MeshRegistry::print(std::ostream& out) {
+    out << "MeshRegistry: " << liveMeshCount() << " sfera (ACMR za FIFO " << VERTEX_CACHE_SIZE << ")" << std::endl;
+    for (const auto& entry : spheres) {
+        std::shared_ptr<const SphereMesh> mesh = entry.second.lock();
+        if (!mesh) continue;
+        out << "  " << std::get<0>(entry.first) << "x" << std::get<1>(entry.first)
+            << (std::get<2>(entry.first) == SPHERE_UV_PLANET ? " (planet UV)" : "") << ": "
+            << mesh.use_count() - 1 << " tela, " << mesh->bufferBytes() / 1024 << " KB, ACMR " << mesh->cacheMissRatio()
+            << " (~" << vertexShaderRuns(*mesh) << " verteksa po crtanju)" << std::endl;
+    }
+    for (const auto& entry : icospheres) {
+        std::shared_ptr<const SphereMesh> mesh = entry.second.lock();
+        if (!mesh) continue;
+        out << "  ikosfera " << entry.first << " (" << mesh->indexCount() / 3 << " trouglova, 16-bit indeksi): "
+            << mesh.use_count() - 1 << " tela, " << mesh->bufferBytes() / 1024 << " KB, ACMR " << mesh->cacheMissRatio()
+            << " (~" << vertexShaderRuns(*mesh) << " verteksa po crtanju)" << std::endl;
+    }
+    for (const auto& entry : asteroidVariantSets) {
+        std::shared_ptr<const AsteroidVariantSet> variants = entry.second.lock();
+        if (!variants) continue;
+        out << "  asteroidne varijante (ikosfera " << std::get<0>(entry.first) << ", seed " << std::get<2>(entry.first) << "): "
+            << variants->variantCount() << " x " << variants->vertexCount() << " verteksa, " << variants.use_count() - 1
+            << " pojasa, " << variants->bufferBytes() / 1024 << " KB, napravljene za " << variants->generationMs() << " ms" << std::endl;
+    }
+}
+
+SphereLodChain::SphereLodChain(int sectors, int stacks, SphereUVLayout layout) : level(-1) {
+    buildSphereLodChain(sectors, stacks, levels);
+    for (int i = 0; i < SPHERE_LOD_COUNT; ++i) {
+        meshes[i] = MeshRegistry::sphere(levels[i].sectors, levels[i].stacks, layout);
+    }
+}
+
+const SphereMesh& SphereLodChain::select(const glm::vec3& center, float radius, const glm::vec3& cameraPos, const glm::mat4& projection) {
+    level = selectSphereLod(levels, projectedRadiusPixels(center, radius, cameraPos, projection, lodViewportHeight), level);
+
+    const SphereMesh& mesh = *meshes[level];
+    lodSelections[level]++;
+    lodTriangles += mesh.indexCount() / 3;
+    return mesh;
+}
+
+void SphereLodChain::setViewportHeight(int pixels) {
+    lodViewportHeight = pixels;
+}
+
+void SphereLodChain::beginFrame() {
+    for (int i = 0; i < SPHERE_LOD_COUNT; ++i) {
+        lastLodSelections[i] = lodSelections[i];
+        lodSelections[i] = 0;
+    }
+    lastLodTriangles = lodTriangles;
+    lodTriangles = 0;
+}
+
+void SphereLodChain::print(std::ostream& out) {
+    out << "SphereLod (poslednji frejm):";
+    for (int i = 0; i < SPHERE_LOD_COUNT; ++i) {
+        out << " L" << i << "=" << lastLodSelections[i];
+    }
+    out << ", " << lastLodTriangles << " trouglova" << std::endl;
+}
@@ -0,0 +1,127 @@
+#ifndef MESH_REGISTRY_H
+#define MESH_REGISTRY_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "MeshGenerators.h"
+#include "SphereLod.h"
+
+// Jedinicna sfera na GPU-u (poluprecnik 1, verteks = x, y, z, s, t zbijeni u 12 bajtova, packSphereVertices);
+// velicinu tela daje model matrica.
+// UV sfera (sectors x stacks) ima GLuint indekse u redosledu stekova; ikosfera ima GLushort indekse
+// preuredjene za kes verteksa (optimizeVertexCache/Fetch), pa se crta sa indexType().
+// VAO ima samo atribute 0 i 1; ko dodaje svoje atribute (instance asteroida) pravi VAO kroz createVertexArray().
+class SphereMesh {
+public:
+    SphereMesh(int sectors, int stacks, SphereUVLayout layout);
+    explicit SphereMesh(int icosphereSubdivisions);
+    ~SphereMesh();
+    SphereMesh(const SphereMesh&) = delete;
+    SphereMesh& operator=(const SphereMesh&) = delete;
+
+    GLuint vertexArray() const { return VAO; }
+    GLsizei indexCount() const { return indices; }
+    GLenum indexType() const { return type; }
+    int vertexCount() const { return vertices; }
+    int sectorCount() const { return sectors; }
+    int stackCount() const { return stacks; }
+    long long bufferBytes() const;
+
+    // ACMR za FIFO kes od 16 verteksa, izracunat pri pravljenju (MeshRegistry::print)
+    float cacheMissRatio() const { return missRatio; }
+
+    // Novi VAO nad deljenim VBO/EBO sa atributima 0 i 1; brise ga pozivalac
+    GLuint createVertexArray() const;
+
+private:
+    GLuint VBO, EBO, VAO;
+    GLsizei indices;
+    GLenum type;
+    int vertices;
+    int sectors;
+    int stacks;
+    float missRatio;
+
+    void upload(const std::vector<float>& vertexData, const void* indexData, size_t indexBytes, const std::string& label);
+};
+
+// Nepravilne stene za instancirane asteroide: variantCount pomerenih kopija pozicija ikosfere iz
+// MeshRegistry::icosphere(subdivisions), u jednom baferu kao GL_TEXTURE_BUFFER (GL_RGBA16I, x, y, z, 0).
+// Indeksi i UV ostaju iz ikosfere; verteks sejder cita poziciju sa variant * vertexCount() + gl_VertexID,
+// pa ceo pojas ostaje jedan instancirani poziv (asteroids.vert). Pravi se na vise niti, za par ms.
+class AsteroidVariantSet {
+public:
+    AsteroidVariantSet(int subdivisions, int variantCount, unsigned int seed);
+    ~AsteroidVariantSet();
+    AsteroidVariantSet(const AsteroidVariantSet&) = delete;
+    AsteroidVariantSet& operator=(const AsteroidVariantSet&) = delete;
+
+    GLuint positionTexture() const { return texture; }
+    int variantCount() const { return variants; }
+    int vertexCount() const { return vertices; }      // Po varijanti
+    long long bufferBytes() const;
+    double generationMs() const { return buildMs; }
+
+private:
+    GLuint buffer, texture;
+    int variants;
+    int vertices;
+    double buildMs;
+};
+
+// Deljene mreze tela: jedna sfera po (sectors, stacks, UV raspored) ili po nivou podele ikosfere,
+// bez obzira na broj tela.
+//
+//   std::shared_ptr<const SphereMesh> mesh = MeshRegistry::sphere(36, 18, SPHERE_UV_PLANET);
+//   glBindVertexArray(mesh->vertexArray());
+//   glDrawElements(GL_TRIANGLES, mesh->indexCount(), mesh->indexType(), 0);
+//
+// Verteksi i indeksi postoje na CPU-u samo dok se salju; baferi zive dok postoji bar jedno telo koje
+// ih koristi (registar cuva weak_ptr), pa stres scena posle svake tacke sweep-a oslobadja svoje mreze.
+// Samo GL nit.
+class MeshRegistry {
+public:
+    static std::shared_ptr<const SphereMesh> sphere(int sectors, int stacks, SphereUVLayout layout);
+    // Ravnomerna gustina trouglova, za instancirane asteroide gde se cena verteksa mnozi brojem instanci
+    static std::shared_ptr<const SphereMesh> icosphere(int subdivisions);
+    // Isti seed daje iste stene; pojasevi biraju varijantu po instanci (AsteroidBelt)
+    static std::shared_ptr<const AsteroidVariantSet> asteroidVariants(int subdivisions, int variantCount, unsigned int seed);
+
+    static int liveMeshCount();
+    static void print(std::ostream& out);
+};
+
+// Lanac sfera jednog tela (SPHERE_LOD_COUNT nivoa iz MeshRegistry-ja, deljenih sa drugim telima) i
+// nivo izabran u proslom frejmu, da histereza ima od cega da krene:
+//
+//   const SphereMesh& mesh = lods.select(position, radius * radius, cameraPos, projection);
+//   glBindVertexArray(mesh.vertexArray());
+//
+// Visina viewport-a je ista za sva tela pa se postavlja jednom (setViewportHeight).
+class SphereLodChain {
+public:
+    SphereLodChain(int sectors, int stacks, SphereUVLayout layout);
+
+    // radius = vidljivi poluprecnik u svetu (posle model matrice)
+    const SphereMesh& select(const glm::vec3& center, float radius, const glm::vec3& cameraPos, const glm::mat4& projection);
+    int currentLevel() const { return level; }
+
+    static void setViewportHeight(int pixels);
+    // Brojaci izbora po nivou; beginFrame() ih prebacuje u poslednji frejm
+    static void beginFrame();
+    static void print(std::ostream& out);
+
+private:
+    SphereLodLevel levels[SPHERE_LOD_COUNT];
+    std::shared_ptr<const SphereMesh> meshes[SPHERE_LOD_COUNT];
+    int level;
+};
+
+#endif // MESH_REGISTRY_H
@@ -1,119 +1,16 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "Moon.h"
+#include "OrbitMath.h"
 
 
 
 Moon::Moon(Planet& planet, float r, int sectors, int stacks, float rotSpeed, float orbSpeed, float distance)
-    : parentPlanet(planet), radius(r), sectorCount(sectors), stackCount(stacks),
-    rotationSpeed(rotSpeed), orbitSpeed(orbSpeed), distanceFromPlanet(distance) {
-
-    // Generate sphere vertices and indices
-    generateVertices();
-    generateIndices();
-
-    // Setup OpenGL buffers and attributes
-    setupMesh();
-}
-
-
-Moon::~Moon() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-}
-
-void Moon::generateVertices() {
-    float x, y, z, xy;
-    float s, t;
-    float sectorStep = (float)(2 * M_PI / sectorCount);
-    float stackStep = (float)(M_PI / stackCount);
-    float sectorAngle, stackAngle;
-
-    for (int i = 0; i <= stackCount; ++i) {
-        stackAngle = (float)(M_PI / 2 - i * stackStep);
-        xy = radius * cosf(stackAngle);
-        z = radius * sinf(stackAngle);
-
-        for (int j = 0; j <= sectorCount; ++j) {
-            sectorAngle = j * sectorStep;
-            y = xy * cosf(sectorAngle); // Ranije x, sada y
-            x = xy * sinf(sectorAngle); // Ranije y, sada x
-
-            // UV koordinate
-            s = (float)j / (float)(sectorCount);
-            t = 1.0f - (float)i / (float)(stackCount);
-
-
-            if (i == 0) t = 0.01f; // Avoid collapsing at the north pole
-            if (i == stackCount) t = 0.99f; // Avoid collapsing at the south pole
-
-            // Dodavanje verteksa
-            sphere_vertices.push_back(x);
-            sphere_vertices.push_back(y);
-            sphere_vertices.push_back(z);
-            sphere_vertices.push_back(s);
-            sphere_vertices.push_back(t);
-        }
-    }
+    : lods(sectors, stacks, SPHERE_UV_PLANET), radius(r), sectorCount(sectors), stackCount(stacks),
+    rotationSpeed(rotSpeed), orbitSpeed(orbSpeed), distanceFromPlanet(distance), parentPlanet(planet) {
 }
 
-void Moon::generateIndices() {
-    int k1, k2;
-    for (int i = 0; i < stackCount; ++i) {
-        k1 = i * (sectorCount + 1);
-        k2 = k1 + sectorCount + 1;
-
-        for (int j = 0; j < sectorCount; ++j, ++k1, ++k2) {
-            if (i != 0) {
-                sphere_indices.push_back(k1);
-                sphere_indices.push_back(k2);
-                sphere_indices.push_back(k1 + 1);
-            }
-            if (i != (stackCount - 1)) {
-                sphere_indices.push_back(k1 + 1);
-                sphere_indices.push_back(k2);
-                sphere_indices.push_back(k2 + 1);
-            }
-        }
-    }
-
-    // Zatvaranje donjeg pola
-    int bottomCenterIndex = (int)sphere_vertices.size() / 5 - 1;
-    int lastRowStart = bottomCenterIndex - sectorCount;
-    for (int j = 0; j < sectorCount; ++j) {
-        int next = (j == sectorCount - 1) ? lastRowStart : lastRowStart + j + 1;
-        sphere_indices.push_back(bottomCenterIndex);
-        sphere_indices.push_back(lastRowStart + j);
-        sphere_indices.push_back(next);
-    }
-}
-
-void Moon::setupMesh() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sphere_vertices.size() * sizeof(float), sphere_vertices.data(), GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sphere_indices.size() * sizeof(int), sphere_indices.data(), GL_DYNAMIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-
-void Moon::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, const glm::mat4& projection, float deltaTime, float speedMultiplier) {
+void Moon::Draw(GLuint shaderProgram, const TextureLayer& texture, const glm::mat4& view, const glm::mat4& projection, float deltaTime, glm::vec3 cameraPos, float speedMultiplier) {
     // Update rotation and orbit angles
     orbitAngle += orbitSpeed * deltaTime * speedMultiplier;
     if (orbitAngle > 360.0f) orbitAngle -= 360.0f;
@@ -134,7 +31,7 @@ void Moon::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, c
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     model = glm::rotate(model, glm::radians(rotationAngle), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::scale(model, glm::vec3(radius));
+    model = glm::scale(model, glm::vec3(radius * radius));     // Jedinicna sfera; vidljiva velicina kao i ranije (Planet::Draw)
 
     // Use shader program
     glUseProgram(shaderProgram);
@@ -144,14 +41,19 @@ void Moon::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, c
     glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
     glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
-    // Bind texture
+    // Bind texture array layer (shared with every body of the same size class)
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glUniform1i(glGetUniformLocation(shaderProgram, "moonTexture"), 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture.array);
+    glUniform1i(glGetUniformLocation(shaderProgram, "moonTextures"), 0);
+    glUniform1i(glGetUniformLocation(shaderProgram, "layer"), texture.layer);
 
-    // Bind VAO and draw
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, sphere_indices.size(), GL_UNSIGNED_INT, 0);
+    // Close up, quadtree patches replace the sphere (SurfaceTerrain)
+    if (terrain && terrain->draw(terrainBody, model, position, radius * radius, cameraPos, view, projection)) return;
+
+    // Bind VAO of the LOD level picked by on-screen size and draw
+    const SphereMesh& mesh = lods.select(position, radius * radius, cameraPos, projection);
+    glBindVertexArray(mesh.vertexArray());
+    glDrawElements(GL_TRIANGLES, mesh.indexCount(), mesh.indexType(), 0);
     glBindVertexArray(0);
 }
 
@@ -159,12 +61,15 @@ float Moon::getRadius() const {
     return radius;
 }
 
+void Moon::setOrbitAngle(float degrees) {
+    orbitAngle = degrees;
+}
+
+void Moon::setTerrain(SurfaceTerrain* surface, int body) {
+    terrain = surface;
+    terrainBody = body;
+}
+
 glm::vec3 Moon::getPosition() const {
-    float orbitRadians = glm::radians(orbitAngle);
-    glm::vec3 planetPos = parentPlanet.getPosition(); // Uzmi poziciju planete
-    return planetPos + glm::vec3(
-        cos(orbitRadians) * distanceFromPlanet,
-        0.0f,
-        sin(orbitRadians) * distanceFromPlanet
-    );
+    return circularOrbitPosition(parentPlanet.getPosition(), orbitAngle, distanceFromPlanet);
 }
@@ -3,18 +3,19 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <memory>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "Planet.h" // Uključuje osnovne planetarne parametre
+#include "MeshRegistry.h"
+#include "SurfaceTerrain.h"
 
 class Moon {
 private:
-    std::vector<float> sphere_vertices;
-    std::vector<int> sphere_indices;
-    GLuint VBO, VAO, EBO;
+    SphereLodChain lods;        // Jedinicne sfere po nivou detalja (MeshRegistry), bira se po velicini na ekranu
     float radius;
     int sectorCount;
     int stackCount;
@@ -25,19 +26,19 @@ private:
     float distanceFromPlanet; // Udaljenost od planete
     glm::vec3 orbitAxis = glm::vec3(0.0f, 1.0f, 0.0f); // Osa orbite
     Planet& parentPlanet; // Referenca na planetu oko koje orbitira
+    SurfaceTerrain* terrain = nullptr;  // Povrsina izbliza (--terrain); nullptr = uvek sfera
+    int terrainBody = -1;
 
-    void generateVertices();
-    void generateIndices();
-    void setupMesh();
 
 public:
     Moon(Planet& planet, float r, int sectors, int stacks, float rotSpeed, float orbSpeed, float distance);
-    ~Moon();
 
     glm::vec3 getPosition() const;
     float getRadius() const;
+    void setOrbitAngle(float degrees);
+    void setTerrain(SurfaceTerrain* surface, int body);    // body iz SurfaceTerrain::addBody
 
-    void Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, const glm::mat4& projection, float deltaTime, float speedMultiplier);
+    void Draw(GLuint shaderProgram, const TextureLayer& texture, const glm::mat4& view, const glm::mat4& projection, float deltaTime, glm::vec3 cameraPos, float speedMultiplier);
 };
 
 #endif // MOON_H
@@ -0,0 +1,69 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+#include "OrbitMath.h"
+
+glm::vec3 ellipticalOrbitPosition(float orbitAngleDegrees, float semiMajorAxis, float eccentricity) {
+    float orbitRadians = glm::radians(orbitAngleDegrees);
+
+    // Pravilna eliptična orbita (poluvelika i polumana osa)
+    float semiMinorAxis = semiMajorAxis * sqrt(1 - eccentricity * eccentricity); // Polumana osa (b)
+
+    // Izračunavanje eliptične pozicije
+    float x = cos(orbitRadians) * semiMajorAxis - semiMajorAxis * eccentricity; // Translacija da Sunce bude u žarištu
+    float z = sin(orbitRadians) * semiMinorAxis;
+
+    return glm::vec3(x, 0.0f, z);
+}
+
+glm::vec3 circularOrbitPosition(const glm::vec3& center, float orbitAngleDegrees, float distance) {
+    float orbitRadians = glm::radians(orbitAngleDegrees);
+    return center + glm::vec3(
+        cos(orbitRadians) * distance,
+        0.0f,
+        sin(orbitRadians) * distance
+    );
+}
+
+void generateBeltInstances(int count, float innerRadius, float outerRadius, unsigned int seed, std::vector<glm::vec4>& instances) {
+    std::random_device rd;
+    std::mt19937 gen(seed != 0 ? seed : rd());
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
+    std::uniform_real_distribution<float> radiusDist(innerRadius, outerRadius);
+    std::uniform_real_distribution<float> heightDist(-1.0f, 1.0f);
+
+    instances.clear();
+    instances.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        float angle = angleDist(gen);
+        float radius = radiusDist(gen);
+        float height = heightDist(gen);
+
+        float x = radius * cos(angle);
+        float y = height;
+        float z = radius * sin(angle);
+
+        // Ranije translate * scale(0.05) u mat4; rotacije nikad nije bilo, pa su dovoljni pozicija i skala
+        instances.push_back(glm::vec4(x, y, z, 0.05f));
+    }
+}
+
+void generateBeltVariants(int count, int variantCount, unsigned int seed, std::vector<unsigned char>& variants) {
+    std::random_device rd;
+    std::mt19937 gen(seed != 0 ? seed ^ 0x9e3779b9u : rd());
+    std::uniform_int_distribution<int> variantDist(0, variantCount - 1);
+
+    variants.resize(count);
+    for (unsigned char& variant : variants) variant = (unsigned char)variantDist(gen);
+}
+
+bool isInsideBeltVolume(const glm::vec3& point, float innerRadius, float outerRadius) {
+    float distance = glm::length(point);    //razdaljina od (0, 0, 0)
+
+    if (distance >= innerRadius && distance <= outerRadius && -1.0f <= point.y && point.y <= 1.0f) {
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,26 @@
+#ifndef ORBIT_MATH_H
+#define ORBIT_MATH_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+// Pozicije tela i asteroidni pojasevi bez OpenGL poziva - koriste ih klase i microbenchmark
+
+// Elipsa u XZ ravni sa Suncem u zaristu (Planet::getPosition)
+glm::vec3 ellipticalOrbitPosition(float orbitAngleDegrees, float semiMajorAxis, float eccentricity);
+
+// Kruzna orbita oko centra u XZ ravni (Moon::getPosition)
+glm::vec3 circularOrbitPosition(const glm::vec3& center, float orbitAngleDegrees, float distance);
+
+// Instance asteroida, 16 bajtova: xyz = pozicija, w = skala; seed 0 = nasumican raspored (random_device).
+// Isti niz slucajnih brojeva kao ranije model matrice, pa replay sa istim seed-om daje isti pojas
+void generateBeltInstances(int count, float innerRadius, float outerRadius, unsigned int seed, std::vector<glm::vec4>& instances);
+
+// Varijanta stene po instanci (AsteroidVariantSet), ravnomerno; seed 0 = nasumicno.
+// Poseban niz slucajnih brojeva, pa pozicije iz generateBeltInstances ostaju iste
+void generateBeltVariants(int count, int variantCount, unsigned int seed, std::vector<unsigned char>& variants);
+
+// Prsten oko (0, 0, 0) debljine 2 po Y osi (AsteroidBelt::isInsideBelt)
+bool isInsideBeltVolume(const glm::vec3& point, float innerRadius, float outerRadius);
+
+#endif // ORBIT_MATH_H
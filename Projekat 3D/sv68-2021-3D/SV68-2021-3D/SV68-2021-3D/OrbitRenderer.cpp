@@ -0,0 +1,141 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "OrbitRenderer.h"
+#include "GpuMemory.h"
+#include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
+
+static_assert((OrbitRenderer::MIN_SEGMENTS << (OrbitRenderer::TIER_COUNT - 1)) == OrbitRenderer::MAX_SEGMENTS,
+    "Poslednji nivo mora biti MAX_SEGMENTS");
+
+namespace {
+
+// Isto sto i orbit.vert (ORBIT_MAX_PIXEL_ERROR, NEAR_DISTANCE)
+const float ORBIT_MAX_PIXEL_ERROR = 0.5f;
+const float NEAR_DISTANCE = 0.1f;
+
+// Najmanji nivo cijih MIN_SEGMENTS << tier segmenata je dovoljno za orbitu (racun iz orbit.vert)
+int segmentTier(const OrbitInstance& orbit, const glm::vec3& cameraPos, float pixelsPerUnit) {
+    float a = orbit.semiMajorAxis;
+    glm::vec3 ellipseCenter = orbit.center - glm::vec3(a * orbit.eccentricity, 0.0f, 0.0f);
+    float radial = std::abs(glm::length(glm::vec2(cameraPos.x - ellipseCenter.x, cameraPos.z - ellipseCenter.z)) - a);
+    float distance = std::max(glm::length(glm::vec2(radial, cameraPos.y - ellipseCenter.y)), NEAR_DISTANCE);
+    float segments = std::ceil((float)M_PI * std::sqrt(a * pixelsPerUnit / distance / (2.0f * ORBIT_MAX_PIXEL_ERROR)));
+
+    int tier = 0;
+    while (tier < OrbitRenderer::TIER_COUNT - 1 && (float)(OrbitRenderer::MIN_SEGMENTS << tier) < segments) tier++;
+    return tier;
+}
+
+}
+
+OrbitRenderer::OrbitRenderer() : VAO(0), VBO(0), capacity(0), dirty(false) {
+    std::fill(tierStart, tierStart + TIER_COUNT + 1, 0);
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    // Nema atributa po verteksu; oba atributa su po instanci (center + a, boja + e)
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(OrbitInstance), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(OrbitInstance), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+OrbitRenderer::~OrbitRenderer() {
+    GpuMemory::release(GPU_BUFFER, VBO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+int OrbitRenderer::add(const OrbitInstance& orbit) {
+    orbits.push_back(orbit);
+    dirty = true;
+    return (int)orbits.size() - 1;
+}
+
+void OrbitRenderer::setCenter(int index, const glm::vec3& center) {
+    if (orbits[index].center == center) return;
+    orbits[index].center = center;
+    dirty = true;
+}
+
+void OrbitRenderer::clear() {
+    orbits.clear();
+    orbitTiers.clear();
+    dirty = true;
+}
+
+// Orbite po nivoima (stabilno, brojanjem) u sorted i u bafer
+void OrbitRenderer::upload() {
+    int counts[TIER_COUNT] = {};
+    for (int tier : orbitTiers) counts[tier]++;
+    tierStart[0] = 0;
+    for (int tier = 0; tier < TIER_COUNT; ++tier) tierStart[tier + 1] = tierStart[tier] + counts[tier];
+
+    int next[TIER_COUNT];
+    std::copy(tierStart, tierStart + TIER_COUNT, next);
+    sorted.resize(orbits.size());
+    for (size_t i = 0; i < orbits.size(); ++i) sorted[next[orbitTiers[i]]++] = orbits[i];
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (sorted.size() > capacity) {
+        capacity = sorted.size();
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(OrbitInstance), sorted.data(), GL_DYNAMIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, capacity * sizeof(OrbitInstance), "Orbit instances", GPU_MEMORY_SITE);
+    }
+    else if (!sorted.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sorted.size() * sizeof(OrbitInstance), sorted.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    dirty = false;
+}
+
+void OrbitRenderer::Draw(GLuint shaderProgram, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, int viewportHeight) {
+    // Pikseli po jedinici sveta na udaljenosti 1 (projection[1][1] = 1 / tan(fov / 2))
+    float pixelsPerUnit = projection[1][1] * viewportHeight * 0.5f;
+
+    // Bafer se presortira samo kad neka orbita promeni nivo (ili se promene same orbite)
+    orbitTiers.resize(orbits.size(), -1);
+    for (size_t i = 0; i < orbits.size(); ++i) {
+        int tier = segmentTier(orbits[i], cameraPos, pixelsPerUnit);
+        if (tier == orbitTiers[i]) continue;
+        orbitTiers[i] = tier;
+        dirty = true;
+    }
+    if (dirty) upload();
+    if (orbits.empty()) return;
+
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform3fv(glGetUniformLocation(shaderProgram, "cameraPos"), 1, glm::value_ptr(cameraPos));
+    glUniform1f(glGetUniformLocation(shaderProgram, "pixelsPerUnit"), pixelsPerUnit);
+    glUniform1i(glGetUniformLocation(shaderProgram, "minSegments"), MIN_SEGMENTS);
+    GLint maxSegmentsLoc = glGetUniformLocation(shaderProgram, "maxSegments");
+
+    // Po poziv za nivo: segments + 1 verteks zatvara petlju, svaka instanca je zasebna traka. Pomeraj
+    // atributa se postavlja po pozivu (prva instanca nivoa), jer GL 3.3 nema baseInstance
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    for (int tier = 0; tier < TIER_COUNT; ++tier) {
+        GLsizei count = tierStart[tier + 1] - tierStart[tier];
+        if (count == 0) continue;
+        size_t first = (size_t)tierStart[tier] * sizeof(OrbitInstance);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(OrbitInstance), (void*)first);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(OrbitInstance), (void*)(first + 4 * sizeof(float)));
+        int segments = MIN_SEGMENTS << tier;
+        glUniform1i(maxSegmentsLoc, segments);
+        glDrawArraysInstanced(GL_LINE_STRIP, 0, segments + 1, count);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
@@ -0,0 +1,59 @@
+#ifndef ORBIT_RENDERER_H
+#define ORBIT_RENDERER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Orbitalni elementi jedne orbite: elipsa u XZ ravni oko center-a, kao ellipticalOrbitPosition
+// (center je u zaristu). 32 bajta po orbiti, ceo zapis je jedna instanca.
+struct OrbitInstance {
+    glm::vec3 center;
+    float semiMajorAxis;
+    glm::vec3 color;
+    float eccentricity;
+};
+
+// Orbite u instanciranim pozivima (GL_LINE_STRIP po instanci), po jedan za svaki nivo broja segmenata
+// (MIN_SEGMENTS, 2x, 4x ... MAX_SEGMENTS). Tacke se ne cuvaju nigde: orbit.vert racuna elipsu iz gl_VertexID
+// i elemenata instance, a broj segmenata bira po orbiti iz greske tetive na ekranu (ORBIT_MAX_PIXEL_ERROR).
+// Draw racuna isto na CPU-u i rasporedjuje orbite po najmanjem nivou koji im je dovoljan, pa daleka orbita
+// ne placa MAX_SEGMENTS verteksa; verteksi preko broja izabranog u sejderu padaju na pocetnu tacku.
+//
+//   OrbitRenderer orbits;
+//   orbits.add({ glm::vec3(0.0f), 3.0f, glm::vec3(0.8f), 0.02f });
+//   orbits.Draw(orbitProgram, view, projection, cameraPos, screenHeight);
+//
+// Pokretni centri (meseci) menjaju se kroz setCenter; bafer se salje tek pri crtanju.
+class OrbitRenderer {
+public:
+    static const int MIN_SEGMENTS = 16;
+    static const int MAX_SEGMENTS = 512;
+    static const int TIER_COUNT = 6;            // MIN_SEGMENTS << (TIER_COUNT - 1) == MAX_SEGMENTS
+
+    OrbitRenderer();
+    ~OrbitRenderer();
+    OrbitRenderer(const OrbitRenderer&) = delete;
+    OrbitRenderer& operator=(const OrbitRenderer&) = delete;
+
+    int add(const OrbitInstance& orbit);     // Vraca indeks za setCenter
+    void setCenter(int index, const glm::vec3& center);
+    void clear();
+    int orbitCount() const { return (int)orbits.size(); }
+
+    void Draw(GLuint shaderProgram, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos, int viewportHeight);
+
+private:
+    std::vector<OrbitInstance> orbits;
+    std::vector<OrbitInstance> sorted;      // orbits poredjane po nivoima, kako idu u bafer
+    std::vector<int> orbitTiers;            // Nivo svake orbite iz poslednjeg Draw-a
+    int tierStart[TIER_COUNT + 1];          // Prva instanca nivoa u sorted
+    GLuint VAO, VBO;
+    size_t capacity;        // Broj instanci za koje je bafer alociran
+    bool dirty;
+
+    void upload();
+};
+
+#endif // ORBIT_RENDERER_H
@@ -0,0 +1,198 @@
+#include "PassTimer.h"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+PassTimer::PassTimer()
+    : currentSlot(0), resolvedFrames(0), droppedFrames(0) {
+}
+
+PassTimer::~PassTimer() {
+    for (FrameSlot& slot : slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+        }
+    }
+}
+
+void PassTimer::beginFrame() {
+    currentSlot = (currentSlot + 1) % FRAMES_IN_FLIGHT;
+    FrameSlot& slot = slots[currentSlot];
+
+    // Slot je poslednji put koriscen pre FRAMES_IN_FLIGHT frejmova; ako GPU jos nije
+    // zavrsio te upite, frejm se odbacuje umesto da se ceka na rezultat
+    if (slot.pending && !resolve(slot)) {
+        droppedFrames++;
+    }
+
+    slot.samples.clear();
+    slot.usedQueries = 0;
+    slot.pending = false;
+    openPasses.clear();
+}
+
+void PassTimer::endFrame() {
+    if (!openPasses.empty()) {
+        std::cerr << "PassTimer: " << openPasses.size() << " prolaz(a) nije zatvoreno do kraja frejma" << std::endl;
+        while (!openPasses.empty()) end();
+    }
+
+    FrameSlot& slot = slots[currentSlot];
+    slot.pending = !slot.samples.empty();
+}
+
+int PassTimer::nextQuery(FrameSlot& slot) {
+    if (slot.usedQueries == static_cast<int>(slot.queries.size())) {
+        const int growBy = 32;
+        size_t oldSize = slot.queries.size();
+        slot.queries.resize(oldSize + growBy);
+        glGenQueries(growBy, slot.queries.data() + oldSize);
+    }
+    return slot.usedQueries++;
+}
+
+void PassTimer::begin(const char* name) {
+    FrameSlot& slot = slots[currentSlot];
+
+    PassSample sample;
+    sample.name = name;
+    sample.cpuMs = 0.0;
+    sample.queryIndex = nextQuery(slot);
+    nextQuery(slot);    // Rezervisi i upit za kraj prolaza
+
+    glQueryCounter(slot.queries[sample.queryIndex], GL_TIMESTAMP);
+    sample.cpuStart = Clock::now();
+    sample.traceStartNs = Tracer::now();
+    sample.glStart = GLStats::total();
+
+    openPasses.push_back(static_cast<int>(slot.samples.size()));
+    slot.samples.push_back(sample);
+}
+
+void PassTimer::end() {
+    if (openPasses.empty()) {
+        std::cerr << "PassTimer: end() bez odgovarajuceg begin()" << std::endl;
+        return;
+    }
+
+    FrameSlot& slot = slots[currentSlot];
+    PassSample& sample = slot.samples[openPasses.back()];
+    openPasses.pop_back();
+
+    std::chrono::duration<double, std::milli> cpuTime = Clock::now() - sample.cpuStart;
+    sample.cpuMs = cpuTime.count();
+    sample.gl = GLStats::total() - sample.glStart;
+    if (Tracer::isEnabled()) {
+        Tracer::record(sample.name, sample.traceStartNs, Tracer::now());
+    }
+    glQueryCounter(slot.queries[sample.queryIndex + 1], GL_TIMESTAMP);
+}
+
+static PassTiming& findOrAdd(std::vector<PassTiming>& table, const char* name) {
+    for (PassTiming& row : table) {
+        if (row.name == name) return row;
+    }
+    PassTiming row;
+    row.name = name;
+    table.push_back(row);
+    return table.back();
+}
+
+bool PassTimer::resolve(FrameSlot& slot) {
+    // Upiti se zavrsavaju redom, pa je dovoljno proveriti poslednji
+    GLint available = 0;
+    glGetQueryObjectiv(slot.queries[slot.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+
+    latestTimings.clear();
+    for (const PassSample& sample : slot.samples) {
+        GLuint64 startNs = 0, endNs = 0;
+        glGetQueryObjectui64v(slot.queries[sample.queryIndex], GL_QUERY_RESULT, &startNs);
+        glGetQueryObjectui64v(slot.queries[sample.queryIndex + 1], GL_QUERY_RESULT, &endNs);
+        double gpuMs = (endNs > startNs) ? (endNs - startNs) / 1.0e6 : 0.0;
+
+        PassTiming& row = findOrAdd(latestTimings, sample.name);
+        row.calls++;
+        row.cpuMs += sample.cpuMs;
+        row.gpuMs += gpuMs;
+        row.gl += sample.gl;
+    }
+
+    for (const PassTiming& row : latestTimings) {
+        PassTiming& total = findOrAdd(totalTimings, row.name.c_str());
+        total.calls += row.calls;
+        total.cpuMs += row.cpuMs;
+        total.gpuMs += row.gpuMs;
+        total.gl += row.gl;
+    }
+
+    resolvedFrames++;
+    slot.pending = false;
+    return true;
+}
+
+const std::vector<PassTiming>& PassTimer::latest() const {
+    return latestTimings;
+}
+
+std::vector<PassTiming> PassTimer::average() const {
+    std::vector<PassTiming> averaged = totalTimings;
+    if (resolvedFrames == 0) return averaged;
+
+    for (PassTiming& row : averaged) {
+        row.cpuMs /= resolvedFrames;
+        row.gpuMs /= resolvedFrames;
+        row.calls = (row.calls + resolvedFrames / 2) / resolvedFrames;
+        row.gl.divide(resolvedFrames);
+    }
+    return averaged;
+}
+
+int PassTimer::resolvedFrameCount() const {
+    return resolvedFrames;
+}
+
+int PassTimer::droppedFrameCount() const {
+    return droppedFrames;
+}
+
+static void printGLColumns(std::ostream& out, const GLCounters& gl) {
+    out << std::setw(9) << gl.calls << std::setw(7) << gl.drawCalls << std::setw(8) << gl.redundantStateSets()
+        << std::setw(8) << gl.uniformLookups << std::setw(8) << gl.objectsCreated;
+}
+
+void PassTimer::print(std::ostream& out, bool averaged) const {
+    std::vector<PassTiming> table = averaged ? average() : latestTimings;
+
+    bool withGL = GLStats::isInstalled();
+    double cpuTotal = 0.0, gpuTotal = 0.0;
+    GLCounters glTotal;
+
+    out << std::fixed << std::setprecision(3);
+    out << "==================== PASS TIMINGS (" << (averaged ? "average" : "last frame") << ") ====================" << std::endl;
+    out << std::left << std::setw(36) << "pass" << std::right << std::setw(7) << "calls"
+        << std::setw(12) << "cpu ms" << std::setw(12) << "gpu ms";
+    if (withGL) {
+        out << std::setw(9) << "gl" << std::setw(7) << "draws" << std::setw(8) << "redund"
+            << std::setw(8) << "uniLoc" << std::setw(8) << "gen";
+    }
+    out << std::endl;
+
+    for (const PassTiming& row : table) {
+        out << std::left << std::setw(36) << row.name << std::right << std::setw(7) << row.calls
+            << std::setw(12) << row.cpuMs << std::setw(12) << row.gpuMs;
+        if (withGL) printGLColumns(out, row.gl);
+        out << std::endl;
+        cpuTotal += row.cpuMs;
+        gpuTotal += row.gpuMs;
+        glTotal += row.gl;
+    }
+    out << std::left << std::setw(43) << "total" << std::right
+        << std::setw(12) << cpuTotal << std::setw(12) << gpuTotal;
+    if (withGL) printGLColumns(out, glTotal);
+    out << std::endl;
+    out << "resolved frames: " << resolvedFrames << ", dropped (GPU behind): " << droppedFrames << std::endl;
+}
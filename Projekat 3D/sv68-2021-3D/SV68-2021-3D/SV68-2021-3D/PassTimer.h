@@ -0,0 +1,95 @@
+#ifndef PASS_TIMER_H
+#define PASS_TIMER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+#include "Trace.h"
+#include "GLStats.h"
+
+// Jedan red tabele: ukupno vreme svih poziva prolaza sa istim imenom u frejmu
+struct PassTiming {
+    std::string name;
+    int calls = 0;
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    GLCounters gl;      // Popunjeno samo kad je GLStats instaliran
+};
+
+// Meri CPU i GPU vreme svakog prolaza u frejmu.
+// GPU strana koristi GL_TIMESTAMP upite iz prstena od FRAMES_IN_FLIGHT frejmova;
+// rezultati se citaju tek kada su dostupni, tako da merenje nikad ne blokira pipeline.
+// Svaki prolaz se upisuje i kao zona u Tracer vremensku liniju.
+class PassTimer {
+public:
+    static const int FRAMES_IN_FLIGHT = 4;
+
+    PassTimer();
+    ~PassTimer();
+    PassTimer(const PassTimer&) = delete;
+    PassTimer& operator=(const PassTimer&) = delete;
+
+    void beginFrame();
+    void endFrame();
+
+    // name mora da zivi bar FRAMES_IN_FLIGHT frejmova (string literal)
+    void begin(const char* name);
+    void end();
+
+    // Poslednji razreseni frejm i prosek svih razresenih frejmova
+    const std::vector<PassTiming>& latest() const;
+    std::vector<PassTiming> average() const;
+    int resolvedFrameCount() const;
+    int droppedFrameCount() const;
+
+    void print(std::ostream& out, bool averaged) const;
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    struct PassSample {
+        const char* name;
+        Clock::time_point cpuStart;
+        int64_t traceStartNs;
+        double cpuMs;
+        GLCounters glStart;
+        GLCounters gl;
+        int queryIndex;     // Upiti queryIndex (pocetak) i queryIndex + 1 (kraj)
+    };
+
+    struct FrameSlot {
+        std::vector<GLuint> queries;
+        std::vector<PassSample> samples;
+        int usedQueries = 0;
+        bool pending = false;
+    };
+
+    FrameSlot slots[FRAMES_IN_FLIGHT];
+    int currentSlot;
+    std::vector<int> openPasses;        // Indeksi otvorenih prolaza (dozvoljeno gnezdenje)
+
+    std::vector<PassTiming> latestTimings;
+    std::vector<PassTiming> totalTimings;
+    int resolvedFrames;
+    int droppedFrames;
+
+    int nextQuery(FrameSlot& slot);
+    bool resolve(FrameSlot& slot);
+};
+
+// RAII pomocnik: { PassScope pass(timer, "Sun::Draw"); sun.Draw(...); }
+class PassScope {
+private:
+    PassTimer& timer;
+
+public:
+    PassScope(PassTimer& timer, const char* name) : timer(timer) { timer.begin(name); }
+    ~PassScope() { timer.end(); }
+    PassScope(const PassScope&) = delete;
+    PassScope& operator=(const PassScope&) = delete;
+};
+
+#endif // PASS_TIMER_H
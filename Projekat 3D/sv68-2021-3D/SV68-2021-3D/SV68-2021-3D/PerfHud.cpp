@@ -0,0 +1,377 @@
+#include "PerfHud.h"
+#include "AssetPack.h"
+#include "GpuMemory.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+namespace {
+
+const int ATLAS_WIDTH = 256;
+const int WHITE_BLOCK = 4;          // Beli blok u uglu atlasa (uzorkuje se centar, bez mesanja sa glifovima)
+const int FIRST_GLYPH = 32;
+const int LAST_GLYPH = 126;
+
+const float MARGIN = 10.0f;         // Od gornjeg levog ugla ekrana
+const float PADDING = 8.0f;         // Unutar panela
+const float SPARK_HEIGHT = 40.0f;
+const float SPARK_BAR_WIDTH = 2.0f;
+const double SPARK_FULL_MS = 33.3;  // Traka pune visine = 30 FPS
+const double BUDGET_60_MS = 1000.0 / 60.0;
+const double BUDGET_30_MS = 1000.0 / 30.0;
+
+const GLubyte PANEL_COLOR[4] = { 0, 0, 0, 170 };
+const GLubyte TEXT_COLOR[4] = { 235, 235, 235, 255 };
+const GLubyte GUIDE_COLOR[4] = { 120, 120, 120, 255 };
+const GLubyte GOOD_COLOR[4] = { 90, 220, 90, 255 };
+const GLubyte SLOW_COLOR[4] = { 240, 200, 60, 255 };
+const GLubyte BAD_COLOR[4] = { 240, 70, 60, 255 };
+
+const GLubyte* budgetColor(double frameMs) {
+    if (frameMs <= BUDGET_60_MS) return GOOD_COLOR;
+    if (frameMs <= BUDGET_30_MS) return SLOW_COLOR;
+    return BAD_COLOR;
+}
+
+int nextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+std::string formatCount(long long value) {
+    char text[32];
+    if (value >= 1000000) std::snprintf(text, sizeof(text), "%.2fM", value / 1000000.0);
+    else if (value >= 10000) std::snprintf(text, sizeof(text), "%.1fk", value / 1000.0);
+    else std::snprintf(text, sizeof(text), "%lld", value);
+    return text;
+}
+
+std::string formatMB(long long bytes) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.1f MB", bytes / (1024.0 * 1024.0));
+    return text;
+}
+
+}
+
+PerfHud::PerfHud()
+    : whiteUV(0.0f), lineHeight(0.0f), ascender(0.0f),
+    program(0), atlasTexture(0), VAO(0), VBO(0), projectionLoc(-1), textColorLoc(-1), samplerLoc(-1),
+    vboCapacity(0), vertexCount(0), ready(false), visible(false), dirty(true),
+    windowStart(Clock::now()), windowFrames(0), displayedFrameMs(0.0), bucketStart(Clock::now()), bucketWorstMs(0.0),
+    sparkMs(SPARK_BARS, 0.0f), sparkHead(0), builtWidth(0), builtHeight(0) {
+    for (Glyph& glyph : glyphs) glyph = Glyph();
+}
+
+PerfHud::~PerfHud() {
+    if (!ready) return;
+    GpuMemory::release(GPU_TEXTURE, atlasTexture);
+    GpuMemory::release(GPU_BUFFER, VBO);
+    glDeleteTextures(1, &atlasTexture);
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+bool PerfHud::init(const char* fontPath, GLuint shaderProgram, int pixelSize) {
+    TRACE_SCOPE_DETAIL("PerfHud::init", fontPath);
+
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft)) {
+        std::cerr << "ERROR FREETYPE: Nije instanciran" << std::endl;
+        return false;
+    }
+
+    // FreeType cita font direktno iz assets.pak; bajtovi moraju da zive dok postoji face
+    AssetData font = AssetPack::load(fontPath);
+    FT_Face face;
+    if (font.empty() || FT_New_Memory_Face(ft, font.data(), (FT_Long)font.size(), 0, &face)) {
+        std::cerr << "ERROR FREETYPE: Nije ucitao font: " << fontPath << std::endl;
+        FT_Done_FreeType(ft);
+        return false;
+    }
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+
+    // Shelf pakovanje: glifovi se redjaju u redove fiksne sirine atlasa, 1 piksel razmaka
+    std::vector<unsigned char> atlas(ATLAS_WIDTH * ATLAS_WIDTH, 0);
+    for (int y = 0; y < WHITE_BLOCK; ++y) {
+        std::memset(&atlas[y * ATLAS_WIDTH], 255, WHITE_BLOCK);
+    }
+
+    int penX = WHITE_BLOCK + 1, penY = 0, rowHeight = WHITE_BLOCK;
+    std::vector<glm::ivec2> glyphOrigins(128, glm::ivec2(0));
+
+    for (int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c) {
+        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
+            std::cerr << "ERROR FREETYPE: Nije ucitao Glyph za karakter: " << (char)c << std::endl;
+            continue;
+        }
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        int width = (int)bitmap.width, rows = (int)bitmap.rows;
+
+        if (penX + width > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        if (penY + rows > ATLAS_WIDTH) {
+            std::cerr << "PerfHud: atlas je premali za font velicine " << pixelSize << std::endl;
+            break;
+        }
+
+        for (int row = 0; row < rows; ++row) {
+            std::memcpy(&atlas[(penY + row) * ATLAS_WIDTH + penX], bitmap.buffer + row * bitmap.pitch, width);
+        }
+
+        Glyph& glyph = glyphs[c];
+        glyph.size = glm::vec2(width, rows);
+        glyph.bearing = glm::vec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        glyph.advance = face->glyph->advance.x / 64.0f;
+        glyphOrigins[c] = glm::ivec2(penX, penY);
+
+        penX += width + 1;
+        rowHeight = std::max(rowHeight, rows);
+    }
+
+    lineHeight = face->size->metrics.height / 64.0f;
+    ascender = face->size->metrics.ascender / 64.0f;
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    // Visina atlasa je samo onoliko koliko redovi zauzimaju
+    int atlasHeight = nextPowerOfTwo(penY + rowHeight + 1);
+    for (int c = FIRST_GLYPH; c <= LAST_GLYPH; ++c) {
+        Glyph& glyph = glyphs[c];
+        glyph.uvMin = glm::vec2(glyphOrigins[c]) / glm::vec2(ATLAS_WIDTH, atlasHeight);
+        glyph.uvMax = (glm::vec2(glyphOrigins[c]) + glyph.size) / glm::vec2(ATLAS_WIDTH, atlasHeight);
+    }
+    whiteUV = glm::vec2(WHITE_BLOCK * 0.5f) / glm::vec2(ATLAS_WIDTH, atlasHeight);
+
+    glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GpuMemory::track(GPU_TEXTURE, atlasTexture, GpuMemory::imageBytes(ATLAS_WIDTH, atlasHeight, 1, false), "PerfHud atlas", GPU_MEMORY_SITE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);     // Glifovi su na celim pikselima
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(HudVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HudVertex), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Lokacije se traze jednom; sampler i boja se ne menjaju
+    program = shaderProgram;
+    projectionLoc = glGetUniformLocation(program, "projection");
+    textColorLoc = glGetUniformLocation(program, "textColor");
+    samplerLoc = glGetUniformLocation(program, "text");
+    glUseProgram(program);
+    glUniform1i(samplerLoc, 0);
+    glUniform3f(textColorLoc, 1.0f, 1.0f, 1.0f);
+
+    ready = true;
+    dirty = true;
+    return true;
+}
+
+void PerfHud::setVisible(bool isVisible) {
+    visible = isVisible;
+}
+
+bool PerfHud::isVisible() const {
+    return visible;
+}
+
+void PerfHud::addFrame(const HudFrameStats& stats) {
+    Clock::time_point now = Clock::now();
+
+    windowSum.frameMs += stats.frameMs;
+    windowSum.cpuMs += stats.cpuMs;
+    windowSum.gpuMs += stats.gpuMs;
+    windowSum.drawCalls += stats.drawCalls;
+    windowSum.triangles += stats.triangles;
+    windowFrames++;
+    lastStats = stats;
+
+    bucketWorstMs = std::max(bucketWorstMs, stats.frameMs);
+    if (std::chrono::duration<double>(now - bucketStart).count() >= SPARK_BUCKET_SECONDS) {
+        sparkMs[sparkHead] = (float)bucketWorstMs;
+        sparkHead = (sparkHead + 1) % SPARK_BARS;
+        bucketWorstMs = 0.0;
+        bucketStart = now;
+        dirty = true;
+    }
+
+    if (std::chrono::duration<double>(now - windowStart).count() < REFRESH_SECONDS) return;
+
+    double frameMs = windowSum.frameMs / windowFrames;
+    char text[128];
+    std::vector<std::string> newLines;
+
+    std::snprintf(text, sizeof(text), "FPS %.1f   frame %.2f ms", frameMs > 0.0 ? 1000.0 / frameMs : 0.0, frameMs);
+    newLines.push_back(text);
+    std::snprintf(text, sizeof(text), "CPU %.2f ms   GPU %.2f ms", windowSum.cpuMs / windowFrames, windowSum.gpuMs / windowFrames);
+    newLines.push_back(text);
+    if (lastStats.haveGLCounters) {
+        newLines.push_back("draws " + formatCount(windowSum.drawCalls / windowFrames)
+            + "   tris " + formatCount(windowSum.triangles / windowFrames));
+    }
+    else {
+        newLines.push_back("draws -   tris -   (GL counters off)");
+    }
+    std::string memoryLine = "tex " + formatMB(lastStats.textureBytes) + "   buf " + formatMB(lastStats.bufferBytes);
+    if (lastStats.suspectedLeaks > 0) memoryLine += "   LEAK? " + std::to_string(lastStats.suspectedLeaks);
+    newLines.push_back(memoryLine);
+
+    if (newLines != lines) {
+        lines.swap(newLines);
+        displayedFrameMs = frameMs;
+        dirty = true;
+    }
+
+    windowSum = HudFrameStats();
+    windowFrames = 0;
+    windowStart = now;
+}
+
+float PerfHud::measureText(const std::string& text) const {
+    float width = 0.0f;
+    for (char c : text) {
+        if (c >= FIRST_GLYPH && c <= LAST_GLYPH) width += glyphs[(int)c].advance;
+    }
+    return width;
+}
+
+void PerfHud::addQuad(float x0, float y0, float x1, float y1, glm::vec2 uv0, glm::vec2 uv1, const GLubyte color[4]) {
+    const HudVertex corners[4] = {
+        { x0, y0, uv0.x, uv0.y, color[0], color[1], color[2], color[3] },
+        { x1, y0, uv1.x, uv0.y, color[0], color[1], color[2], color[3] },
+        { x1, y1, uv1.x, uv1.y, color[0], color[1], color[2], color[3] },
+        { x0, y1, uv0.x, uv1.y, color[0], color[1], color[2], color[3] },
+    };
+    vertices.push_back(corners[0]);
+    vertices.push_back(corners[1]);
+    vertices.push_back(corners[2]);
+    vertices.push_back(corners[0]);
+    vertices.push_back(corners[2]);
+    vertices.push_back(corners[3]);
+}
+
+float PerfHud::addText(const std::string& text, float x, float baseline, const GLubyte color[4]) {
+    for (char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) continue;
+        const Glyph& glyph = glyphs[(int)c];
+
+        if (glyph.size.x > 0.0f && glyph.size.y > 0.0f) {
+            float left = std::floor(x + glyph.bearing.x);
+            float top = baseline + glyph.bearing.y;
+            // Red 0 bitmape je vrh glifa, pa je donja ivica quad-a na uvMax.y
+            addQuad(left, top - glyph.size.y, left + glyph.size.x, top,
+                glm::vec2(glyph.uvMin.x, glyph.uvMax.y), glm::vec2(glyph.uvMax.x, glyph.uvMin.y), color);
+        }
+        x += glyph.advance;
+    }
+    return x;
+}
+
+void PerfHud::rebuild(int screenWidth, int screenHeight) {
+    TRACE_SCOPE("PerfHud::rebuild");
+
+    vertices.clear();
+
+    float textWidth = 0.0f;
+    for (const std::string& line : lines) textWidth = std::max(textWidth, measureText(line));
+    float sparkWidth = SPARK_BARS * SPARK_BAR_WIDTH;
+    float panelWidth = std::max(textWidth, sparkWidth) + 2.0f * PADDING;
+    float panelHeight = lines.size() * lineHeight + SPARK_HEIGHT + 3.0f * PADDING;
+
+    // Ortho projekcija ima y nagore, HUD je u gornjem levom uglu
+    float left = MARGIN;
+    float top = screenHeight - MARGIN;
+    addQuad(left, top - panelHeight, left + panelWidth, top, whiteUV, whiteUV, PANEL_COLOR);
+
+    float baseline = top - PADDING - ascender;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        addText(lines[i], left + PADDING, std::floor(baseline), i == 0 ? budgetColor(displayedFrameMs) : TEXT_COLOR);
+        baseline -= lineHeight;
+    }
+
+    // Sparkline: najstarija traka levo; linije za 60 i 30 FPS
+    float sparkBottom = top - panelHeight + PADDING;
+    float sparkLeft = left + PADDING;
+    float pixelsPerMs = SPARK_HEIGHT / (float)SPARK_FULL_MS;
+    float guide60 = std::floor(sparkBottom + (float)BUDGET_60_MS * pixelsPerMs);
+    addQuad(sparkLeft, guide60, sparkLeft + sparkWidth, guide60 + 1.0f, whiteUV, whiteUV, GUIDE_COLOR);
+    addQuad(sparkLeft, sparkBottom + SPARK_HEIGHT - 1.0f, sparkLeft + sparkWidth, sparkBottom + SPARK_HEIGHT, whiteUV, whiteUV, GUIDE_COLOR);
+
+    for (int i = 0; i < SPARK_BARS; ++i) {
+        float ms = sparkMs[(sparkHead + i) % SPARK_BARS];
+        if (ms <= 0.0f) continue;
+        float height = std::min(SPARK_HEIGHT, std::max(1.0f, ms * pixelsPerMs));
+        float x = sparkLeft + i * SPARK_BAR_WIDTH;
+        addQuad(x, sparkBottom, x + SPARK_BAR_WIDTH, sparkBottom + height, whiteUV, whiteUV, budgetColor(ms));
+    }
+
+    // Bafer raste samo kada je potrebno; inace se prepisuje postojeci
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (vertices.size() > vboCapacity) {
+        vboCapacity = vertices.size() * 2;
+        glBufferData(GL_ARRAY_BUFFER, vboCapacity * sizeof(HudVertex), nullptr, GL_DYNAMIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, vboCapacity * sizeof(HudVertex), "PerfHud vertices", GPU_MEMORY_SITE);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(HudVertex), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    vertexCount = (GLsizei)vertices.size();
+
+    if (screenWidth != builtWidth || screenHeight != builtHeight) {
+        glm::mat4 projection = glm::ortho(0.0f, (float)screenWidth, 0.0f, (float)screenHeight);
+        glUseProgram(program);
+        glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        builtWidth = screenWidth;
+        builtHeight = screenHeight;
+    }
+    dirty = false;
+}
+
+void PerfHud::Draw(int screenWidth, int screenHeight, GLenum polygonMode) {
+    if (!ready || !visible || lines.empty()) return;
+
+    if (dirty || screenWidth != builtWidth || screenHeight != builtHeight) {
+        rebuild(screenWidth, screenHeight);
+    }
+
+    // Blend je ukljucen globalno (configureRenderState); HUD ide preko scene bez dubine
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    if (polygonMode != GL_FILL) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    glUseProgram(program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    glBindVertexArray(0);
+
+    if (polygonMode != GL_FILL) glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+    glEnable(GL_CULL_FACE);
+    glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,102 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <glm/glm.hpp>
+
+// Vrednosti jednog frejma koje HUD prikazuje
+struct HudFrameStats {
+    double frameMs = 0.0;           // Vreme izmedju frejmova (deltaTime)
+    double cpuMs = 0.0;             // CPU vreme pripreme frejma (bez swap-a)
+    double gpuMs = 0.0;             // Zbir GPU vremena prolaza iz PassTimer-a
+    bool haveGLCounters = false;    // GLStats instaliran: draw pozivi i trouglovi
+    long long drawCalls = 0;
+    long long triangles = 0;
+    long long textureBytes = 0;     // Zivi bajtovi iz GpuMemory (rade i bez GLStats)
+    long long bufferBytes = 0;
+    int suspectedLeaks = 0;
+};
+
+// Performansni overlay: FPS, CPU/GPU ms, draw pozivi, trouglovi, memorija i sparkline vremena frejma.
+// Svi glifi su u jednom R8 atlasu (FreeType, ASCII 32-126) sa belim blokom za pune pravougaonike,
+// pa se ceo HUD crta jednim glDrawArrays pozivom. Prikazane vrednosti su proseci prozora od
+// REFRESH_SECONDS; verteksi se prave i salju na GPU samo kada se tekst ili sparkline promene.
+class PerfHud {
+public:
+    static constexpr double REFRESH_SECONDS = 0.25;
+    static constexpr double SPARK_BUCKET_SECONDS = 0.1;    // Jedna traka = najgori frejm u 100 ms
+    static const int SPARK_BARS = 100;
+
+    PerfHud();
+    ~PerfHud();
+    PerfHud(const PerfHud&) = delete;
+    PerfHud& operator=(const PerfHud&) = delete;
+
+    // program = text.vert/text.frag; false ako font ne moze da se ucita
+    bool init(const char* fontPath, GLuint program, int pixelSize = 16);
+
+    void setVisible(bool visible);
+    bool isVisible() const;
+
+    // Poziva se svakog frejma (i kada je HUD skriven, da istorija bude puna kad se prikaze)
+    void addFrame(const HudFrameStats& stats);
+
+    // Menja blend/depth/cull/polygon stanje i vraca ga; polygonMode je rezim scene (GL_FILL/GL_LINE/GL_POINT)
+    void Draw(int screenWidth, int screenHeight, GLenum polygonMode);
+
+private:
+    struct Glyph {
+        glm::vec2 size;         // Pikseli
+        glm::vec2 bearing;
+        float advance;
+        glm::vec2 uvMin, uvMax;
+    };
+
+    struct HudVertex {
+        float x, y, u, v;
+        GLubyte r, g, b, a;
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    Glyph glyphs[128];
+    glm::vec2 whiteUV;          // Centar belog bloka u atlasu
+    float lineHeight;
+    float ascender;
+
+    GLuint program, atlasTexture, VAO, VBO;
+    GLint projectionLoc, textColorLoc, samplerLoc;
+    size_t vboCapacity;         // U verteksima
+    GLsizei vertexCount;
+    bool ready;
+    bool visible;
+    bool dirty;
+
+    // Prozor za proseke prikazanih vrednosti
+    Clock::time_point windowStart;
+    int windowFrames;
+    HudFrameStats windowSum;
+    HudFrameStats lastStats;
+    double displayedFrameMs;    // Boja FPS reda (60 / 30 FPS granice)
+
+    // Sparkline: najgori frejm u svakom SPARK_BUCKET_SECONDS, prsten od SPARK_BARS traka
+    Clock::time_point bucketStart;
+    double bucketWorstMs;
+    std::vector<float> sparkMs;
+    int sparkHead;
+
+    std::vector<std::string> lines;
+    std::vector<HudVertex> vertices;
+    int builtWidth, builtHeight;    // Velicina ekrana za koju su napravljeni verteksi i projekcija
+
+    void rebuild(int screenWidth, int screenHeight);
+    void addQuad(float x0, float y0, float x1, float y1, glm::vec2 uv0, glm::vec2 uv1, const GLubyte color[4]);
+    float addText(const std::string& text, float x, float baseline, const GLubyte color[4]);
+    float measureText(const std::string& text) const;
+};
+
+#endif // PERF_HUD_H
@@ -3,17 +3,20 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <memory>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "TextureArrays.h"
+#include "MeshRegistry.h"
+#include "OrbitRenderer.h"
+#include "SurfaceTerrain.h"
 
 class Planet {
 private:
-    std::vector<float> sphere_vertices;
-    std::vector<int> sphere_indices;
-    GLuint VBO, VAO, EBO;
+    SphereLodChain lods;        // Jedinicne sfere po nivou detalja (MeshRegistry), bira se po velicini na ekranu
     float radius;
     int sectorCount;
     int stackCount;
@@ -23,30 +26,23 @@ private:
     float orbitSpeed; // Brzina orbite
     float distanceFromSun; // Udaljenost od Sunca
     glm::vec3 orbitAxis = glm::vec3(0.0f, 1.0f, 0.0f); // Osa orbite (oko Y ose)
-
-    void generateVertices();
-    void generateIndices();
-    void setupMesh();
-
-    std::vector<glm::vec3> orbit_vertices; // Tačke za orbitu
-    GLuint orbitVAO, orbitVBO; // OpenGL resursi za orbitu
     float eccentricity;
-
-    void generateOrbit(); // Generisanje tačaka orbite
-    void setupOrbitMesh(); // Postavljanje OpenGL bafera
+    SurfaceTerrain* terrain = nullptr;  // Povrsina izbliza (--terrain); nullptr = uvek sfera
+    int terrainBody = -1;
 
 public:
     Planet(float r, int sectors, int stacks, float rotSpeed, float orbSpeed, float distance, float ecc);
-    ~Planet();
-
-    void DrawOrbit(GLuint shaderProgram, const glm::mat4& view, const glm::mat4& projection); // Crtanje orbite
 
+    // Elementi orbite oko Sunca za OrbitRenderer (tacke orbite racuna orbit.vert)
+    OrbitInstance getOrbit(const glm::vec3& color) const;
 
     glm::vec3 getPosition();
 
     float getRadius() const;
+    void setOrbitAngle(float degrees); // Pocetna faza orbite (stres scena)
+    void setTerrain(SurfaceTerrain* surface, int body);    // body iz SurfaceTerrain::addBody
 
-    void Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, const glm::mat4& projection, float deltaTime, glm::vec3 cameraPos, float speedMultiplier);
+    void Draw(GLuint shaderProgram, const TextureLayer& texture, const glm::mat4& view, const glm::mat4& projection, float deltaTime, glm::vec3 cameraPos, float speedMultiplier);
 };
 
 #endif // PLANET_H
@@ -0,0 +1,167 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+#include "RingLod.h"
+#include "Frustum.h"
+
+namespace {
+
+const float RING_COVERAGE = 0.5f;           // Deo povrsine prstena koji pokrivaju sve stene zajedno
+const float ROCK_SIZE_SPREAD = 0.5f;        // Poluprecnik stene je srednji * [1 - spread, 1 + spread)
+const float SWITCH_ELEVATION_DEGREES = 20.0f;
+const float SWITCH_DISTANCE_STEP = 1.1f;
+const float NEAREST_SECTOR_DISTANCE = 0.01f;
+
+int sectorOf(float x, float z) {
+    float angle = std::atan2(z, x);
+    if (angle < 0.0f) angle += 2.0f * (float)M_PI;
+    int sector = (int)(angle / (2.0f * (float)M_PI) * RING_SECTORS);
+    return std::min(sector, RING_SECTORS - 1);
+}
+
+// Najdalja tacka sektora od njegovog sredisnjeg poluprecnika, plus debljina
+float sectorBoundingRadius(float innerRadius, float outerRadius) {
+    float halfAngle = (float)M_PI / RING_SECTORS;
+    float middle = 0.5f * (innerRadius + outerRadius);
+    glm::vec2 corner(std::cos(halfAngle), std::sin(halfAngle));
+    float outer = glm::length(corner * outerRadius - glm::vec2(middle, 0.0f));
+    float inner = glm::length(corner * innerRadius - glm::vec2(middle, 0.0f));
+    return std::max(outer, inner) + RING_HALF_THICKNESS;
+}
+
+// Udaljenost na kojoj srednja stena ima RING_ROCK_MIN_PIXELS; dalje se sektori proredjuju
+float fullDensityDistance(const RingParticles& ring, float pixelsPerUnit) {
+    return ring.rockRadius * pixelsPerUnit / RING_ROCK_MIN_PIXELS;
+}
+
+}
+
+void ringDensityProfile(const unsigned char* rgba, int width, int height, std::vector<float>& profile) {
+    profile.assign(width, 0.0f);
+    if (height <= 0) return;
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* row = rgba + (size_t)y * width * 4;
+        for (int x = 0; x < width; ++x) profile[x] += row[x * 4 + 3];
+    }
+    for (float& value : profile) value /= 255.0f * height;
+}
+
+void generateRingParticles(int count, float innerRadius, float outerRadius, const std::vector<float>& profile,
+    unsigned int seed, RingParticles& out) {
+    std::random_device rd;
+    std::mt19937 gen(seed != 0 ? seed : rd());
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Kumulativna tezina po koloni profila; povrsina pojasa raste sa poluprecnikom
+    int bins = (int)profile.size();
+    std::vector<double> cumulative(bins);
+    double total = 0.0;
+    for (int i = 0; i < bins; ++i) {
+        float radius = innerRadius + (outerRadius - innerRadius) * (i + 0.5f) / bins;
+        total += profile[i] * radius;
+        cumulative[i] = total;
+    }
+
+    // E[(1 - s + 2su)^2] = 1 + s^2 / 3 za ravnomerno u
+    float meanSquare = 1.0f + ROCK_SIZE_SPREAD * ROCK_SIZE_SPREAD / 3.0f;
+    float area = (float)M_PI * (outerRadius * outerRadius - innerRadius * innerRadius);
+    out.rockRadius = count > 0 ? std::sqrt(RING_COVERAGE * area / ((float)M_PI * count * meanSquare)) : 0.0f;
+
+    std::vector<glm::vec4> generated;
+    generated.reserve(count);
+    int counts[RING_SECTORS] = {};
+
+    for (int i = 0; i < count; ++i) {
+        float radius;
+        if (total > 0.0) {
+            double target = unit(gen) * total;
+            int bin = (int)(std::upper_bound(cumulative.begin(), cumulative.end(), target) - cumulative.begin());
+            bin = std::min(bin, bins - 1);
+            radius = innerRadius + (outerRadius - innerRadius) * (bin + unit(gen)) / bins;
+        }
+        else {
+            // Ravnomerno po povrsini
+            float inner2 = innerRadius * innerRadius;
+            radius = std::sqrt(inner2 + unit(gen) * (outerRadius * outerRadius - inner2));
+        }
+        float angle = unit(gen) * 2.0f * (float)M_PI;
+        float height = (unit(gen) * 2.0f - 1.0f) * RING_HALF_THICKNESS;
+        float size = out.rockRadius * (1.0f - ROCK_SIZE_SPREAD + 2.0f * ROCK_SIZE_SPREAD * unit(gen));
+
+        glm::vec4 particle(radius * std::cos(angle), height, radius * std::sin(angle), size);
+        ++counts[sectorOf(particle.x, particle.z)];
+        generated.push_back(particle);
+    }
+
+    // Razvrstavanje po sektoru cuva redosled generisanja unutar sektora
+    out.sectorOffsets[0] = 0;
+    for (int s = 0; s < RING_SECTORS; ++s) out.sectorOffsets[s + 1] = out.sectorOffsets[s] + counts[s];
+    int next[RING_SECTORS];
+    std::copy(out.sectorOffsets, out.sectorOffsets + RING_SECTORS, next);
+
+    out.particles.resize(count);
+    for (const glm::vec4& particle : generated) out.particles[next[sectorOf(particle.x, particle.z)]++] = particle;
+}
+
+int selectRingParticles(const RingParticles& ring, float innerRadius, float outerRadius, const glm::vec3& center,
+    const glm::vec3& cameraPos, const glm::mat4& viewProjection, float pixelsPerUnit, std::vector<RingDraw>& draws) {
+    draws.clear();
+
+    Frustum frustum(viewProjection);
+    float boundingRadius = sectorBoundingRadius(innerRadius, outerRadius);
+    float middle = 0.5f * (innerRadius + outerRadius);
+    float fullDistance = fullDensityDistance(ring, pixelsPerUnit);
+
+    int total = 0;
+    for (int s = 0; s < RING_SECTORS; ++s) {
+        int available = ring.sectorOffsets[s + 1] - ring.sectorOffsets[s];
+        if (available == 0) continue;
+
+        float angle = (s + 0.5f) * 2.0f * (float)M_PI / RING_SECTORS;
+        glm::vec3 sectorCenter = center + glm::vec3(std::cos(angle) * middle, 0.0f, std::sin(angle) * middle);
+        if (!frustum.intersectsSphere(sectorCenter, boundingRadius)) continue;
+
+        // Gustina po najblizoj tacki sektora, da se bliza ivica ne proredi previse
+        float distance = std::max(glm::length(sectorCenter - cameraPos) - boundingRadius, NEAREST_SECTOR_DISTANCE);
+        float density = std::min(1.0f, (fullDistance / distance) * (fullDistance / distance));
+        int count = density >= 1.0f ? available : std::max(1, (int)std::ceil(available * density));
+        total += count;
+
+        if (count == available && !draws.empty() && draws.back().sizeScale == 1.0f
+            && draws.back().first + draws.back().count == ring.sectorOffsets[s]) {
+            draws.back().count += count;
+            continue;
+        }
+        RingDraw draw = { ring.sectorOffsets[s], count, count == available ? 1.0f : std::sqrt((float)available / count) };
+        draws.push_back(draw);
+    }
+    return total;
+}
+
+double ringParticleCostMs(const RingCostModel& model, int rocks) {
+    return model.particleFixedMs + model.particleMsPerRock * rocks;
+}
+
+float ringSwitchDistance(const RingCostModel& model, const RingParticles& ring, float innerRadius, float outerRadius,
+    const glm::mat4& projection, float pixelsPerUnit) {
+    float qualityDistance = fullDensityDistance(ring, pixelsPerUnit) / std::sqrt(RING_MIN_DENSITY);
+    double limitMs = model.stripMs + RING_PARTICLE_BUDGET_MS;
+
+    float elevation = glm::radians(SWITCH_ELEVATION_DEGREES);
+    glm::vec3 direction(0.0f, std::sin(elevation), std::cos(elevation));
+    std::vector<RingDraw> draws;
+
+    // Od spoljasnje ivice prstena nadalje, dok model ne predje budzet ili stene ne postanu presitne
+    float accepted = 0.0f;
+    for (float distance = outerRadius * SWITCH_DISTANCE_STEP; ; distance *= SWITCH_DISTANCE_STEP) {
+        float probe = std::min(distance, qualityDistance);
+        glm::vec3 cameraPos = direction * probe;
+        glm::mat4 view = glm::lookAt(cameraPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        int rocks = selectRingParticles(ring, innerRadius, outerRadius, glm::vec3(0.0f), cameraPos, projection * view, pixelsPerUnit, draws);
+        if (ringParticleCostMs(model, rocks) > limitMs) return accepted;
+        accepted = probe;
+        if (probe >= qualityDistance) return accepted;
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef RING_LOD_H
+#define RING_LOD_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+// Saturnov prsten kao instancirane stene, bez OpenGL poziva - koristi ga SaturnRing u rezimu cestica
+
+// Cestice su grupisane po ugaonim sektorima; sektor van kadra se ne crta
+const int RING_SECTORS = 64;
+
+// Stena manja od ovoga na ekranu se ne crta pojedinacno: sektor se proredjuje, a preostale stene
+// se uvecavaju tako da prstenu ostane ista pokrivenost (gustina ~ 1 / udaljenost^2)
+const float RING_ROCK_MIN_PIXELS = 1.0f;
+
+// Prorediti vise od ovoga nema smisla - tada je traka iste slike i mnogo jeftinija
+const float RING_MIN_DENSITY = 1.0f / 16.0f;
+
+// Koliko GPU vremena cestice smeju da kostaju preko trake, u ms po frejmu
+const float RING_PARTICLE_BUDGET_MS = 1.0f;
+
+// Pojas oko udaljenosti prelaska u kome rezim ostaje isti (0.1 = +-10%)
+const float RING_SWITCH_HYSTERESIS = 0.1f;
+
+const float RING_HALF_THICKNESS = 0.005f;      // Rasipanje stena po Y osi
+
+// Stene u XZ ravni oko centra prstena; u svakom sektoru su nasumicnim redom, pa je svaki
+// pocetni deo sektora ravnomeran uzorak celog sektora
+struct RingParticles {
+    std::vector<glm::vec4> particles;       // xyz = pozicija u odnosu na Saturn, w = poluprecnik stene
+    int sectorOffsets[RING_SECTORS + 1];    // Sektor s su cestice [sectorOffsets[s], sectorOffsets[s + 1])
+    float rockRadius;                       // Srednji poluprecnik stene
+};
+
+// Jedan instancirani poziv: count cestica od first, poluprecnik pomnozen sa sizeScale
+struct RingDraw {
+    int first;
+    int count;
+    float sizeScale;
+};
+
+// Izmereno pri pokretanju (SaturnRing::calibrate): cestice kostaju fixedMs + msPerRock po steni
+struct RingCostModel {
+    double stripMs;
+    double particleFixedMs;
+    double particleMsPerRock;
+};
+
+// Gustina prstena po poluprecniku iz teksture trake (x = od unutrasnje do spoljasnje ivice):
+// srednja alfa kolone, jedna vrednost po koloni
+void ringDensityProfile(const unsigned char* rgba, int width, int height, std::vector<float>& profile);
+
+// count stena rasporedjenih po profilu (po povrsini, pa spoljasnji delovi dobijaju vise); prazan
+// profil = ravnomerno. Stene zajedno pokrivaju oko pola povrsine prstena, pa su sitnije sto ih je vise.
+// seed 0 = nasumican raspored (random_device)
+void generateRingParticles(int count, float innerRadius, float outerRadius, const std::vector<float>& profile,
+    unsigned int seed, RingParticles& out);
+
+// Pozivi za jedan frejm: sektori u kadru, svaki proredjen po udaljenosti od kamere. Susedni sektori
+// pune gustine spajaju se u jedan poziv. pixelsPerUnit = projection[1][1] * visina viewport-a / 2.
+// Vraca ukupan broj stena
+int selectRingParticles(const RingParticles& ring, float innerRadius, float outerRadius, const glm::vec3& center,
+    const glm::vec3& cameraPos, const glm::mat4& viewProjection, float pixelsPerUnit, std::vector<RingDraw>& draws);
+
+double ringParticleCostMs(const RingCostModel& model, int rocks);
+
+// Udaljenost kamere od Saturna ispod koje se crtaju cestice: najveca udaljenost na kojoj pogled na
+// Saturn (20 stepeni iznad prstena) ostaje u RING_PARTICLE_BUDGET_MS po modelu, a najvise dok
+// proredjivanje ne padne ispod RING_MIN_DENSITY. 0 = cestice se nikad ne isplate
+float ringSwitchDistance(const RingCostModel& model, const RingParticles& ring, float innerRadius, float outerRadius,
+    const glm::mat4& projection, float pixelsPerUnit);
+
+#endif // RING_LOD_H
@@ -9,6 +9,7 @@ double lastKeyPressTime = 0.0;
 float lastFrame = 0.0f;
 int screenWidth = 1600, screenHeight = 800;
 bool showOrbits = false;
+GLenum polygonMode = GL_FILL;
 
 glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 15.0f); // Kamera bliže pojasu
 glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
@@ -18,6 +19,7 @@ float yaw = -90.0f;
 float pitch = 0.0f;
 float lastX = 400, lastY = 300;
 float fov = 45.0f;
+const float DEFAULT_NEAR_PLANE = 0.1f;
 bool firstMouse = true;
 
 
@@ -55,7 +57,28 @@ void checkOpenGLError(const std::string& location) {
     }
 }
 
-GLFWwindow* initializeOpenGL(int width, int height, const char* title) {
+// Zajednicko GL stanje za interaktivni i headless rezim
+void configureRenderState() {
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+// glfwTerminate na izlasku iz main-a; deklarise se odmah posle prozora, pa se unistava poslednji i svi GL
+// objekti iz main-a (PassTimer, SurfaceTerrain, teksture...) brisu svoje resurse dok kontekst jos postoji
+struct GlfwSession {
+    GlfwSession() = default;
+    GlfwSession(const GlfwSession&) = delete;
+    GlfwSession& operator=(const GlfwSession&) = delete;
+    ~GlfwSession() { glfwTerminate(); }
+};
+
+GLFWwindow* initializeOpenGL(int width, int height, const char* title, bool countGLCalls) {
     if (!glfwInit()) {
         std::cerr << "GLFW initialization failed!" << std::endl;
         return nullptr;
@@ -79,39 +102,40 @@ GLFWwindow* initializeOpenGL(int width, int height, const char* title) {
     }
     checkOpenGLError("After glad init");
 
-
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+#ifdef _DEBUG
+    countGLCalls = true;    // Brojanje GL poziva po prolazu (T - ispis)
+#endif
+    if (countGLCalls) GLStats::install();
+    configureRenderState();
 
     return window;
 }
-// Funkcija za učitavanje šejdera
-std::string loadShaderSource(const char* filePath) {
-    std::ifstream file(filePath);
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+// Funkcija za učitavanje šejdera (iz assets.pak bez kopiranja, ili sa diska)
+AssetData loadShaderSource(const char* filePath) {
+    AssetData source = AssetPack::load(filePath);
+    if (source.empty()) {
+        std::cerr << "Nije pronadjen sejder: " << filePath << std::endl;
+    }
+    return source;
 }
-// Funkcija za kreiranje šejdera
-GLuint compileShader(GLenum shaderType, const char* source) {
+// Funkcija za kreiranje šejdera; izvor u paketu nema zavrsnu nulu, pa se duzina prosledjuje
+GLuint compileShader(GLenum shaderType, const AssetData& source) {
     GLuint shader = glCreateShader(shaderType);
-    glShaderSource(shader, 1, &source, nullptr);
+    const char* text = source.empty() ? "" : (const char*)source.data();
+    GLint length = (GLint)source.size();
+    glShaderSource(shader, 1, &text, &length);
     glCompileShader(shader);
     return shader;
 }
 
 GLuint createProgram(const char* vertexShaderPath, const char* fragmentShaderPath) {
-    std::string vertexSource = loadShaderSource(vertexShaderPath);
-    std::string fragmentSource = loadShaderSource(fragmentShaderPath);
+    TRACE_SCOPE_DETAIL("createProgram", vertexShaderPath);
+
+    AssetData vertexSource = loadShaderSource(vertexShaderPath);
+    AssetData fragmentSource = loadShaderSource(fragmentShaderPath);
 
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource.c_str());
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource.c_str());
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
 
     GLuint program = glCreateProgram();
 
@@ -148,8 +172,9 @@ glm::mat4 calculateCameraMatrix() {
     return glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
 }
 
-glm::mat4 calculateProjectionMatrix(int screenWidth, int screenHeight) {
-    return glm::perspective(glm::radians(fov), (float)screenWidth / (float)screenHeight, 0.1f, 100.0f);
+// nearPlane se smanjuje samo kad je kamera tik uz povrsinu tela (SurfaceTerrain::nearPlane)
+glm::mat4 calculateProjectionMatrix(int screenWidth, int screenHeight, float nearPlane = DEFAULT_NEAR_PLANE) {
+    return glm::perspective(glm::radians(fov), (float)screenWidth / (float)screenHeight, nearPlane, 100.0f);
 }
 
 
@@ -199,6 +224,32 @@ bool isOneClick(double& lastKeyPressTime) {
     return true;
 }
 
+// Stanje scene posle obrade ulaza - ono sto se snima za kasniji replay
+CameraFrame captureCameraFrame(float deltaTime) {
+    CameraFrame frame;
+    frame.position = cameraPos;
+    frame.front = cameraFront;
+    frame.fov = fov;
+    frame.speedMultiplier = speedMultiplier;
+    frame.deltaTime = deltaTime;
+    frame.showOrbits = showOrbits;
+    frame.polygonMode = polygonMode;
+    return frame;
+}
+
+// Zamena za processInput/mouse_callback tokom replay-a
+void applyCameraFrame(const CameraFrame& frame) {
+    cameraPos = frame.position;
+    cameraFront = frame.front;
+    fov = frame.fov;
+    speedMultiplier = frame.speedMultiplier;
+    showOrbits = frame.showOrbits;
+    if (frame.polygonMode != polygonMode) {
+        polygonMode = frame.polygonMode;
+        glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+    }
+}
+
 void processInput(GLFWwindow* window, float deltaTime) {
     float cameraSpeed = 2.5f * deltaTime;
 
@@ -251,14 +302,17 @@ void processInput(GLFWwindow* window, float deltaTime) {
     }
 
     if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
+        polygonMode = GL_FILL;
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);  // Standardno punjenje poligona
     }
 
     if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
+        polygonMode = GL_LINE;
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);  // Samo ivice
     }
 
     if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) {
+        polygonMode = GL_POINT;
         glPolygonMode(GL_FRONT_AND_BACK, GL_POINT); // Samo tjemena
     }
 }
@@ -266,6 +320,8 @@ void processInput(GLFWwindow* window, float deltaTime) {
 
 // Funkcija za učitavanje teksture
 GLuint loadTexture(const char* filePath) {
+    TRACE_SCOPE_DETAIL("loadTexture", filePath);
+
     GLuint textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
@@ -276,16 +332,32 @@ GLuint loadTexture(const char* filePath) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
+    // Blok-kompresovana verzija (SV68-2021-TexConvert), vec okrenuta i sa mipmapama
+    CompressedImage compressed;
+    std::string ddsPath = compressedPathFor(filePath);
+    AssetData dds = AssetPack::load(ddsPath);
+    if (!dds.empty() && loadDdsFromMemory(dds.data(), dds.size(), ddsPath, compressed) && TextureStreamer::supportsCompressedFormat(compressed.format)) {
+        TextureStreamer::uploadCompressedLevels(GL_TEXTURE_2D, compressed, compressed.data.data());
+        GpuMemory::track(GPU_TEXTURE, textureID, (long long)compressed.data.size(), filePath, GPU_MEMORY_SITE);
+        return textureID;
+    }
+
     // Učitavanje slike
     stbi_set_flip_vertically_on_load(true); // Flipa teksturu ako je potrebno
     int width, height, nrChannels;
-    unsigned char* data = stbi_load(filePath, &width, &height, &nrChannels, 0);
+    unsigned char* data = nullptr;
+    {
+        TRACE_SCOPE("stbi_load");
+        AssetData file = AssetPack::load(filePath);
+        if (!file.empty()) data = stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &nrChannels, 0);
+    }
 
     if (data) {
         GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
 
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
+        GpuMemory::track(GPU_TEXTURE, textureID, GpuMemory::imageBytes(width, height, nrChannels == 4 ? 4 : 3, true), filePath, GPU_MEMORY_SITE);
 
         stbi_image_free(data);
 
@@ -299,75 +371,19 @@ GLuint loadTexture(const char* filePath) {
 
     return textureID;
 }
-//render fja za details prikaz planete
-void renderInfoBox(float x, float y, float width, float height, GLuint shaderProgram, const char* textureName) {
-    GLuint texture = loadTexture(textureName);
-
-    if (texture == 0) {
-        std::cerr << "Error: Nevalidni Texture ID" << std::endl;
-        return;
-    }
-
-    // Postavi ortografsku projekciju za prikazivanje informacija
-    glm::mat4 orthoProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(orthoProjection));
-
-
+//Kartica sa detaljima ide u UI batch (atlas stranica + UV); crta se sa ostatkom UI-ja u UiBatch::flush
+void renderInfoBox(float x, float y, float width, float height, UiBatch& uiBatch, UiAtlas& triviaAtlas, const std::string& name) {
     // Prilagodimo visinu i širinu da budu u NDC prostoru
-    width = width * 2.0f;
-    height = height * 2.0f;
-
-    // Verteksi za pravougaonik (prikazuje se u ekranskom prostoru)
-    float vertices[6][4] = {
-        {x, y, 0.0f, 1.0f},
-        {x, y - height, 0.0f, 0.0f},
-        {x + width, y - height, 1.0f, 0.0f},
-
-        {x, y, 0.0f, 1.0f},
-        {x + width, y - height, 1.0f, 0.0f},
-        {x + width, y, 1.0f, 1.0f}
-    };
-
-
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-
-    // Binduj teksturu
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    // Setuj uniform za teksturu
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
-
-    // Renderuj pravougaonik
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Očisti resurse
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    uiBatch.addQuad(x, y, width * 2.0f, height * 2.0f, triviaAtlas.find(name));
 }
 
-void shouldShowDetails(GLuint shaderProgram, Sun& sun, std::unordered_map<std::string, Moon*> moons, 
+void shouldShowDetails(UiBatch& uiBatch, UiAtlas& triviaAtlas, Sun& sun, std::unordered_map<std::string, Moon*> moons, 
     std::unordered_map<std::string, Planet*> planets, std::unordered_map<std::string, AsteroidBelt*> asteroids) {
 
     float minDistance = 0.2f;
 
     if (glm::distance(cameraPos, sun.getPosition()) < (sun.getRadius() + minDistance)) {
-        glDisable(GL_DEPTH_TEST);
-        renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, shaderProgram, "sun-trivia.png");
-        glEnable(GL_DEPTH_TEST);
+        renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, "sun");
         return;
     }
     
@@ -376,12 +392,7 @@ void shouldShowDetails(GLuint shaderProgram, Sun& sun, std::unordered_map<std::s
         Moon& moon = *pair.second;             
         
         if (glm::distance(cameraPos, moon.getPosition()) < (moon.getRadius() + minDistance)) {
-            std::string triviaPathStr = moonName + "-trivia.png";
-            const char* triviaPath = triviaPathStr.c_str();       
-
-            glDisable(GL_DEPTH_TEST);
-            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, shaderProgram, triviaPath);
-            glEnable(GL_DEPTH_TEST);
+            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, moonName);
             return;
         }
     }
@@ -391,12 +402,7 @@ void shouldShowDetails(GLuint shaderProgram, Sun& sun, std::unordered_map<std::s
         Planet& planet = *pair.second;             
         
         if (glm::distance(cameraPos, planet.getPosition()) < (planet.getRadius() + minDistance)) {
-            std::string triviaPathStr = planetName + "-trivia.png";
-            const char* triviaPath = triviaPathStr.c_str();       
-
-            glDisable(GL_DEPTH_TEST);
-            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, shaderProgram, triviaPath);
-            glEnable(GL_DEPTH_TEST);
+            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, planetName);
             return;
         }
     }
@@ -406,61 +412,106 @@ void shouldShowDetails(GLuint shaderProgram, Sun& sun, std::unordered_map<std::s
         AsteroidBelt& belt = *pair.second;             
 
         if (belt.isInsideBelt(cameraPos)) {
-            std::string triviaPathStr = beltName + "-trivia.png";
-            const char* triviaPath = triviaPathStr.c_str();       
-
-            glDisable(GL_DEPTH_TEST);
-            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, shaderProgram, triviaPath);
-            glEnable(GL_DEPTH_TEST);
+            renderInfoBox(-0.95f, 0.9f, 0.4f, 0.2f, uiBatch, triviaAtlas, beltName);
             return;
         }
     }
 }
 
-void drawOrbits(std::unordered_map<std::string, Planet*> planets, GLuint shaderProgram, glm::mat4 viewMatrix, glm::mat4 projectionMatrix) {
-    for (const auto& pair : planets) {
-        Planet& planet = *pair.second;
-        planet.DrawOrbit(shaderProgram, viewMatrix, projectionMatrix);
+// GpuMemory izvestaj; sa GLStats se vidi i koliko GPU memorije je alocirano mimo evidencije
+void printGpuMemoryReport(std::ostream& out) {
+    GpuMemory::printReport(out);
+    if (GLStats::isInstalled()) {
+        out << "untracked (GLStats - GpuMemory): textures " << (GLStats::textureBytes() - GpuMemory::liveBytes(GPU_TEXTURE)) / 1024
+            << " KB, buffers " << (GLStats::bufferBytes() - GpuMemory::liveBytes(GPU_BUFFER)) / 1024 << " KB" << std::endl;
     }
 }
 
-GLuint loadCubemap() {
+// Stranice neba redom +X, -X, +Y, -Y, +Z, -Z; dekodiraju se u pozadini kao i ostale teksture
+GLuint loadCubemap(TextureStreamer& streamer) {
     std::vector<std::string> pictures = { "bkg1_back.png", "bkg1_bot.png", "bkg1_front.png", "bkg1_left.png", "bkg1_right.png", "bkg1_top.png" };
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    return streamer.loadCubemap(pictures);
+}
 
-    int width, height, nrChannels;
-    for (unsigned int i = 0; i < pictures.size(); i++) {
-        unsigned char* data = stbi_load(pictures[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data) {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
-        }
-        else {
-            std::cerr << "Failed to load cubemap texture: " << pictures[i] << std::endl;
-            stbi_image_free(data);
-        }
-    }
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+int main(int argc, char** argv) {
+    Tracer::setThreadName("main");
+    AssetPack::openDefault();       // Bez paketa se svi asseti citaju kao pojedinacni fajlovi
 
-    return textureID;
-}
+#ifdef HEADLESS_BENCHMARK
+    BenchmarkOptions benchmark = parseBenchmarkArgs(argc, argv);
+    screenWidth = benchmark.width;
+    screenHeight = benchmark.height;
+    if (benchmark.imageCache) ImageCache::setDirectory(AssetPack::executableDirectory() + ImageCache::DEFAULT_DIRECTORY);
+    int ringParticles = benchmark.ringParticles;
+    bool terrainEnabled = benchmark.terrain;
+    float terrainHeight = benchmark.terrainHeight;
+    long long triviaBudget = benchmark.triviaBudgetBytes;
 
+    GLFWwindow* window = initializeHeadlessOpenGL(screenWidth, screenHeight);
+    if (!window) return -1;
+    GlfwSession glfwSession;
+    if (benchmark.glStats) GLStats::install();
+    configureRenderState();
+
+    OffscreenTarget offscreen(screenWidth, screenHeight);
+    SphereLodChain::setViewportHeight(screenHeight);
+
+    CameraReplay cameraReplay;
+    unsigned int asteroidSeed = FIXED_ASTEROID_SEED;
+    if (!benchmark.replayPath.empty()) {
+        if (!cameraReplay.load(benchmark.replayPath)) return -1;
+        asteroidSeed = cameraReplay.asteroidSeed();
+    }
+#else
+    std::string recordPath, replayPath;
+    bool showHud = false;
+    bool imageCache = true;
+    int ringParticles = 0;      // --ring-particles N: stene Saturnovog prstena izbliza (SaturnRing)
+    bool terrainEnabled = false;    // --terrain: povrsina tela izbliza kao quadtree zakrpa (SurfaceTerrain)
+    float terrainHeight = 0.0f;     // --terrain-height SCALE: visine iz svetline teksture tela
+    long long triviaBudget = UiAtlas::DEFAULT_BUDGET_BYTES;    // --trivia-budget-mb N: VRAM za kartice sa detaljima
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--hud") showHud = true;
+        else if (std::string(argv[i]) == "--no-image-cache") imageCache = false;
+        else if (std::string(argv[i]) == "--terrain") terrainEnabled = true;
+        else if (i + 1 >= argc) break;
+        else if (std::string(argv[i]) == "--record") recordPath = argv[++i];
+        else if (std::string(argv[i]) == "--replay") replayPath = argv[++i];
+        else if (std::string(argv[i]) == "--ring-particles") ringParticles = std::max(0, std::atoi(argv[++i]));
+        else if (std::string(argv[i]) == "--trivia-budget-mb") triviaBudget = std::max(0LL, std::atoll(argv[++i])) * 1024 * 1024;
+        else if (std::string(argv[i]) == "--terrain-height") {
+            terrainEnabled = true;
+            terrainHeight = std::max(0.0f, (float)std::atof(argv[++i]));
+        }
+    }
+    // Dekodirane slike iz proslog pokretanja (image-cache/ pored exe fajla); --no-image-cache uvek dekodira
+    if (imageCache) ImageCache::setDirectory(AssetPack::executableDirectory() + ImageCache::DEFAULT_DIRECTORY);
 
-int main() {
-    GLFWwindow* window = initializeOpenGL(screenWidth, screenHeight, "3D Suncev sistem");
+    // --hud ukljucuje i GL brojace (draw pozivi, trouglovi, memorija) u Release build-u
+    GLFWwindow* window = initializeOpenGL(screenWidth, screenHeight, "3D Suncev sistem", showHud);
     if (!window) return -1;
+    GlfwSession glfwSession;
+    SphereLodChain::setViewportHeight(screenHeight);     // Prozor ne menja velicinu
+
+    CameraRecorder cameraRecorder;
+    CameraReplay cameraReplay;
+    unsigned int asteroidSeed = 0;      // Bez snimanja/replay-a raspored asteroida je nasumican
+    if (!replayPath.empty()) {
+        if (!cameraReplay.load(replayPath)) return -1;
+        asteroidSeed = cameraReplay.asteroidSeed();
+    }
+    else if (!recordPath.empty()) {
+        asteroidSeed = FIXED_ASTEROID_SEED;
+        if (!cameraRecorder.open(recordPath, asteroidSeed)) return -1;
+    }
 
-    glfwSetCursorPosCallback(window, mouse_callback);
+    if (!cameraReplay.isLoaded()) {
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+    }
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    glfwSetScrollCallback(window, scroll_callback);
+#endif
 
 
     //===============================PROGRAMS=====================================
@@ -469,49 +520,109 @@ int main() {
     GLuint planetProgram = createProgram("planet.vert", "planet.frag");
     GLuint moonProgram = createProgram("moon.vert", "moon.frag");
     GLuint ringProgram = createProgram("ring.vert", "ring.frag");
+    GLuint ringParticleProgram = ringParticles > 0 ? createProgram("ring-particles.vert", "ring-particles.frag") : 0;
     GLuint triviaShaderProgram = createProgram("details.vert", "details.frag");
+    {
+        // Kartice su u ekranskom prostoru; uniformi se ne menjaju posle pokretanja
+        glm::mat4 orthoProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+        glUseProgram(triviaShaderProgram);
+        glUniformMatrix4fv(glGetUniformLocation(triviaShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(orthoProjection));
+        glUniform1i(glGetUniformLocation(triviaShaderProgram, "texture1"), 0);
+    }
     GLuint orbitShaderProgram = createProgram("orbit.vert", "orbit.frag");
     GLuint asteroidProgram = createProgram("asteroids.vert", "asteroids.frag");
     GLuint oortCloudProgram = createProgram("oort-cloud.vert", "oort-cloud.frag");
+#ifndef HEADLESS_BENCHMARK
+    GLuint textProgram = createProgram("text.vert", "text.frag");
+
+    PerfHud hud;                                                //H - performansni overlay
+    hud.init("LiberationSans-Regular.ttf", textProgram);
+    hud.setVisible(showHud);
+#endif
 
     //===============================TEXTURES=====================================
-    GLuint skyBoxTextureID = loadCubemap();
+    TextureStreamer textureStreamer;                            //stbi_load na pozadinskim nitima, slanje na GPU kroz PBO
+    GLuint skyBoxTextureID = loadCubemap(textureStreamer);
+
+    TextureArrayManager bodyTextures(textureStreamer);         //Povrsine planeta i meseca u GL_TEXTURE_2D_ARRAY po klasama velicine
 
     //PLANETS
-    GLuint sunTextureID = loadTexture("sun-tex.jpg");
-    GLuint mercuryTextureID = loadTexture("mercury-tex.jpg");
-    GLuint venusTextureID = loadTexture("venus-tex.jpg");
-    GLuint earthTextureID = loadTexture("earth-tex.jpg");
-    GLuint marsTextureID = loadTexture("mars-tex.jpg");
-    GLuint jupiterTextureID = loadTexture("jupiter-tex.jpg");
-    GLuint saturnTextureID = loadTexture("saturn-tex.jpg");
-    GLuint ringTextureID = loadTexture("saturn-ring-tex.jpg");
-    GLuint uranusTextureID = loadTexture("uranus-tex.jpg");
-    GLuint plutoTextureID = loadTexture("pluto-tex.jpg");
-    GLuint neptuneTextureID = loadTexture("neptune-tex.jpg");
-    GLuint asteroidTextureID = loadTexture("2k_asteroid.jpg");
+    GLuint sunTextureID = textureStreamer.loadTexture("sun-tex.jpg");
+    TextureLayer mercuryTexture = bodyTextures.add("mercury-tex.jpg");
+    TextureLayer venusTexture = bodyTextures.add("venus-tex.jpg");
+    TextureLayer earthTexture = bodyTextures.add("earth-tex.jpg");
+    TextureLayer marsTexture = bodyTextures.add("mars-tex.jpg");
+    TextureLayer jupiterTexture = bodyTextures.add("jupiter-tex.jpg");
+    TextureLayer saturnTexture = bodyTextures.add("saturn-tex.jpg");
+    GLuint ringTextureID = textureStreamer.loadTexture("saturn-ring-tex.jpg");
+    TextureLayer uranusTexture = bodyTextures.add("uranus-tex.jpg");
+    TextureLayer plutoTexture = bodyTextures.add("pluto-tex.jpg");
+    TextureLayer neptuneTexture = bodyTextures.add("neptune-tex.jpg");
+    GLuint asteroidTextureID = textureStreamer.loadTexture("2k_asteroid.jpg");
 
     //MOONS
-    GLuint moonTextureID = loadTexture("moon-tex.jpg");
-    GLuint deimosTextureID = loadTexture("deimos-tex.jpg");
-    GLuint phobosTextureID = loadTexture("phobos-tex.jpg");
-    GLuint ioTextureID = loadTexture("io-tex.jpg");
-    GLuint europaTextureID = loadTexture("europa-tex.jpg");
-    GLuint ganymedeTextureID = loadTexture("ganymede-tex.jpg");
-    GLuint callistoTextureID = loadTexture("callisto-tex.jpg");
-    GLuint titanTextureID = loadTexture("titan-tex.jpg");
-    GLuint rheaTextureID = loadTexture("rhea-tex.jpg");
-    GLuint iapetusTextureID = loadTexture("iapetus-tex.jpg");
-    GLuint umbrielTextureID = loadTexture("umbriel-tex.jpg");
-    GLuint arielTextureID = loadTexture("ariel-tex.jpg");
-    GLuint mirandaTextureID = loadTexture("miranda-tex.jpg");
-    GLuint tritonTextureID = loadTexture("triton-tex.jpg");
+    TextureLayer moonTexture = bodyTextures.add("moon-tex.jpg");
+    TextureLayer deimosTexture = bodyTextures.add("deimos-tex.jpg");
+    TextureLayer phobosTexture = bodyTextures.add("phobos-tex.jpg");
+    TextureLayer ioTexture = bodyTextures.add("io-tex.jpg");
+    TextureLayer europaTexture = bodyTextures.add("europa-tex.jpg");
+    TextureLayer ganymedeTexture = bodyTextures.add("ganymede-tex.jpg");
+    TextureLayer callistoTexture = bodyTextures.add("callisto-tex.jpg");
+    TextureLayer titanTexture = bodyTextures.add("titan-tex.jpg");
+    TextureLayer rheaTexture = bodyTextures.add("rhea-tex.jpg");
+    TextureLayer iapetusTexture = bodyTextures.add("iapetus-tex.jpg");
+    TextureLayer umbrielTexture = bodyTextures.add("umbriel-tex.jpg");
+    TextureLayer arielTexture = bodyTextures.add("ariel-tex.jpg");
+    TextureLayer mirandaTexture = bodyTextures.add("miranda-tex.jpg");
+    TextureLayer tritonTexture = bodyTextures.add("triton-tex.jpg");
+    bodyTextures.build();
 
 
     SkyBox skyBox(skyBoxProgram, skyBoxTextureID);
+
+#ifdef HEADLESS_BENCHMARK
+    textureStreamer.finish();       // Mere se samo frejmovi sa svim teksturama
+#endif
+    UiAtlas triviaAtlas(triviaBudget);  //Kartice sa detaljima (details.vert/frag): raspored odmah, slika pri prvom prikazu, VRAM pod budzetom
+    for (const std::string& name : triviaCardNames()) triviaAtlas.add(name, triviaPathFor(name));
+    triviaAtlas.build();
+#ifdef HEADLESS_BENCHMARK
+    triviaAtlas.loadAll();          // Kao textureStreamer.finish(): dekodiranje kartica koje staju u budzet ne ulazi u merene frejmove
+#endif
+    UiBatch uiBatch;
     //===============================SPACE BODIES INITS=====================================
     //SUN
     Sun sun(1.0f, 36, 18);
+
+#ifdef HEADLESS_BENCHMARK
+    // Stres scena zamenjuje planete, mesece i pojaseve; nebo i Sunce ostaju isti
+    if (benchmark.stressMode()) {
+        StressSceneShading shading;
+        shading.planetProgram = planetProgram;
+        shading.moonProgram = moonProgram;
+        shading.asteroidProgram = asteroidProgram;
+        shading.oortCloudProgram = oortCloudProgram;
+        shading.bodyTextures = { mercuryTexture, venusTexture, earthTexture, marsTexture, jupiterTexture,
+            saturnTexture, uranusTexture, plutoTexture, neptuneTexture };
+        shading.moonTextures = { moonTexture, deimosTexture, phobosTexture, ioTexture, europaTexture,
+            ganymedeTexture, callistoTexture, titanTexture, rheaTexture, iapetusTexture,
+            umbrielTexture, arielTexture, mirandaTexture, tritonTexture };
+        shading.asteroidTexture = asteroidTextureID;
+
+        auto drawFixedScene = [&](const glm::mat4& view, const glm::mat4& projection, float deltaTime) {
+            skyBox.renderSkybox(view, projection);
+            sun.Draw(sunProgram, sunTextureID, view, projection, deltaTime, cameraPos);
+        };
+
+        int exitCode = runStressSweep(benchmark, offscreen, shading, drawFixedScene,
+            calculateCameraMatrix(), calculateProjectionMatrix(screenWidth, screenHeight), cameraPos);
+        checkOpenGLError("After stress sweep");
+        if (!benchmark.tracePath.empty()) {
+            Tracer::writeChromeJson(benchmark.tracePath);
+        }
+        return exitCode;
+    }
+#endif
     
     //MERCURY
     Planet mercury(0.3f, 36, 18, 35.0f, 40.0f, 1.5f, 0.247f); // Merkur
@@ -538,6 +649,10 @@ int main() {
     //SATURN
     Planet saturn(0.65f, 36, 18, 18.0f, 18.0f, 8.5f, 0.0678f); // (radius, sectors, stacks, rotationSpeed, orbitSpeed, distanceFromSun)
     SaturnRing ring(100, 0.6f, 1.0f);
+    if (ringParticles > 0 && ring.enableParticles(ringParticleProgram, ringParticles, "saturn-ring-tex.jpg", asteroidSeed, screenHeight)) {
+        ring.calibrate(ringProgram, ringTextureID, calculateProjectionMatrix(screenWidth, screenHeight));
+        ring.print(std::cout);
+    }
     Moon titan(saturn, 0.27f, 36, 18, 10.0f, 50.0f, 0.8f);   // (radius, sectors, stacks, rotationSpeed, orbitSpeed, distanceFromSaturn)
     Moon rhea(saturn, 0.2f, 36, 18, 8.0f, 40.0f, 1.2f);    
     Moon iapetus(saturn, 0.19f, 36, 18, 6.0f, 30.0f, 1.6f); 
@@ -555,79 +670,159 @@ int main() {
     Planet neptune(0.50f, 36, 18, 16.0f, 14.0f, 13.0f, 0.0108f); // (radius, sectors, stacks, rotationSpeed, orbitSpeed, distanceFromSun)
     Moon triton(neptune, 0.22f, 36, 18, 9.0f, 55.0f, 0.5f);   // Triton - najveći mesec
 
+    //SURFACE TERRAIN
+    std::unique_ptr<SurfaceTerrain> terrain;                    //--terrain: povrsina izbliza kao quadtree zakrpa
+    if (terrainEnabled) {
+        terrain.reset(new SurfaceTerrain(screenHeight));
+        // Pravih visinskih mapa nema, pa --terrain-height uzima svetlinu teksture tela; bez njega povrsina je glatka
+        std::vector<std::pair<Planet*, std::string>> planetSurfaces = {
+            { &mercury, "mercury-tex.jpg" }, { &venus, "venus-tex.jpg" }, { &earth, "earth-tex.jpg" },
+            { &mars, "mars-tex.jpg" }, { &jupiter, "jupiter-tex.jpg" }, { &saturn, "saturn-tex.jpg" },
+            { &uranus, "uranus-tex.jpg" }, { &pluto, "pluto-tex.jpg" }, { &neptune, "neptune-tex.jpg" } };
+        std::vector<std::pair<Moon*, std::string>> moonSurfaces = {
+            { &moon, "moon-tex.jpg" }, { &phobos, "phobos-tex.jpg" }, { &deimos, "deimos-tex.jpg" },
+            { &io, "io-tex.jpg" }, { &europa, "europa-tex.jpg" }, { &ganymede, "ganymede-tex.jpg" },
+            { &callisto, "callisto-tex.jpg" }, { &titan, "titan-tex.jpg" }, { &rhea, "rhea-tex.jpg" },
+            { &iapetus, "iapetus-tex.jpg" }, { &umbriel, "umbriel-tex.jpg" }, { &ariel, "ariel-tex.jpg" },
+            { &miranda, "miranda-tex.jpg" }, { &triton, "triton-tex.jpg" } };
+        for (auto& surface : planetSurfaces) {
+            surface.first->setTerrain(terrain.get(), terrain->addBody(terrainHeight > 0.0f ? surface.second : "", terrainHeight));
+        }
+        for (auto& surface : moonSurfaces) {
+            surface.first->setTerrain(terrain.get(), terrain->addBody(terrainHeight > 0.0f ? surface.second : "", terrainHeight));
+        }
+    }
+
+    //ORBITS
+    OrbitRenderer orbits;                                       //Sve orbite planeta u jednom instanciranom pozivu
+    for (Planet* planet : { &mercury, &venus, &earth, &mars, &jupiter, &saturn, &uranus, &pluto, &neptune }) {
+        orbits.add(planet->getOrbit(glm::vec3(0.8f, 0.8f, 0.8f)));
+    }
+
     //ASTEROID BELTS
-    AsteroidBelt mainAsteroidBelt(200, 4.5f, 5.0f);             //Izmedju marsa i jupitera
-    AsteroidBelt kuiperBelt(700, 13.0f, 18.0f);                 //Iza neptuna
-    AsteroidBelt oortCloud(1200, 21.0f, 25.0f);                 //Najdalji pojas od sunca (zamrznut)
+    AsteroidBelt mainAsteroidBelt(200, 4.5f, 5.0f, asteroidSeed);                           //Izmedju marsa i jupitera
+    AsteroidBelt kuiperBelt(700, 13.0f, 18.0f, asteroidSeed ? asteroidSeed + 1 : 0);        //Iza neptuna
+    AsteroidBelt oortCloud(1200, 21.0f, 25.0f, asteroidSeed ? asteroidSeed + 2 : 0);        //Najdalji pojas od sunca (zamrznut)
+
+    PassTimer passTimer;                                        //CPU/GPU vreme po prolazu (T - ispis tabele)
 
 
+#ifdef HEADLESS_BENCHMARK
+    FrameTimeReport frameTimes;
+    int totalFrames = benchmark.warmupFrames + benchmark.frames;
+    if (cameraReplay.isLoaded()) {
+        totalFrames = cameraReplay.frameCount();    // Prvih warmupFrames frejmova putanje se ne meri
+    }
+
+    for (int frameIndex = 0; frameIndex < totalFrames; ++frameIndex) {
+        auto frameStart = std::chrono::high_resolution_clock::now();
+        float deltaTime = benchmark.deltaTime;     // Fiksni korak -> isti frejmovi u svakom pokretanju
+
+        glm::mat4 viewMatrix = calculateCameraMatrix();
+        glm::mat4 projectionMatrix = calculateProjectionMatrix(screenWidth, screenHeight, terrain ? terrain->nearPlane(DEFAULT_NEAR_PLANE) : DEFAULT_NEAR_PLANE);
+
+        offscreen.bind();
+
+        CameraFrame replayFrame;
+        if (cameraReplay.next(replayFrame)) {
+            deltaTime = replayFrame.deltaTime;
+            applyCameraFrame(replayFrame);
+        }
+#else
+    bool firstFrame = true;
     while (!glfwWindowShouldClose(window)) {
        
         float currentFrame = glfwGetTime();
         float deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
+        auto frameCpuStart = std::chrono::high_resolution_clock::now();
 
         glm::mat4 viewMatrix = calculateCameraMatrix();
-        glm::mat4 projectionMatrix = calculateProjectionMatrix(screenWidth, screenHeight);
+        glm::mat4 projectionMatrix = calculateProjectionMatrix(screenWidth, screenHeight, terrain ? terrain->nearPlane(DEFAULT_NEAR_PLANE) : DEFAULT_NEAR_PLANE);
+
+        CameraFrame replayFrame;
+        if (cameraReplay.isLoaded()) {
+            if (!cameraReplay.next(replayFrame)) break;
+            if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) break;
+            deltaTime = replayFrame.deltaTime;
+            applyCameraFrame(replayFrame);
+        }
+        else {
+            processInput(window, deltaTime);
+        }
+
+        if (cameraRecorder.isOpen()) {
+            cameraRecorder.write(captureCameraFrame(deltaTime));
+        }
+#endif
+        TRACE_SCOPE("Frame");
+
+        if (!textureStreamer.isDone()) {
+            textureStreamer.upload(TextureStreamer::UPLOADS_PER_FRAME);
+        }
 
-        processInput(window, deltaTime);
+        passTimer.beginFrame();
+        GLStats::beginFrame();
+        SphereLodChain::beginFrame();
+        if (terrain) terrain->beginFrame();
+        triviaAtlas.beginFrame();
 
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f); 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 
         //[SPACE BODIES DRAWING]
-        skyBox.renderSkybox(viewMatrix, projectionMatrix);
+        { PassScope pass(passTimer, "SkyBox::renderSkybox"); skyBox.renderSkybox(viewMatrix, projectionMatrix); }
 
         //SUN
-        sun.Draw(sunProgram, sunTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos);
+        { PassScope pass(passTimer, "Sun::Draw"); sun.Draw(sunProgram, sunTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos); }
         
         //MERCURY
-        mercury.Draw(planetProgram, mercuryTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(mercury)"); mercury.Draw(planetProgram, mercuryTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //VENUS
-        venus.Draw(planetProgram, venusTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(venus)"); venus.Draw(planetProgram, venusTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //EARTH
-        earth.Draw(planetProgram, earthTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        moon.Draw(moonProgram, moonTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(earth)"); earth.Draw(planetProgram, earthTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(moon)"); moon.Draw(moonProgram, moonTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
         
         //MARS
-        mars.Draw(planetProgram, marsTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        phobos.Draw(moonProgram, phobosTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        deimos.Draw(moonProgram, deimosTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(mars)"); mars.Draw(planetProgram, marsTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(phobos)"); phobos.Draw(moonProgram, phobosTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(deimos)"); deimos.Draw(moonProgram, deimosTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
         
         //JUPITER
-        jupiter.Draw(planetProgram, jupiterTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        io.Draw(moonProgram, ioTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        europa.Draw(moonProgram, europaTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        ganymede.Draw(moonProgram, ganymedeTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        callisto.Draw(moonProgram, callistoTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(jupiter)"); jupiter.Draw(planetProgram, jupiterTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(io)"); io.Draw(moonProgram, ioTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(europa)"); europa.Draw(moonProgram, europaTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(ganymede)"); ganymede.Draw(moonProgram, ganymedeTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(callisto)"); callisto.Draw(moonProgram, callistoTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //SATURN
-        saturn.Draw(planetProgram, saturnTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        ring.Draw(ringProgram, ringTextureID, viewMatrix, projectionMatrix, saturn.getPosition());
-        titan.Draw(moonProgram, titanTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        rhea.Draw(moonProgram, rheaTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        iapetus.Draw(moonProgram, iapetusTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(saturn)"); saturn.Draw(planetProgram, saturnTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "SaturnRing::Draw"); ring.Draw(ringProgram, ringTextureID, viewMatrix, projectionMatrix, saturn.getPosition(), cameraPos); }
+        { PassScope pass(passTimer, "Moon::Draw(titan)"); titan.Draw(moonProgram, titanTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(rhea)"); rhea.Draw(moonProgram, rheaTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(iapetus)"); iapetus.Draw(moonProgram, iapetusTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //URANUS
-        uranus.Draw(planetProgram, uranusTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        umbriel.Draw(moonProgram, umbrielTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        ariel.Draw(moonProgram, arielTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
-        miranda.Draw(moonProgram, mirandaTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(uranus)"); uranus.Draw(planetProgram, uranusTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(umbriel)"); umbriel.Draw(moonProgram, umbrielTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(ariel)"); ariel.Draw(moonProgram, arielTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(miranda)"); miranda.Draw(moonProgram, mirandaTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
         
         //PLUTO
-        pluto.Draw(planetProgram, plutoTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(pluto)"); pluto.Draw(planetProgram, plutoTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //NEPTUNE
-        neptune.Draw(planetProgram, neptuneTextureID, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier);
-        triton.Draw(moonProgram, tritonTextureID, viewMatrix, projectionMatrix, deltaTime, speedMultiplier);
+        { PassScope pass(passTimer, "Planet::Draw(neptune)"); neptune.Draw(planetProgram, neptuneTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
+        { PassScope pass(passTimer, "Moon::Draw(triton)"); triton.Draw(moonProgram, tritonTexture, viewMatrix, projectionMatrix, deltaTime, cameraPos, speedMultiplier); }
 
         //ASTEROIDS
-        mainAsteroidBelt.Draw(asteroidProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos);
-        kuiperBelt.Draw(asteroidProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos);
-        oortCloud.Draw(oortCloudProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos);
+        { PassScope pass(passTimer, "AsteroidBelt::Draw(main)"); mainAsteroidBelt.Draw(asteroidProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos); }
+        { PassScope pass(passTimer, "AsteroidBelt::Draw(kuiper)"); kuiperBelt.Draw(asteroidProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos); }
+        { PassScope pass(passTimer, "AsteroidBelt::Draw(oort)"); oortCloud.Draw(oortCloudProgram, asteroidTextureID, viewMatrix, projectionMatrix, cameraPos); }
 
         std::unordered_map<std::string, Planet*> planets = {
             {"mercury", &mercury},
@@ -666,17 +861,115 @@ int main() {
 
         if (showOrbits)
         {
-            drawOrbits(planets, orbitShaderProgram, viewMatrix, projectionMatrix);
+            PassScope pass(passTimer, "OrbitRenderer::Draw");
+            orbits.Draw(orbitShaderProgram, viewMatrix, projectionMatrix, cameraPos, screenHeight);
+        }
+
+        {
+            PassScope pass(passTimer, "shouldShowDetails");
+            shouldShowDetails(uiBatch, triviaAtlas, sun, moons, planets, asteroids);
+            uiBatch.flush(triviaShaderProgram, triviaAtlas.texture(), polygonMode);
+        }
+
+#ifndef HEADLESS_BENCHMARK
+        if (hud.isVisible()) {
+            PassScope pass(passTimer, "PerfHud::Draw");
+            hud.Draw(screenWidth, screenHeight, polygonMode);
         }
+#endif
 
-        shouldShowDetails(triviaShaderProgram, sun, moons, planets, asteroids);
+        passTimer.endFrame();
+        GLStats::endFrame();
+        GpuMemory::endFrame();
+
+#ifdef HEADLESS_BENCHMARK
+        glFinish();     // Sacekaj GPU da bi izmereno vreme obuhvatilo ceo frejm
+        std::chrono::duration<double, std::milli> frameTime = std::chrono::high_resolution_clock::now() - frameStart;
+        if (frameIndex >= benchmark.warmupFrames) {
+            frameTimes.addFrame(frameTime.count());
+        }
+        else if (frameIndex + 1 == benchmark.warmupFrames) {
+            GLStats::resetFrameHistory();
+        }
+#else
+        HudFrameStats hudStats;
+        hudStats.frameMs = deltaTime * 1000.0;
+        hudStats.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frameCpuStart).count();
+        for (const PassTiming& timing : passTimer.latest()) hudStats.gpuMs += timing.gpuMs;     // Poslednji razreseni frejm (kasni par frejmova)
+        if (GLStats::isInstalled()) {
+            hudStats.haveGLCounters = true;
+            hudStats.drawCalls = GLStats::lastFrame().drawCalls;
+            hudStats.triangles = GLStats::lastFrame().trianglesSubmitted;
+        }
+        hudStats.textureBytes = GpuMemory::liveBytes(GPU_TEXTURE);
+        hudStats.bufferBytes = GpuMemory::liveBytes(GPU_BUFFER);
+        hudStats.suspectedLeaks = GpuMemory::suspectedLeakCount();
+        hud.addFrame(hudStats);
+
+        if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS && !isOneClick(lastKeyPressTime)) {
+            hud.setVisible(!hud.isVisible());
+        }
+
+        if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS && !isOneClick(lastKeyPressTime)) {
+            passTimer.print(std::cout, false);
+            if (GLStats::isInstalled()) GLStats::print(std::cout);
+        }
+
+        if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS && !isOneClick(lastKeyPressTime)) {
+            Tracer::writeChromeJson("trace.json");
+        }
+
+        if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !isOneClick(lastKeyPressTime)) {
+            printGpuMemoryReport(std::cout);
+            bodyTextures.print(std::cout);
+            triviaAtlas.print(std::cout);
+            MeshRegistry::print(std::cout);
+            SphereLodChain::print(std::cout);
+            ring.print(std::cout);
+            if (terrain) terrain->print(std::cout);
+        }
 
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        if (firstFrame) {
+            std::cout << "Prvi frejm: " << Tracer::now() / 1000000 << " ms od pokretanja (" << textureStreamer.pendingCount()
+                << " tekstura jos stize, " << textureStreamer.previewCount() << " sa umanjenom verzijom)" << std::endl;
+            firstFrame = false;
+        }
+#endif
+    }
+
+#ifdef HEADLESS_BENCHMARK
+    checkOpenGLError("After benchmark");
+    frameTimes.print(std::cout);
+    passTimer.print(std::cout, true);
+    if (!benchmark.tracePath.empty()) {
+        Tracer::writeChromeJson(benchmark.tracePath);
     }
 
-    glfwTerminate();
+    int exitCode = 0;
+    if (GLStats::isInstalled()) {
+        GLStats::print(std::cout);
+        if (!checkGLBudget(benchmark, GLStats::peakFrame(), std::cerr)) exitCode = 1;
+    }
+    printGpuMemoryReport(std::cout);
+    bodyTextures.print(std::cout);
+    triviaAtlas.print(std::cout);
+    MeshRegistry::print(std::cout);
+    SphereLodChain::print(std::cout);
+    ring.print(std::cout);
+    if (terrain) terrain->print(std::cout);
+    return exitCode;
+#else
+    if (cameraRecorder.isOpen()) {
+        std::cout << "CameraRecorder: snimljeno " << cameraRecorder.frameCount() << " frejmova (" << recordPath << ")" << std::endl;
+    }
+    if (GpuMemory::suspectedLeakCount() > 0) {
+        printGpuMemoryReport(std::cerr);
+    }
     return 0;
+#endif
 }
 
 
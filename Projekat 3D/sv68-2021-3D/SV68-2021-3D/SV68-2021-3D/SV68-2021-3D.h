@@ -13,6 +13,8 @@
 #include <fstream>
 #include <sstream>
 #include <unordered_map>
+#include <chrono>
+#include <cstdlib>
 
 // **Include GLM for Matrix Operations**
 #include <glm/glm.hpp>
@@ -28,9 +30,28 @@
 #include "Planet.h"
 #include "Moon.h"
 #include "SaturnRing.h"
+#include "OrbitRenderer.h"
+#include "SurfaceTerrain.h"
 #include "AsteroidBelt.h"
 #include "Asteroid.h"
+#include "MeshRegistry.h"
 #include "SkyBox.h"
+#include "Benchmark.h"
+#include "PassTimer.h"
+#include "Trace.h"
+#include "GLStats.h"
+#include "GpuMemory.h"
+#include "CompressedTexture.h"
+#include "AssetPack.h"
+#include "ImageCache.h"
+#include "TextureStreamer.h"
+#include "TextureArrays.h"
+#include "UiAtlas.h"
+#include "UiBatch.h"
+#include "AssetManifest.h"
+#include "CameraPath.h"
+#include "StressScene.h"
+#include "PerfHud.h"
 
 // Deklaracija funkcije za učitavanje teksture
 GLuint loadTexture(const char* filePath);
@@ -1,40 +1,61 @@
 #define _USE_MATH_DEFINES
 #include "SaturnRing.h"
+#include "MeshGenerators.h"
+#include "GpuMemory.h"
+#include "AssetPack.h"
+#include "Trace.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const int CALIBRATION_REPEATS = 8;
+
+// Prosecno GPU vreme jednog draw() poziva; prvi poziv samo zagreva program i bafere
+double gpuMilliseconds(const std::function<void()>& draw) {
+    draw();
+    glFinish();
+
+    GLuint query;
+    glGenQueries(1, &query);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    for (int i = 0; i < CALIBRATION_REPEATS; ++i) draw();
+    glEndQuery(GL_TIME_ELAPSED);
+
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+    glDeleteQueries(1, &query);
+    return elapsedNs / 1000000.0 / CALIBRATION_REPEATS;
+}
+
+}
 
 SaturnRing::SaturnRing(int segments, float innerRadius, float outerRadius)
-    : segments(segments), innerRadius(innerRadius), outerRadius(outerRadius), VBO(0), VAO(0) {
+    : segments(segments), innerRadius(innerRadius), outerRadius(outerRadius), VBO(0), VAO(0),
+    particleVAO(0), particleVBO(0), particleProgram(0), particleCount(0), pixelsPerUnitScale(0.0f),
+    cost{ 0.0, 0.0, 0.0 }, switchDistance(0.0f), particleMode(false), lastRocks(0) {
     generateRingMesh();
 }
 
 
 // Destructor implementation
 SaturnRing::~SaturnRing() {
+    GpuMemory::release(GPU_BUFFER, VBO);
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &VAO);
+    if (particleVBO) {
+        GpuMemory::release(GPU_BUFFER, particleVBO);
+        glDeleteBuffers(1, &particleVBO);
+        glDeleteVertexArrays(1, &particleVAO);
+    }
 }
 
 // Function to generate ring mesh
 void SaturnRing::generateRingMesh() {
-    ring_vertices.clear();
-    for (int i = 0; i <= segments; i++) {
-        float angle = (2.0f * M_PI * i) / segments;
-        float x = cos(angle);
-        float y = sin(angle);
-
-        // Inner ring
-        ring_vertices.push_back(innerRadius * x);
-        ring_vertices.push_back(innerRadius * y);
-        ring_vertices.push_back(0.0f);
-        ring_vertices.push_back((x + 1.0f) * 0.5f);
-        ring_vertices.push_back((y + 1.0f) * 0.5f);
-
-        // Outer ring
-        ring_vertices.push_back(outerRadius * x);
-        ring_vertices.push_back(outerRadius * y);
-        ring_vertices.push_back(0.0f);
-        ring_vertices.push_back((x + 1.0f) * 0.5f);
-        ring_vertices.push_back((y + 1.0f) * 0.5f);
-    }
+    generateRingVertices(segments, innerRadius, outerRadius, ring_vertices);
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -42,6 +63,7 @@ void SaturnRing::generateRingMesh() {
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, ring_vertices.size() * sizeof(float), ring_vertices.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, VBO, ring_vertices.size() * sizeof(float), "SaturnRing vertices", GPU_MEMORY_SITE);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -53,7 +75,91 @@ void SaturnRing::generateRingMesh() {
 }
 
 
-void SaturnRing::Draw(GLuint shaderProgram, GLuint ringTextureID, glm::mat4 view, glm::mat4 projection, glm::vec3 saturnPosition) {
+bool SaturnRing::enableParticles(GLuint program, int count, const std::string& texturePath, unsigned int seed, int viewportHeight) {
+    TRACE_SCOPE("SaturnRing::enableParticles");
+    GPU_MEMORY_OWNER("SaturnRing");
+
+    // Profil gustine iz alfe teksture; GL tekstura je vec u TextureStreamer-u, ovde treba samo CPU kopija
+    AssetData file = AssetPack::load(texturePath);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = file.empty() ? nullptr
+        : stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "SaturnRing: ne mogu da ucitam " << texturePath << ", ostaje traka" << std::endl;
+        return false;
+    }
+    std::vector<float> profile;
+    ringDensityProfile(pixels, width, height, profile);
+    stbi_image_free(pixels);
+
+    generateRingParticles(count, innerRadius, outerRadius, profile, seed, particles);
+
+    rock = MeshRegistry::icosphere(0);
+    particleVAO = rock->createVertexArray();
+    glBindVertexArray(particleVAO);
+    glGenBuffers(1, &particleVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(glm::vec4), particles.particles.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, particleVBO, count * sizeof(glm::vec4), "SaturnRing particles", GPU_MEMORY_SITE);
+
+    // Pomeraj atributa 2 se postavlja po pozivu (pocetak sektora), jer GL 3.3 nema baseInstance
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+    glVertexAttribDivisor(2, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Pozicije ostaju samo na GPU-u; izboru trebaju granice sektora i velicina stene
+    std::vector<glm::vec4>().swap(particles.particles);
+
+    particleProgram = program;
+    particleCount = count;
+    pixelsPerUnitScale = viewportHeight * 0.5f;
+    return true;
+}
+
+void SaturnRing::calibrate(GLuint shaderProgram, GLuint ringTextureID, const glm::mat4& projection) {
+    if (particleCount == 0) return;
+    TRACE_SCOPE("SaturnRing::calibrate");
+
+    // Ceo prsten u kadru, sve stene pune velicine; dve kolicine daju fiksni deo i cenu po steni
+    glm::vec3 origin(0.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, outerRadius * 1.5f, outerRadius * 2.5f), origin, glm::vec3(0.0f, 1.0f, 0.0f));
+    int quarter = std::max(1, particleCount / 4);
+
+    cost.stripMs = gpuMilliseconds([&]() { drawStrip(shaderProgram, ringTextureID, view, projection, origin); });
+    draws.assign(1, RingDraw{ 0, particleCount, 1.0f });
+    double fullMs = gpuMilliseconds([&]() { drawParticles(ringTextureID, view, projection, origin); });
+    draws.assign(1, RingDraw{ 0, quarter, 1.0f });
+    double quarterMs = gpuMilliseconds([&]() { drawParticles(ringTextureID, view, projection, origin); });
+
+    cost.particleMsPerRock = particleCount > quarter ? std::max(0.0, (fullMs - quarterMs) / (particleCount - quarter)) : fullMs / particleCount;
+    cost.particleFixedMs = std::max(0.0, fullMs - cost.particleMsPerRock * particleCount);
+
+    switchDistance = ringSwitchDistance(cost, particles, innerRadius, outerRadius, projection, projection[1][1] * pixelsPerUnitScale);
+}
+
+void SaturnRing::Draw(GLuint shaderProgram, GLuint ringTextureID, glm::mat4 view, glm::mat4 projection, glm::vec3 saturnPosition, glm::vec3 cameraPos) {
+    if (switchDistance > 0.0f) {
+        // Histereza oko udaljenosti prelaska, da rezim ne treperi na granici
+        float distance = glm::length(cameraPos - saturnPosition);
+        float threshold = switchDistance * (particleMode ? 1.0f + RING_SWITCH_HYSTERESIS : 1.0f - RING_SWITCH_HYSTERESIS);
+        particleMode = distance < threshold;
+    }
+
+    if (particleMode) {
+        lastRocks = selectRingParticles(particles, innerRadius, outerRadius, saturnPosition, cameraPos, projection * view,
+            projection[1][1] * pixelsPerUnitScale, draws);
+        drawParticles(ringTextureID, view, projection, saturnPosition);
+    }
+    else {
+        lastRocks = 0;
+        drawStrip(shaderProgram, ringTextureID, view, projection, saturnPosition);
+    }
+}
+
+void SaturnRing::drawStrip(GLuint shaderProgram, GLuint ringTextureID, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& saturnPosition) {
     glUseProgram(shaderProgram);
 
     glm::mat4 model = glm::mat4(1.0f);
@@ -72,5 +178,40 @@ void SaturnRing::Draw(GLuint shaderProgram, GLuint ringTextureID, glm::mat4 view
     glDrawArrays(GL_TRIANGLE_STRIP, 0, (segments + 1) * 2);
     glBindVertexArray(0);
     glEnable(GL_CULL_FACE);
+}
 
-}
\ No newline at end of file
+void SaturnRing::drawParticles(GLuint ringTextureID, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& saturnPosition) {
+    glUseProgram(particleProgram);
+    glUniformMatrix4fv(glGetUniformLocation(particleProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(particleProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform3fv(glGetUniformLocation(particleProgram, "ringCenter"), 1, glm::value_ptr(saturnPosition));
+    glUniform1f(glGetUniformLocation(particleProgram, "innerRadius"), innerRadius);
+    glUniform1f(glGetUniformLocation(particleProgram, "outerRadius"), outerRadius);
+    GLint sizeScaleLoc = glGetUniformLocation(particleProgram, "sizeScale");
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ringTextureID);
+    glUniform1i(glGetUniformLocation(particleProgram, "ringTexture"), 0);
+
+    // Stene su zatvorene sfere, pa culling ostaje ukljucen
+    glBindVertexArray(particleVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
+    for (const RingDraw& draw : draws) {
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)(draw.first * sizeof(glm::vec4)));
+        glUniform1f(sizeScaleLoc, draw.sizeScale);
+        glDrawElementsInstanced(GL_TRIANGLES, rock->indexCount(), rock->indexType(), 0, draw.count);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void SaturnRing::print(std::ostream& out) const {
+    if (particleCount == 0) return;
+    out << std::fixed << std::setprecision(3);
+    out << "SaturnRing: " << particleCount << " cestica, traka " << cost.stripMs << " ms, cestice "
+        << cost.particleFixedMs << " ms + " << cost.particleMsPerRock * 100000.0 << " ms / 100k stena" << std::endl;
+    out << "SaturnRing: cestice ispod " << switchDistance << " od Saturna (budzet " << RING_PARTICLE_BUDGET_MS
+        << " ms), poslednji frejm: " << (particleMode ? "cestice" : "traka") << ", " << lastRocks << " stena u "
+        << (particleMode ? draws.size() : 0) << " poziva" << std::endl;
+    out << std::defaultfloat;
+}
@@ -9,7 +9,19 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <cmath>
+#include <memory>
+#include <ostream>
+#include "MeshRegistry.h"
+#include "RingLod.h"
 
+// Traka od segments segmenata; opciono (enableParticles) i instancirane stene od 100k do 1M cestica,
+// rasporedjene po alfi teksture prstena. Blizu Saturna se crtaju stene, dalje traka:
+//
+//   ring.enableParticles(ringParticleProgram, 200000, "saturn-ring-tex.jpg", seed, screenHeight);
+//   ring.calibrate(ringProgram, ringTextureID, projection);   // meri GPU cenu i bira udaljenost prelaska
+//   ring.Draw(ringProgram, ringTextureID, view, projection, saturn.getPosition(), cameraPos);
+//
+// Bez calibrate() cestice se ne crtaju.
 class SaturnRing {
 private:
     std::vector<float> ring_vertices;
@@ -19,12 +31,37 @@ private:
     float outerRadius;
     glm::vec3 saturnPosition;  
 
+    // Rezim cestica
+    RingParticles particles;
+    std::shared_ptr<const SphereMesh> rock;     // Ikosfera 0 iz MeshRegistry-ja
+    GLuint particleVAO, particleVBO;
+    GLuint particleProgram;
+    int particleCount;                          // 0 = samo traka
+    float pixelsPerUnitScale;                   // Visina viewport-a / 2
+    RingCostModel cost;
+    float switchDistance;                       // 0 dok calibrate() ne izmeri
+    bool particleMode;
+    int lastRocks;
+    std::vector<RingDraw> draws;
+
+    void drawStrip(GLuint shaderProgram, GLuint ringTextureID, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& saturnPosition);
+    void drawParticles(GLuint ringTextureID, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& saturnPosition);
+
 public:
     SaturnRing(int segments, float innerRadius, float outerRadius);
     ~SaturnRing();
 
     void generateRingMesh();
-    void Draw(GLuint shaderProgram, GLuint ringTextureID, glm::mat4 view, glm::mat4 projection, glm::vec3 saturnPosition);
+
+    // Pravi cestice iz profila teksture (CPU dekodiranje); false ako slika ne moze da se ucita
+    bool enableParticles(GLuint particleProgram, int count, const std::string& texturePath, unsigned int seed, int viewportHeight);
+    // Meri trake i cestice GPU tajmerom u trenutni framebuffer (pre petlje, prvi frejm ga brise)
+    void calibrate(GLuint shaderProgram, GLuint ringTextureID, const glm::mat4& projection);
+
+    void Draw(GLuint shaderProgram, GLuint ringTextureID, glm::mat4 view, glm::mat4 projection, glm::vec3 saturnPosition, glm::vec3 cameraPos);
+
+    // Model cene, udaljenost prelaska i poslednji frejm
+    void print(std::ostream& out) const;
 };
 
 #endif // SATURNRING_H
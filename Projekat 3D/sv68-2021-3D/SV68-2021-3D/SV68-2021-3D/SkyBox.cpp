@@ -1,4 +1,5 @@
 #include "SkyBox.h"
+#include "GpuMemory.h"
 
 SkyBox::SkyBox(GLuint skyboxProgram, GLuint textureID) :
 
@@ -28,9 +29,11 @@ SkyBox::SkyBox(GLuint skyboxProgram, GLuint textureID) :
 
 
 SkyBox::~SkyBox() {
+    GpuMemory::release(GPU_BUFFER, skyboxVBO);
+    GpuMemory::release(GPU_TEXTURE, textureID);
     glDeleteBuffers(1, &skyboxVBO);
     glDeleteVertexArrays(1, &skyboxVAO);
-    glDeleteTextures(1, &cubemapTexture);
+    glDeleteTextures(1, &textureID);     // SkyBox preuzima cube mapu iz loadCubemap
     
 }
 
@@ -41,6 +44,7 @@ void SkyBox::initializeSkybox() {
     glBindVertexArray(skyboxVAO);
     glBindBuffer(GL_ARRAY_BUFFER, skyboxVBO);
     glBufferData(GL_ARRAY_BUFFER, skyboxVertices.size() * sizeof(float), skyboxVertices.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, skyboxVBO, skyboxVertices.size() * sizeof(float), "SkyBox vertices", GPU_MEMORY_SITE);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -0,0 +1,49 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include "SphereLod.h"
+
+namespace {
+
+const int MIN_SECTORS = 8;
+const int MIN_STACKS = 4;
+
+// Najgrublji nivo sa bar toliko sektora; ako nijedan nije dovoljan, najfiniji
+int coarsestLevelWith(const SphereLodLevel levels[SPHERE_LOD_COUNT], float sectors) {
+    for (int level = SPHERE_LOD_COUNT - 1; level > 0; --level) {
+        if (levels[level].sectors >= sectors) return level;
+    }
+    return 0;
+}
+
+}
+
+void buildSphereLodChain(int sectors, int stacks, SphereLodLevel levels[SPHERE_LOD_COUNT]) {
+    for (int level = 0; level < SPHERE_LOD_COUNT; ++level) {
+        int shift = level - SPHERE_LOD_BASE_LEVEL;
+        int levelSectors = shift < 0 ? sectors << -shift : sectors >> shift;
+        int levelStacks = shift < 0 ? stacks << -shift : stacks >> shift;
+        levels[level].sectors = levelSectors < MIN_SECTORS ? MIN_SECTORS : levelSectors;
+        levels[level].stacks = levelStacks < MIN_STACKS ? MIN_STACKS : levelStacks;
+    }
+}
+
+float projectedRadiusPixels(const glm::vec3& center, float radius, const glm::vec3& cameraPos,
+    const glm::mat4& projection, int viewportHeight) {
+    float distance = glm::length(center - cameraPos);
+    if (distance <= radius) return std::numeric_limits<float>::infinity();
+    return radius / distance * projection[1][1] * viewportHeight * 0.5f;
+}
+
+int selectSphereLod(const SphereLodLevel levels[SPHERE_LOD_COUNT], float radiusPixels, int currentLevel) {
+    // Obim na ekranu podeljen na ivice od SPHERE_LOD_EDGE_PIXELS
+    float neededSectors = 2.0f * (float)M_PI * radiusPixels / SPHERE_LOD_EDGE_PIXELS;
+    if (currentLevel < 0) return coarsestLevelWith(levels, neededSectors);
+
+    // Grublji nivo tek kad je dovoljan i za uvecanu velicinu, finiji tek kad ne valja ni za umanjenu
+    int coarser = coarsestLevelWith(levels, neededSectors * (1.0f + SPHERE_LOD_HYSTERESIS));
+    int finer = coarsestLevelWith(levels, neededSectors * (1.0f - SPHERE_LOD_HYSTERESIS));
+    if (coarser > currentLevel) return coarser;
+    if (finer < currentLevel) return finer;
+    return currentLevel;
+}
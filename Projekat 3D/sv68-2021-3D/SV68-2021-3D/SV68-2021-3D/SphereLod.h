@@ -0,0 +1,35 @@
+#ifndef SPHERE_LOD_H
+#define SPHERE_LOD_H
+
+#include <glm/glm.hpp>
+
+// Izbor nivoa detalja sfere po velicini na ekranu, bez OpenGL poziva - koristi ga SphereLodChain
+
+// Nivo 0 je najfiniji; svaki sledeci ima dvostruko manje sektora i stekova
+const int SPHERE_LOD_COUNT = 5;
+const int SPHERE_LOD_BASE_LEVEL = 2;       // Gustina iz konstruktora tela (36x18) je srednji nivo
+
+// Ivica trougla na ekvatoru u pikselima kojoj se tezi; manje = finije mreze
+const float SPHERE_LOD_EDGE_PIXELS = 10.0f;
+
+// Pojas oko praga u kome nivo ostaje isti (0.2 = +-20% poluprecnika na ekranu)
+const float SPHERE_LOD_HYSTERESIS = 0.2f;
+
+struct SphereLodLevel {
+    int sectors;
+    int stacks;
+};
+
+// Lanac od baznog nivoa: 144x72, 72x36, 36x18, 18x9, 9x4 za 36x18 (najmanje 8 sektora i 4 steka)
+void buildSphereLodChain(int sectors, int stacks, SphereLodLevel levels[SPHERE_LOD_COUNT]);
+
+// Poluprecnik sfere na ekranu u pikselima; projection[1][1] = 1 / tan(fov / 2).
+// Kamera unutar sfere daje beskonacno veliki poluprecnik (najfiniji nivo)
+float projectedRadiusPixels(const glm::vec3& center, float radius, const glm::vec3& cameraPos,
+    const glm::mat4& projection, int viewportHeight);
+
+// Najgrublji nivo cija ivica na ekvatoru nije duza od SPHERE_LOD_EDGE_PIXELS.
+// currentLevel < 0 = bez istorije; inace se menja tek kad velicina izadje iz pojasa histereze
+int selectSphereLod(const SphereLodLevel levels[SPHERE_LOD_COUNT], float radiusPixels, int currentLevel);
+
+#endif // SPHERE_LOD_H
@@ -0,0 +1,285 @@
+#include "StressScene.h"
+#include "GpuMemory.h"
+#include "MeshGenerators.h"
+#include "SphereLod.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Ista gustina mreze kao tela Suncevog sistema i bazni asteroid AsteroidBelt-a
+const int BODY_SECTORS = 36;
+const int BODY_STACKS = 18;
+const int ASTEROID_SUBDIVISIONS = 1;
+
+// Pojasevi na istim poluprecnicima kao glavni pojas, Kuiperov pojas i Ortov oblak
+const float BELT_RADII[3][2] = { { 4.5f, 5.0f }, { 13.0f, 18.0f }, { 21.0f, 25.0f } };
+
+const float INNER_ORBIT = 1.5f;     // Merkur
+const float OUTER_ORBIT = 25.0f;    // Unutar far plane-a (100) i za pogled iz daljine
+
+size_t sphereBytes(int sectors, int stacks) {
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    generateSphereVertices(1.0f, sectors, stacks, SPHERE_UV_STANDARD, vertices);
+    generateSphereIndices(sectors, stacks, (int)vertices.size() / 5, indices);
+    return vertices.size() / 5 * PACKED_SPHERE_VERTEX_BYTES + indices.size() * sizeof(int);
+}
+
+// Ikosfera (indeksi, UV) i pozicije svih varijanti stena (AsteroidVariantSet: x, y, z, 0 kao short)
+size_t asteroidMeshBytes(int subdivisions, int variants) {
+    std::vector<float> vertices;
+    std::vector<unsigned short> indices;
+    generateIcosphere(subdivisions, vertices, indices);
+    optimizeVertexFetch(vertices, 5, indices);      // Kao SphereMesh: izbacuje nekoriscene vertekse polova
+    size_t vertexCount = vertices.size() / 5;
+    return vertexCount * PACKED_SPHERE_VERTEX_BYTES + indices.size() * sizeof(unsigned short)
+        + vertexCount * variants * 4 * sizeof(short);
+}
+
+double toMB(size_t bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+// Zbir CPU/GPU vremena prolaza sa datim imenom iz PassTimer::average()
+void findPass(const std::vector<PassTiming>& timings, const char* name, double& cpuMs, double& gpuMs) {
+    cpuMs = 0.0;
+    gpuMs = 0.0;
+    for (const PassTiming& timing : timings) {
+        if (timing.name == name) {
+            cpuMs = timing.cpuMs;
+            gpuMs = timing.gpuMs;
+        }
+    }
+}
+
+struct SweepPoint {
+    StressSceneConfig config;
+    int objects;
+    double meanMs;
+};
+
+}
+
+StressScene::StressScene(const StressSceneConfig& config) : config(config) {
+    TRACE_SCOPE("StressScene::build");
+    GPU_MEMORY_OWNER("StressScene");
+
+    std::mt19937 gen(config.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto range = [&](float low, float high) { return low + (high - low) * unit(gen); };
+
+    planets.reserve(config.bodies);
+    moons.reserve((size_t)config.bodies * config.moonsPerBody);
+
+    for (int i = 0; i < config.bodies; ++i) {
+        // Orbite ravnomerno od Merkura do Ortovog oblaka; brzina opada sa udaljenoscu kao u pravoj sceni
+        float distance = INNER_ORBIT + (OUTER_ORBIT - INNER_ORBIT) * (i + 0.5f) / config.bodies;
+        float radius = range(0.2f, 0.7f);
+        float orbitSpeed = 60.0f / std::sqrt(distance);
+
+        planets.emplace_back(new Planet(radius, BODY_SECTORS, BODY_STACKS, range(10.0f, 35.0f), orbitSpeed, distance, range(0.0f, 0.1f)));
+        Planet& planet = *planets.back();
+        planet.setOrbitAngle(range(0.0f, 360.0f));
+
+        for (int j = 0; j < config.moonsPerBody; ++j) {
+            float moonDistance = radius + 0.3f + 0.25f * j;
+            moons.emplace_back(new Moon(planet, range(0.1f, 0.25f), BODY_SECTORS, BODY_STACKS, range(5.0f, 20.0f), range(30.0f, 150.0f), moonDistance));
+            moons.back()->setOrbitAngle(range(0.0f, 360.0f));
+        }
+    }
+
+    if (config.asteroidsPerBelt > 0) {
+        for (int b = 0; b < 3; ++b) {
+            belts.emplace_back(new AsteroidBelt(config.asteroidsPerBelt, BELT_RADII[b][0], BELT_RADII[b][1], config.seed + 1 + b));
+        }
+    }
+}
+
+void StressScene::Draw(const StressSceneShading& shading, PassTimer& passTimer, const glm::mat4& view, const glm::mat4& projection,
+    float deltaTime, glm::vec3 cameraPos, float speedMultiplier) {
+    {
+        PassScope pass(passTimer, "StressScene::planets");
+        for (size_t i = 0; i < planets.size(); ++i) {
+            const TextureLayer& texture = shading.bodyTextures[i % shading.bodyTextures.size()];
+            planets[i]->Draw(shading.planetProgram, texture, view, projection, deltaTime, cameraPos, speedMultiplier);
+        }
+    }
+
+    {
+        PassScope pass(passTimer, "StressScene::moons");
+        for (size_t i = 0; i < moons.size(); ++i) {
+            const TextureLayer& texture = shading.moonTextures[i % shading.moonTextures.size()];
+            moons[i]->Draw(shading.moonProgram, texture, view, projection, deltaTime, cameraPos, speedMultiplier);
+        }
+    }
+
+    {
+        PassScope pass(passTimer, "StressScene::belts");
+        for (size_t b = 0; b < belts.size(); ++b) {
+            GLuint program = (b == 2) ? shading.oortCloudProgram : shading.asteroidProgram;    // Ortov oblak ima svoj sejder
+            belts[b]->Draw(program, shading.asteroidTexture, view, projection, cameraPos);
+        }
+    }
+}
+
+const StressSceneConfig& StressScene::getConfig() const {
+    return config;
+}
+
+int StressScene::objectCount() const {
+    return (int)(planets.size() + moons.size() + belts.size());
+}
+
+long long StressScene::asteroidCount() const {
+    return (long long)belts.size() * config.asteroidsPerBelt;
+}
+
+size_t StressScene::meshBytes() const {
+    SphereLodLevel bodyLods[SPHERE_LOD_COUNT];
+    buildSphereLodChain(BODY_SECTORS, BODY_STACKS, bodyLods);
+    size_t bodyMesh = 0;
+    for (const SphereLodLevel& lod : bodyLods) bodyMesh += sphereBytes(lod.sectors, lod.stacks);
+    size_t asteroidMesh = asteroidMeshBytes(ASTEROID_SUBDIVISIONS, DEFAULT_ASTEROID_VARIANTS);
+
+    // Planete i meseci dele jedan LOD lanac sfera, pojasevi ikosferu (MeshRegistry); orbite se ne crtaju
+    size_t bytes = 0;
+    if (!planets.empty() || !moons.empty()) bytes += bodyMesh;
+    if (!belts.empty()) bytes += asteroidMesh;
+    bytes += (size_t)asteroidCount() * (sizeof(glm::vec4) + sizeof(unsigned char));     // Instanca + varijanta
+    return bytes;
+}
+
+
+int runStressSweep(const BenchmarkOptions& options, const OffscreenTarget& offscreen, const StressSceneShading& shading,
+    const FixedSceneDrawer& drawFixedScene, const glm::mat4& view, const glm::mat4& projection, glm::vec3 cameraPos) {
+    StressSceneConfig defaults;
+    std::vector<int> bodyCounts = options.stressBodies.empty() ? std::vector<int>{ defaults.bodies } : options.stressBodies;
+    std::vector<int> moonCounts = options.stressMoons.empty() ? std::vector<int>{ defaults.moonsPerBody } : options.stressMoons;
+    std::vector<int> asteroidCounts = options.stressAsteroids.empty() ? std::vector<int>{ defaults.asteroidsPerBelt } : options.stressAsteroids;
+
+    std::ofstream csv(options.sweepOutPath);
+    if (!csv.is_open()) {
+        std::cerr << "Ne mogu da otvorim " << options.sweepOutPath << " za pisanje!" << std::endl;
+        return 1;
+    }
+    csv << "bodies,moonsPerBody,asteroidsPerBelt,objects,asteroids,drawCallsPeak,buildMs,"
+        << "meanMs,p50Ms,p95Ms,p99Ms,worstMs,"
+        << "planetsCpuMs,planetsGpuMs,moonsCpuMs,moonsGpuMs,beltsCpuMs,beltsGpuMs,"
+        << "meshMB,rssMB,peakRssMB" << std::endl;
+    csv << std::fixed << std::setprecision(3);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "==================== STRESS SWEEP ====================" << std::endl;
+    std::cout << std::left << std::setw(24) << "bodies x moons x ast." << std::right
+        << std::setw(9) << "objects" << std::setw(10) << "build ms" << std::setw(10) << "mean ms"
+        << std::setw(10) << "p99 ms" << std::setw(10) << "mesh MB" << std::setw(10) << "rss MB" << std::endl;
+
+    std::vector<SweepPoint> points;
+    const float speedMultiplier = 1.0f;
+
+    for (int bodies : bodyCounts) {
+        for (int moonsPerBody : moonCounts) {
+            for (int asteroidsPerBelt : asteroidCounts) {
+                StressSceneConfig config;
+                config.bodies = bodies;
+                config.moonsPerBody = moonsPerBody;
+                config.asteroidsPerBelt = asteroidsPerBelt;
+
+                auto buildStart = std::chrono::high_resolution_clock::now();
+                std::unique_ptr<StressScene> scene(new StressScene(config));
+                glFinish();
+                std::chrono::duration<double, std::milli> buildTime = std::chrono::high_resolution_clock::now() - buildStart;
+
+                PassTimer passTimer;
+                FrameTimeReport frameTimes;
+                GLStats::resetFrameHistory();
+
+                int totalFrames = options.warmupFrames + options.frames;
+                for (int frameIndex = 0; frameIndex < totalFrames; ++frameIndex) {
+                    auto frameStart = std::chrono::high_resolution_clock::now();
+                    TRACE_SCOPE("Frame");
+
+                    offscreen.bind();
+                    passTimer.beginFrame();
+                    GLStats::beginFrame();
+                    SphereLodChain::beginFrame();
+
+                    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                    { PassScope pass(passTimer, "SkyBox+Sun"); drawFixedScene(view, projection, options.deltaTime); }
+                    scene->Draw(shading, passTimer, view, projection, options.deltaTime, cameraPos, speedMultiplier);
+
+                    passTimer.endFrame();
+                    GLStats::endFrame();
+
+                    glFinish();
+                    std::chrono::duration<double, std::milli> frameTime = std::chrono::high_resolution_clock::now() - frameStart;
+                    if (frameIndex >= options.warmupFrames) {
+                        frameTimes.addFrame(frameTime.count());
+                    }
+                    else if (frameIndex + 1 == options.warmupFrames) {
+                        GLStats::resetFrameHistory();
+                    }
+                }
+
+                size_t rssBytes = 0, peakRssBytes = 0;
+                queryProcessMemory(rssBytes, peakRssBytes);
+
+                std::vector<PassTiming> passes = passTimer.average();
+                double planetsCpu, planetsGpu, moonsCpu, moonsGpu, beltsCpu, beltsGpu;
+                findPass(passes, "StressScene::planets", planetsCpu, planetsGpu);
+                findPass(passes, "StressScene::moons", moonsCpu, moonsGpu);
+                findPass(passes, "StressScene::belts", beltsCpu, beltsGpu);
+
+                csv << bodies << "," << moonsPerBody << "," << asteroidsPerBelt << ","
+                    << scene->objectCount() << "," << scene->asteroidCount() << ",";
+                if (GLStats::isInstalled()) csv << GLStats::peakFrame().drawCalls;
+                csv << "," << buildTime.count() << ","
+                    << frameTimes.mean() << "," << frameTimes.percentile(50.0) << "," << frameTimes.percentile(95.0) << ","
+                    << frameTimes.percentile(99.0) << "," << frameTimes.worst() << ","
+                    << planetsCpu << "," << planetsGpu << "," << moonsCpu << "," << moonsGpu << "," << beltsCpu << "," << beltsGpu << ","
+                    << toMB(scene->meshBytes()) << "," << toMB(rssBytes) << "," << toMB(peakRssBytes) << std::endl;
+
+                std::ostringstream label;
+                label << bodies << " x " << moonsPerBody << " x " << asteroidsPerBelt;
+                std::cout << std::left << std::setw(24) << label.str() << std::right
+                    << std::setw(9) << scene->objectCount() << std::setw(10) << buildTime.count()
+                    << std::setw(10) << frameTimes.mean() << std::setw(10) << frameTimes.percentile(99.0)
+                    << std::setw(10) << toMB(scene->meshBytes()) << std::setw(10) << toMB(rssBytes) << std::endl;
+
+                points.push_back({ config, scene->objectCount(), frameTimes.mean() });
+            }
+        }
+    }
+
+    // Grafik: duzina trake je srazmerna prosecnom frejmu; ms/objekat pokazuje gde prestaje linearan rast
+    double slowest = 0.0;
+    for (const SweepPoint& point : points) slowest = std::max(slowest, point.meanMs);
+
+    const int chartWidth = 50;
+    std::cout << "-------------------- mean frame time -----------------" << std::endl;
+    for (const SweepPoint& point : points) {
+        std::ostringstream label;
+        label << point.config.bodies << " x " << point.config.moonsPerBody << " x " << point.config.asteroidsPerBelt;
+        int bar = slowest > 0.0 ? (int)std::lround(point.meanMs / slowest * chartWidth) : 0;
+        double perObject = point.objects > 0 ? point.meanMs * 1000.0 / point.objects : 0.0;
+
+        std::cout << std::left << std::setw(24) << label.str() << std::right << " |" << std::string(bar, '#')
+            << std::string(chartWidth - bar, ' ') << "| " << point.meanMs << " ms, " << perObject << " us/obj" << std::endl;
+    }
+    std::cout << "======================================================" << std::endl;
+    std::cout << "Sweep zapisan u " << options.sweepOutPath << std::endl;
+
+    return 0;
+}
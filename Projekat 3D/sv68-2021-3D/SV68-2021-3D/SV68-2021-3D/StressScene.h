@@ -0,0 +1,69 @@
+#ifndef STRESS_SCENE_H
+#define STRESS_SCENE_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <glm/glm.hpp>
+#include "Planet.h"
+#include "Moon.h"
+#include "AsteroidBelt.h"
+#include "PassTimer.h"
+#include "Benchmark.h"
+#include "CameraPath.h"
+
+// Velicina generisane scene
+struct StressSceneConfig {
+    int bodies = 9;                 // Tela koja kruze oko Sunca
+    int moonsPerBody = 2;
+    int asteroidsPerBelt = 700;     // 0 = bez pojaseva
+    unsigned int seed = FIXED_ASTEROID_SEED;
+};
+
+// Programi i teksture prave scene; teksture se telima dodeljuju redom (ciklicno)
+struct StressSceneShading {
+    GLuint planetProgram;
+    GLuint moonProgram;
+    GLuint asteroidProgram;
+    GLuint oortCloudProgram;
+    std::vector<TextureLayer> bodyTextures;     // Slojevi nizova iz TextureArrayManager
+    std::vector<TextureLayer> moonTextures;
+    GLuint asteroidTexture;
+};
+
+// N tela oko Sunca, M meseca po telu i 3 asteroidna pojasa sa po K asteroida.
+// Pravi se od istih klasa kao Suncev sistem (Planet, Moon, AsteroidBelt), pa meri isti put crtanja po objektu.
+// Raspored (poluprecnici, udaljenosti, brzine, faze) zavisi samo od seed-a.
+class StressScene {
+public:
+    explicit StressScene(const StressSceneConfig& config);
+    StressScene(const StressScene&) = delete;
+    StressScene& operator=(const StressScene&) = delete;
+
+    void Draw(const StressSceneShading& shading, PassTimer& passTimer, const glm::mat4& view, const glm::mat4& projection,
+        float deltaTime, glm::vec3 cameraPos, float speedMultiplier);
+
+    const StressSceneConfig& getConfig() const;
+    int objectCount() const;            // Tela + meseci + pojasevi (jedan instancirani poziv po pojasu)
+    long long asteroidCount() const;
+    size_t meshBytes() const;           // Procena GPU bafera: verteksi, indeksi i instance
+
+private:
+    StressSceneConfig config;
+    std::vector<std::unique_ptr<Planet>> planets;
+    std::vector<std::unique_ptr<Moon>> moons;
+    std::vector<std::unique_ptr<AsteroidBelt>> belts;
+};
+
+// Crta nebo i Sunce pre stres scene (view, projection, deltaTime)
+typedef std::function<void(const glm::mat4&, const glm::mat4&, float)> FixedSceneDrawer;
+
+// Pokrece sve kombinacije options.stressBodies x stressMoons x stressAsteroids redom.
+// Za svaku meri warmup + frames frejmova, pise red u CSV (options.sweepOutPath)
+// i na kraju ispisuje ASCII grafik prosecnog frejma. Vraca exit code benchmarka.
+int runStressSweep(const BenchmarkOptions& options, const OffscreenTarget& offscreen, const StressSceneShading& shading,
+    const FixedSceneDrawer& drawFixedScene, const glm::mat4& view, const glm::mat4& projection, glm::vec3 cameraPos);
+
+#endif // STRESS_SCENE_H
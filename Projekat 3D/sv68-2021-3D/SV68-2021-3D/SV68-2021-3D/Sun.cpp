@@ -3,107 +3,9 @@
 #include "Sun.h"
 
 Sun::Sun(float r, int sectors, int stacks)
-    : radius(r), sectorCount(sectors), stackCount(stacks) {
-    generateVertices();
-    generateIndices();
-    setupMesh();
+    : lods(sectors, stacks, SPHERE_UV_STANDARD), radius(r), sectorCount(sectors), stackCount(stacks) {
 }
 
-Sun::~Sun() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-}
-
-void Sun::generateVertices() {
-    float x, y, z, xy;
-    float s, t;
-    float sectorStep = (float)(2 * M_PI / sectorCount);
-    float stackStep = (float)(M_PI / stackCount);
-    float sectorAngle, stackAngle;
-
-    for (int i = 0; i <= stackCount; ++i) {
-        stackAngle = (float)(M_PI / 2 - i * stackStep);
-        xy = radius * cosf(stackAngle);
-        z = radius * sinf(stackAngle);
-
-        for (int j = 0; j <= sectorCount; ++j) {
-            sectorAngle = j * sectorStep;
-            x = xy * cosf(sectorAngle);
-            y = xy * sinf(sectorAngle);
-
-            // UV koordinate
-            s = (float)j / sectorCount;
-            t = (float)i / stackCount;
-
-            if (i == 0) t = 0.01f; // Avoid collapsing at the north pole
-            if (i == stackCount) t = 0.99f; // Avoid collapsing at the south pole
-
-            // Dodavanje verteksa
-            sphere_vertices.push_back(x);
-            sphere_vertices.push_back(y);
-            sphere_vertices.push_back(z);
-            sphere_vertices.push_back(s);
-            sphere_vertices.push_back(t);
-        }
-    }
-}
-
-void Sun::generateIndices() {
-    int k1, k2;
-    for (int i = 0; i < stackCount; ++i) {
-        k1 = i * (sectorCount + 1);
-        k2 = k1 + sectorCount + 1;
-
-        for (int j = 0; j < sectorCount; ++j, ++k1, ++k2) {
-            if (i != 0) {
-                sphere_indices.push_back(k1);
-                sphere_indices.push_back(k2);
-                sphere_indices.push_back(k1 + 1);
-            }
-            if (i != (stackCount - 1)) {
-                sphere_indices.push_back(k1 + 1);
-                sphere_indices.push_back(k2);
-                sphere_indices.push_back(k2 + 1);
-            }
-        }
-    }
-
-    // Zatvaranje donjeg pola
-    int bottomCenterIndex = (int)sphere_vertices.size() / 5 - 1;
-    int lastRowStart = bottomCenterIndex - sectorCount;
-    for (int j = 0; j < sectorCount; ++j) {
-        int next = (j == sectorCount - 1) ? lastRowStart : lastRowStart + j + 1;
-        sphere_indices.push_back(bottomCenterIndex);
-        sphere_indices.push_back(lastRowStart + j);
-        sphere_indices.push_back(next);
-    }
-}
-
-void Sun::setupMesh() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sphere_vertices.size() * sizeof(float), sphere_vertices.data(), GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sphere_indices.size() * sizeof(int), sphere_indices.data(), GL_DYNAMIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-
 void Sun::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, const glm::mat4& projection, float deltaTime, glm::vec3 cameraPos) {
     glUseProgram(shaderProgram);
 
@@ -115,6 +17,7 @@ void Sun::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, co
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));  // Sphere at origin
     modelMatrix = glm::rotate(modelMatrix, glm::radians(rotationAngle), glm::vec3(0.0f, 1.0f, 0.0f)); // Rotate around Y-axis
+    modelMatrix = glm::scale(modelMatrix, glm::vec3(radius));  // Jedinicna sfera iz MeshRegistry
 
     // **Send Matrices to Shader**
     GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
@@ -134,9 +37,10 @@ void Sun::Draw(GLuint shaderProgram, GLuint textureID, const glm::mat4& view, co
     glBindTexture(GL_TEXTURE_2D, textureID);
     glUniform1i(glGetUniformLocation(shaderProgram, "sunTexture"), 0);
 
-    // **Draw Sun**
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(sphere_indices.size()), GL_UNSIGNED_INT, 0);
+    // **Draw Sun** (LOD level by on-screen size)
+    const SphereMesh& mesh = lods.select(getPosition(), radius, cameraPos, projection);
+    glBindVertexArray(mesh.vertexArray());
+    glDrawElements(GL_TRIANGLES, mesh.indexCount(), mesh.indexType(), 0);
     glBindVertexArray(0);
 
     // **Unbind Texture**
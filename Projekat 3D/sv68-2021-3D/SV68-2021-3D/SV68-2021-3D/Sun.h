@@ -3,31 +3,27 @@
 
 #include <glad/glad.h>  // Must be first
 #include <GLFW/glfw3.h> // Then GLFW
+#include <memory>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "MeshRegistry.h"
 
 
 class Sun {
 private:
-    std::vector<float> sphere_vertices;
-    std::vector<int> sphere_indices;
-    GLuint VBO, VAO, EBO;
+    SphereLodChain lods;        // Jedinicne sfere po nivou detalja (MeshRegistry), bira se po velicini na ekranu
     float radius;
     int sectorCount;
     int stackCount;
     float rotationAngle = 0.0f; // Uglovi rotacije u stepenima
     float rotationSpeed = 10.0f; // Stepeni po sekundi
 
-    void generateVertices();
-    void generateIndices();
-    void setupMesh();
 
 public:
     Sun(float r, int sectors, int stacks);
-    ~Sun();
 
     glm::vec3 getPosition() const;
     float getRadius() const;
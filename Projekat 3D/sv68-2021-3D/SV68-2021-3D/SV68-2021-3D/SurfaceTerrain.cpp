@@ -0,0 +1,305 @@
+#include "SurfaceTerrain.h"
+#include "AssetPack.h"
+#include "GpuMemory.h"
+#include "Trace.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+const GLsizeiptr PATCH_BYTES = (GLsizeiptr)TERRAIN_PATCH_VERTICES * TERRAIN_PATCH_FLOATS * sizeof(float);
+const float MIN_NEAR_PLANE = 1e-4f;     // Ispod ovoga dubina na udaljenim telima vise ne razlikuje povrsine
+const float MIN_NEAR_DISTANCE = 1e-6f;  // U poluprecnicima tela, samo da deljenje ne ode u beskonacnost
+
+double nowMs() {
+    return Tracer::now() / 1.0e6;
+}
+
+// Svetlina slike kao visina; bez slike ostaje prazna mapa (glatka sfera)
+void loadHeightMap(const std::string& path, float scale, TerrainHeightMap& heights) {
+    if (path.empty()) return;
+    TRACE_SCOPE_DETAIL("loadHeightMap", path.c_str());
+
+    AssetData file = AssetPack::load(path);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = nullptr;
+    if (!file.empty()) {
+        stbi_set_flip_vertically_on_load_thread(false);     // Globalni flag menja i glavna nit (UiAtlas, ucitavanje tekstura)
+        pixels = stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &channels, 1);
+    }
+    if (!pixels) {
+        std::cerr << "SurfaceTerrain: ne mogu da ucitam " << path << ", povrsina ostaje glatka" << std::endl;
+        return;
+    }
+    heights.width = width;
+    heights.height = height;
+    heights.samples.assign(pixels, pixels + (size_t)width * height);
+    heights.scale = scale;
+    stbi_image_free(pixels);
+}
+
+}
+
+SurfaceTerrain::SurfaceTerrain(int viewportHeight, long long budgetBytes)
+    : pixelsPerUnitScale(viewportHeight * 0.5f), VAO(0), VBO(0), EBO(0), indexCount(0), stopping(false), frame(0),
+    lastPatchesDrawn(0), lastUploads(0), uploadsTotal(0), evictionsTotal(0), droppedTotal(0), builtTotal(0), buildMsTotal(0.0) {
+    GPU_MEMORY_OWNER("SurfaceTerrain");
+
+    int slotCount = std::max(TERRAIN_ROOT_PATCHES, (int)(budgetBytes / PATCH_BYTES));
+    slots.resize(slotCount);
+    freeSlots.reserve(slotCount);
+    for (int i = slotCount - 1; i >= 0; --i) freeSlots.push_back(i);
+
+    std::vector<unsigned short> indices;
+    generateTerrainPatchIndices(indices);
+    indexCount = (GLsizei)indices.size();
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindVertexArray(VAO);
+
+    // Ceo budzet odjednom; zakrpe se samo prepisuju u slotove, bafer nikad ne raste
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, slotCount * PATCH_BYTES, nullptr, GL_DYNAMIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, VBO, slotCount * PATCH_BYTES, "Terrain patches", GPU_MEMORY_SITE);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data(), GL_STATIC_DRAW);
+    GpuMemory::track(GPU_BUFFER, EBO, indices.size() * sizeof(unsigned short), "Terrain indices", GPU_MEMORY_SITE);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, TERRAIN_PATCH_FLOATS * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, TERRAIN_PATCH_FLOATS * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    for (int i = 0; i < WORKER_COUNT; ++i) {
+        workers.emplace_back(&SurfaceTerrain::workerLoop, this, i);
+    }
+}
+
+SurfaceTerrain::~SurfaceTerrain() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+
+    GpuMemory::release(GPU_BUFFER, VBO);
+    GpuMemory::release(GPU_BUFFER, EBO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+int SurfaceTerrain::addBody(const std::string& heightMapPath, float heightScale) {
+    std::unique_ptr<Body> body(new Body());
+    body->heightMapPath = heightMapPath;
+    body->heightScale = heightMapPath.empty() ? 0.0f : std::max(0.0f, heightScale);
+    bodies.push_back(std::move(body));
+    return (int)bodies.size() - 1;
+}
+
+void SurfaceTerrain::workerLoop(int index) {
+    std::string threadName = "terrain " + std::to_string(index);
+    Tracer::setThreadName(threadName.c_str());
+
+    while (true) {
+        uint64_t id;
+        Job job;
+        {
+            // Najveca greska na ekranu ide prva, pa se prvo popravlja ono sto se najvise vidi
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            auto best = jobs.begin();
+            for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+                if (it->second.priority > best->second.priority) best = it;
+            }
+            id = best->first;
+            job = best->second;
+            jobs.erase(best);
+            building.insert(id);
+        }
+
+        double start = nowMs();
+        BuiltPatch patch;
+        patch.id = id;
+        {
+            TRACE_SCOPE("generateTerrainPatch");
+            Body* body = job.body;
+            std::call_once(body->heightsLoaded, [body]() { loadHeightMap(body->heightMapPath, body->heightScale, body->heights); });
+            patch.info = generateTerrainPatch(job.key, &body->heights, job.parentError, patch.vertices);
+        }
+        double elapsedMs = nowMs() - start;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        built.push_back(std::move(patch));
+        builtTotal++;
+        buildMsTotal += elapsedMs;
+    }
+}
+
+void SurfaceTerrain::request(int body, const TerrainPatchKey& key, float priority, float parentError) {
+    uint64_t id = terrainPatchId(body, key);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (building.count(id)) return;
+        auto it = jobs.find(id);
+        if (it != jobs.end()) {
+            it->second.priority = priority;
+            it->second.requestedFrame = frame;
+            return;
+        }
+        jobs[id] = Job{ bodies[body].get(), key, priority, parentError, frame };
+    }
+    jobReady.notify_one();
+}
+
+const TerrainPatchInfo* SurfaceTerrain::findResident(int body, const TerrainPatchKey& key) {
+    auto it = resident.find(terrainPatchId(body, key));
+    if (it == resident.end()) return nullptr;
+    slots[it->second].lastUsedFrame = frame;
+    return &slots[it->second].info;
+}
+
+// Slobodan slot, ili onaj koji najduze nije crtan; zakrpe iz proslog frejma se ne diraju (trebaju i sada)
+int SurfaceTerrain::allocateSlot() {
+    if (!freeSlots.empty()) {
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    int oldest = -1;
+    for (int i = 0; i < (int)slots.size(); ++i) {
+        if (slots[i].lastUsedFrame >= frame - 1) continue;
+        if (oldest < 0 || slots[i].lastUsedFrame < slots[oldest].lastUsedFrame) oldest = i;
+    }
+    if (oldest < 0) return -1;
+    resident.erase(slots[oldest].id);
+    evictionsTotal++;
+    return oldest;
+}
+
+void SurfaceTerrain::upload(BuiltPatch& patch) {
+    if (resident.count(patch.id)) return;
+    int slot = allocateSlot();
+    if (slot < 0) {
+        droppedTotal++;
+        return;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, slot * PATCH_BYTES, PATCH_BYTES, patch.vertices.data());
+    slots[slot].id = patch.id;
+    slots[slot].lastUsedFrame = frame;
+    slots[slot].info = patch.info;
+    resident[patch.id] = slot;
+    uploadsTotal++;
+    lastUploads++;
+}
+
+void SurfaceTerrain::beginFrame() {
+    frame++;
+    lastPatchesDrawn = 0;
+    lastUploads = 0;
+
+    std::vector<BuiltPatch> arrived;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Zahtev koji prosli frejm nije ponovio vise nikome ne treba (kamera je otisla dalje)
+        for (auto it = jobs.begin(); it != jobs.end();) {
+            if (it->second.requestedFrame < frame - 1) it = jobs.erase(it);
+            else ++it;
+        }
+        while (!built.empty() && (int)arrived.size() < UPLOADS_PER_FRAME) {
+            building.erase(built.front().id);
+            arrived.push_back(std::move(built.front()));
+            built.pop_front();
+        }
+    }
+    if (arrived.empty()) return;
+
+    TRACE_SCOPE("SurfaceTerrain::upload");
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    for (BuiltPatch& patch : arrived) upload(patch);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool SurfaceTerrain::draw(int body, const glm::mat4& model, const glm::vec3& center, float worldRadius, const glm::vec3& cameraPos,
+    const glm::mat4& view, const glm::mat4& projection) {
+    Body& state = *bodies[body];
+    float altitude = glm::length(cameraPos - center) - worldRadius;
+    state.clearance = altitude - state.heightScale * worldRadius;
+
+    float activation = ACTIVATION_RADII * worldRadius;
+    state.active = altitude < (state.active ? activation * DEACTIVATION_FACTOR : activation);
+    if (!state.active) return false;
+
+    TRACE_SCOPE("SurfaceTerrain::draw");
+
+    // Dok svi koreni ne stignu telo ostaje obicna sfera; koreni imaju prednost pred svim ostalim
+    bool rootsReady = true;
+    for (int root = 0; root < TERRAIN_ROOT_PATCHES; ++root) {
+        TerrainPatchKey key = terrainRootPatch(root);
+        if (!findResident(body, key)) {
+            rootsReady = false;
+            request(body, key, std::numeric_limits<float>::max(), 0.0f);
+        }
+    }
+    if (!rootsReady) return false;
+
+    // Bliska ravan iz perspektivne matrice (n = P[3][2] / (P[2][2] - 1)), u poluprecnicima tela
+    float nearLocal = std::max(projection[3][2] / (projection[2][2] - 1.0f) / worldRadius, MIN_NEAR_DISTANCE);
+    glm::vec3 cameraLocal = glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f));
+    selectTerrainPatches(cameraLocal, projection * view * model, projection[1][1] * pixelsPerUnitScale, nearLocal, state.heightScale,
+        [this, body](const TerrainPatchKey& key) { return findResident(body, key); }, draws, requests);
+    for (const TerrainRequest& missing : requests) request(body, missing.key, missing.priority, missing.parentError);
+
+    glBindVertexArray(VAO);
+    for (const TerrainPatchKey& key : draws) {
+        int slot = resident[terrainPatchId(body, key)];
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0, slot * TERRAIN_PATCH_VERTICES);
+    }
+    glBindVertexArray(0);
+    lastPatchesDrawn += (int)draws.size();
+    return true;
+}
+
+float SurfaceTerrain::nearPlane(float defaultNear) const {
+    float nearest = defaultNear;
+    for (const std::unique_ptr<Body>& body : bodies) {
+        if (body->active) nearest = std::min(nearest, 0.5f * body->clearance);
+    }
+    return std::max(nearest, MIN_NEAR_PLANE);
+}
+
+void SurfaceTerrain::print(std::ostream& out) const {
+    int active = 0;
+    for (const std::unique_ptr<Body>& body : bodies) active += body->active ? 1 : 0;
+    size_t pending, waiting;
+    long long built;
+    double buildMs;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = jobs.size();
+        waiting = building.size();
+        built = builtTotal;
+        buildMs = buildMsTotal;
+    }
+
+    out << std::fixed << std::setprecision(2);
+    out << "SurfaceTerrain: " << bodies.size() << " tela (" << active << " izbliza), " << resident.size() << "/" << slots.size()
+        << " slotova (" << resident.size() * PATCH_BYTES / (1024.0 * 1024.0) << " od " << slots.size() * PATCH_BYTES / (1024.0 * 1024.0)
+        << " MB), poslednji frejm " << lastPatchesDrawn << " zakrpa, " << lastUploads << " poslato" << std::endl;
+    out << "SurfaceTerrain: napravljeno " << built << " zakrpa (" << (built > 0 ? buildMs / built : 0.0) << " ms po zakrpi), poslato "
+        << uploadsTotal << ", izbaceno " << evictionsTotal << ", bez slota " << droppedTotal << ", ceka " << pending
+        << " + " << waiting << " u izradi" << std::endl;
+    out << std::defaultfloat;
+}
@@ -0,0 +1,135 @@
+#ifndef SURFACE_TERRAIN_H
+#define SURFACE_TERRAIN_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "TerrainQuadtree.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Povrsina tela izbliza: umesto jedne sfere iz SphereLodChain crta se quadtree zakrpa (TerrainQuadtree)
+// koje se dele po gresci na ekranu. Zakrpe se prave na pozadinskim nitima i salju u jedan VBO fiksne
+// velicine (budgetBytes), podeljen na slotove od po jedne zakrpe; kad slotova nema, izbacuje se zakrpa
+// koja najduze nije koriscena. Zakrpa se deli tek kad su joj deca na GPU-u, pa slika nema rupa, samo
+// nekoliko frejmova grublju povrsinu dok stizu.
+//
+//   SurfaceTerrain terrain(screenHeight);
+//   int body = terrain.addBody("earth-tex.jpg", 0.01f);      // Visine iz svetline slike; "" = glatka sfera
+//   terrain.beginFrame();                                     // Svakog frejma, glavna nit
+//   if (!terrain.draw(body, model, position, worldRadius, cameraPos, view, projection)) { /* obicna sfera */ }
+//
+// Telo placa samo dok je kamera blize od ACTIVATION_RADII poluprecnika od povrsine; dalje
+// draw vraca false odmah, a zakrpe tela ostaju u baferu dok ih druge ne istisnu.
+// Crta se sejderom i uniformima koje je telo vec postavilo (atributi 0 = pozicija, 1 = UV, kao SphereMesh).
+class SurfaceTerrain {
+public:
+    static const long long DEFAULT_BUDGET_BYTES = 8LL * 1024 * 1024;
+    static const int UPLOADS_PER_FRAME = 16;        // ~110 KB glBufferSubData po frejmu najvise
+    static const int WORKER_COUNT = 2;
+
+    // Visina iznad povrsine (u poluprecnicima tela) ispod koje telo prelazi na zakrpe; nazad tek na 1.2x toga
+    static constexpr float ACTIVATION_RADII = 2.0f;
+    static constexpr float DEACTIVATION_FACTOR = 1.2f;
+
+    explicit SurfaceTerrain(int viewportHeight, long long budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~SurfaceTerrain();
+    SurfaceTerrain(const SurfaceTerrain&) = delete;
+    SurfaceTerrain& operator=(const SurfaceTerrain&) = delete;
+
+    // heightMapPath: slika u SPHERE_UV_PLANET rasporedu (svetlina = visina), cita se na radnoj niti tek kad se
+    // telo prvi put priblizi; heightScale je najveca visina u poluprecnicima. Vraca broj tela za draw()
+    int addBody(const std::string& heightMapPath, float heightScale);
+
+    // Glavna nit: salje najvise UPLOADS_PER_FRAME gotovih zakrpa i zaboravlja zahteve koje niko vise ne trazi
+    void beginFrame();
+
+    // Crta zakrpe tela (model preslikava jedinicnu sferu, worldRadius je poluprecnik u svetu). false = telo je
+    // daleko ili koreni jos nisu stigli - crta se obicna sfera
+    bool draw(int body, const glm::mat4& model, const glm::vec3& center, float worldRadius, const glm::vec3& cameraPos,
+        const glm::mat4& view, const glm::mat4& projection);
+
+    // Bliza ravan odsecanja za sledeci frejm: pola visine kamere iznad najviseg vrha najblizeg aktivnog tela,
+    // najvise defaultNear i najmanje 1e-4. Ispod visine 2e-4 (u svetu) iznad vrhova, ili kroz planinu, bliska
+    // ravan sece tlo i vidi se kroz povrsinu; deljenje zakrpa staje na nivou koji ta ravan jos moze da pokaze
+    float nearPlane(float defaultNear) const;
+
+    void print(std::ostream& out) const;
+
+private:
+    struct Body {
+        std::string heightMapPath;
+        TerrainHeightMap heights;       // Puni ga prva radna nit koja pravi zakrpu tela (heightsLoaded)
+        std::once_flag heightsLoaded;
+        float heightScale;
+        bool active = false;
+        float clearance = 0.0f;         // Visina kamere iznad najviseg vrha u svetu, poslednji draw
+    };
+
+    struct Slot {
+        uint64_t id = 0;
+        int lastUsedFrame = -1;
+        TerrainPatchInfo info;          // Izmerena greska i visine zakrpe, za selectTerrainPatches
+    };
+
+    struct Job {
+        Body* body;                     // Telo ima stalnu adresu (unique_ptr), pa radna nit ne dira vektor bodies
+        TerrainPatchKey key;
+        float priority;
+        float parentError;
+        int requestedFrame;
+    };
+
+    struct BuiltPatch {
+        uint64_t id;
+        TerrainPatchInfo info;
+        std::vector<float> vertices;
+    };
+
+    std::vector<std::unique_ptr<Body>> bodies;
+    float pixelsPerUnitScale;           // Visina viewport-a / 2; puta projection[1][1] daje pixelsPerUnit
+
+    GLuint VAO, VBO, EBO;
+    GLsizei indexCount;
+    std::vector<Slot> slots;
+    std::vector<int> freeSlots;
+    std::unordered_map<uint64_t, int> resident;    // Zakrpa -> slot
+
+    std::vector<std::thread> workers;
+    std::unordered_map<uint64_t, Job> jobs;         // Trazeno, jos nije uzeto
+    std::unordered_set<uint64_t> building;          // Uzeto ili gotovo, a jos nije poslato
+    std::deque<BuiltPatch> built;
+    mutable std::mutex mutex;
+    std::condition_variable jobReady;
+    bool stopping;
+
+    int frame;
+    std::vector<TerrainPatchKey> draws;
+    std::vector<TerrainRequest> requests;
+
+    // Statistika za print()
+    int lastPatchesDrawn;
+    int lastUploads;
+    long long uploadsTotal;
+    long long evictionsTotal;
+    long long droppedTotal;             // Gotove zakrpe za koje nije bilo slota
+    long long builtTotal;
+    double buildMsTotal;
+
+    void workerLoop(int index);
+    void request(int body, const TerrainPatchKey& key, float priority, float parentError);
+    const TerrainPatchInfo* findResident(int body, const TerrainPatchKey& key);
+    int allocateSlot();
+    void upload(BuiltPatch& patch);
+};
+
+#endif // SURFACE_TERRAIN_H
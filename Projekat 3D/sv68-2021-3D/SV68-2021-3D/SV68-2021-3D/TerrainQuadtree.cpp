@@ -0,0 +1,332 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <algorithm>
+#include "TerrainQuadtree.h"
+#include "Frustum.h"
+
+namespace {
+
+const int R = TERRAIN_PATCH_RESOLUTION;
+const float BOUNDS_SLACK = 1.01f;           // Ivice izmedju uzoraka granica mogu malo da izadju
+
+// Greska se meri na sub x sub tacaka po celiji: po jedna na teksel mape visina, bar sredina celije
+const int MIN_ERROR_SUBSAMPLES = 2;
+const int MAX_ERROR_SUBSAMPLES = 8;
+const float POSITION_PRECISION = 1e-6f;     // float pozicija oko poluprecnika 1; na dubokim nivoima veca od ugiba
+
+// Normala strane i dve ose u ravni (a x b = normala, pa je mreza CCW spolja)
+void faceAxes(int face, glm::vec3& normal, glm::vec3& a, glm::vec3& b) {
+    switch (face) {
+    case 0: normal = glm::vec3(1, 0, 0); a = glm::vec3(0, 0, -1); b = glm::vec3(0, 1, 0); break;
+    case 1: normal = glm::vec3(-1, 0, 0); a = glm::vec3(0, 0, 1); b = glm::vec3(0, 1, 0); break;
+    case 2: normal = glm::vec3(0, 1, 0); a = glm::vec3(1, 0, 0); b = glm::vec3(0, 0, -1); break;
+    case 3: normal = glm::vec3(0, -1, 0); a = glm::vec3(1, 0, 0); b = glm::vec3(0, 0, 1); break;
+    case 4: normal = glm::vec3(0, 0, 1); a = glm::vec3(1, 0, 0); b = glm::vec3(0, 1, 0); break;
+    default: normal = glm::vec3(0, 0, -1); a = glm::vec3(-1, 0, 0); b = glm::vec3(0, 1, 0); break;
+    }
+}
+
+// (u, v) strane za relativnu tacku (fx, fy) iz [0, 1]^2 zakrpe
+glm::vec2 patchUV(const TerrainPatchKey& key, float fx, float fy) {
+    float size = 2.0f / (float)(1 << key.level);
+    return glm::vec2(-1.0f + (key.x + fx) * size, -1.0f + (key.y + fy) * size);
+}
+
+glm::vec3 patchDirection(const TerrainPatchKey& key, float fx, float fy) {
+    glm::vec2 uv = patchUV(key, fx, fy);
+    return cubeToSphere(key.face, uv.x, uv.y);
+}
+
+// Ugaona velicina celije zakrpe na nivou (strana kocke pokriva ~90 stepeni)
+float cellAngle(int level) {
+    return 0.5f * (float)M_PI / (float)(1 << level) / (R - 1);
+}
+
+float longitudeS(const glm::vec3& direction) {
+    float angle = std::atan2(direction.x, direction.y);
+    if (angle < 0.0f) angle += 2.0f * (float)M_PI;
+    return angle / (2.0f * (float)M_PI);
+}
+
+float latitudeT(const glm::vec3& direction) {
+    return 0.5f + std::asin(glm::clamp(direction.z, -1.0f, 1.0f)) / (float)M_PI;
+}
+
+// Pravac, s i t povrsine u tacki (fx, fy) zakrpe
+void surfaceDirection(const TerrainPatchKey& key, float fx, float fy, float centerS, glm::vec3& direction, float& s, float& t) {
+    direction = glm::normalize(patchDirection(key, fx, fy));
+
+    // Na polu geografska duzina nije definisana; uzima se ona iz sredine zakrpe
+    s = std::abs(direction.x) < 1e-7f && std::abs(direction.y) < 1e-7f ? centerS : longitudeS(direction);
+    s += std::round(centerS - s);
+    t = latitudeT(direction);
+}
+
+float surfaceRadius(const TerrainHeightMap* heights, float heightScale, float s, float t) {
+    return 1.0f + (heightScale > 0.0f ? heightScale * heights->sample(s, t) : 0.0f);
+}
+
+// Verteks mreze na k-tom mestu ivice e; ivice idu CCW oko zakrpe (dole, desno, gore, levo)
+int edgeVertex(int edge, int k) {
+    switch (edge) {
+    case 0: return k;
+    case 1: return k * R + (R - 1);
+    case 2: return (R - 1) * R + (R - 1 - k);
+    default: return (R - 1 - k) * R;
+    }
+}
+
+}
+
+uint64_t terrainPatchId(int body, const TerrainPatchKey& key) {
+    // 16 bita telo, 3 strana, 5 nivo, po 20 bita x i y (dovoljno do nivoa 20)
+    return ((uint64_t)(body & 0xFFFF) << 48) | ((uint64_t)key.face << 45) | ((uint64_t)key.level << 40)
+        | ((uint64_t)key.x << 20) | (uint64_t)key.y;
+}
+
+float TerrainHeightMap::sample(float s, float t) const {
+    if (samples.empty()) return 0.0f;
+    float fx = (s - std::floor(s)) * width - 0.5f;
+    float fy = glm::clamp((1.0f - t) * height - 0.5f, 0.0f, (float)(height - 1));
+    int x0 = (int)std::floor(fx);
+    int y0 = (int)fy;
+    float ax = fx - x0;
+    float ay = fy - y0;
+    int x1 = x0 + 1;
+    int y1 = std::min(y0 + 1, height - 1);
+    x0 = (x0 % width + width) % width;
+    x1 = x1 % width;
+
+    const unsigned char* row0 = samples.data() + (size_t)y0 * width;
+    const unsigned char* row1 = samples.data() + (size_t)y1 * width;
+    float top = row0[x0] + (row0[x1] - row0[x0]) * ax;
+    float bottom = row1[x0] + (row1[x1] - row1[x0]) * ax;
+    return (top + (bottom - top) * ay) / 255.0f;
+}
+
+glm::vec3 cubeToSphere(int face, float u, float v) {
+    glm::vec3 normal, a, b;
+    faceAxes(face, normal, a, b);
+    glm::vec3 p = normal + a * u + b * v;
+    glm::vec3 p2 = p * p;
+    return glm::vec3(
+        p.x * std::sqrt(std::max(0.0f, 1.0f - p2.y * 0.5f - p2.z * 0.5f + p2.y * p2.z / 3.0f)),
+        p.y * std::sqrt(std::max(0.0f, 1.0f - p2.z * 0.5f - p2.x * 0.5f + p2.z * p2.x / 3.0f)),
+        p.z * std::sqrt(std::max(0.0f, 1.0f - p2.x * 0.5f - p2.y * 0.5f + p2.x * p2.y / 3.0f)));
+}
+
+TerrainPatchKey terrainRootPatch(int index) {
+    return TerrainPatchKey{ index / 4, TERRAIN_ROOT_LEVEL, index & 1, (index >> 1) & 1 };
+}
+
+float terrainPatchMaxError(int level, float heightScale) {
+    // Ugib trougla je oko (dijagonala)^2 / 8, a celije kocke projektovane na sferu su do ~1.5x cellAngle
+    float cell = cellAngle(level);
+    return cell * cell + heightScale + POSITION_PRECISION;
+}
+
+float terrainSkirtDepth(float error, float parentError) {
+    return 2.0f * std::max(error, parentError);
+}
+
+TerrainPatchInfo generateTerrainPatch(const TerrainPatchKey& key, const TerrainHeightMap* heights, float parentError,
+    std::vector<float>& vertices) {
+    vertices.resize((size_t)TERRAIN_PATCH_VERTICES * TERRAIN_PATCH_FLOATS);
+    float heightScale = heights && !heights->empty() ? heights->scale : 0.0f;
+    float centerS = longitudeS(patchDirection(key, 0.5f, 0.5f));
+
+    TerrainPatchInfo info{ 0.0f, 1.0f + heightScale, 1.0f };
+    float* out = vertices.data();
+    for (int j = 0; j < R; ++j) {
+        for (int i = 0; i < R; ++i) {
+            glm::vec3 direction;
+            float s, t;
+            surfaceDirection(key, (float)i / (R - 1), (float)j / (R - 1), centerS, direction, s, t);
+            float radius = surfaceRadius(heights, heightScale, s, t);
+            info.lowest = std::min(info.lowest, radius);
+            info.highest = std::max(info.highest, radius);
+
+            glm::vec3 position = direction * radius;
+            out[0] = position.x; out[1] = position.y; out[2] = position.z;
+            out[3] = s; out[4] = t;
+            out += TERRAIN_PATCH_FLOATS;
+        }
+    }
+    const float* grid = vertices.data();
+
+    // Greska: u tackama izmedju verteksa, koliko je trougao (presek zraka iz centra sa njegovom ravni)
+    // daleko od povrsine. Hvata i ugib tetive i visine koje mreza ovog nivoa preskace
+    int sub = MIN_ERROR_SUBSAMPLES;
+    if (heightScale > 0.0f) {
+        float texelsPerCell = cellAngle(key.level) * heights->width / (2.0f * (float)M_PI);
+        sub = glm::clamp((int)std::ceil(texelsPerCell), MIN_ERROR_SUBSAMPLES, MAX_ERROR_SUBSAMPLES);
+    }
+    auto gridPosition = [grid](int i, int j) {
+        const float* vertex = grid + (size_t)(j * R + i) * TERRAIN_PATCH_FLOATS;
+        return glm::vec3(vertex[0], vertex[1], vertex[2]);
+    };
+    int fine = (R - 1) * sub;
+    for (int fj = 0; fj <= fine; ++fj) {
+        for (int fi = 0; fi <= fine; ++fi) {
+            if (fi % sub == 0 && fj % sub == 0) continue;       // Verteks mreze
+            int i = std::min(fi / sub, R - 2);
+            int j = std::min(fj / sub, R - 2);
+
+            // Celija je podeljena dijagonalom v00-v11 kao u generateTerrainPatchIndices
+            bool lower = fi - i * sub >= fj - j * sub;
+            glm::vec3 p0 = gridPosition(i, j);
+            glm::vec3 p1 = lower ? gridPosition(i + 1, j) : gridPosition(i + 1, j + 1);
+            glm::vec3 p2 = lower ? gridPosition(i + 1, j + 1) : gridPosition(i, j + 1);
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+
+            glm::vec3 direction;
+            float s, t;
+            surfaceDirection(key, (float)fi / fine, (float)fj / fine, centerS, direction, s, t);
+            float along = glm::dot(normal, direction);
+            if (along <= 0.0f) continue;
+            float radius = surfaceRadius(heights, heightScale, s, t);
+            info.error = std::max(info.error, std::abs(glm::dot(normal, direction * radius - p0)) / along);
+            info.lowest = std::min(info.lowest, radius);
+            info.highest = std::max(info.highest, radius);
+        }
+    }
+
+    // Suknja: kopija ivice spustena ka centru (terrainSkirtDepth)
+    float skirt = 1.0f - terrainSkirtDepth(info.error, parentError);
+    for (int edge = 0; edge < 4; ++edge) {
+        for (int k = 0; k < R; ++k) {
+            const float* source = grid + (size_t)edgeVertex(edge, k) * TERRAIN_PATCH_FLOATS;
+            out[0] = source[0] * skirt; out[1] = source[1] * skirt; out[2] = source[2] * skirt;
+            out[3] = source[3]; out[4] = source[4];
+            out += TERRAIN_PATCH_FLOATS;
+        }
+    }
+    return info;
+}
+
+void generateTerrainPatchIndices(std::vector<unsigned short>& indices) {
+    indices.clear();
+    indices.reserve((size_t)(R - 1) * (R - 1) * 6 + 4 * (R - 1) * 6);
+    for (int j = 0; j < R - 1; ++j) {
+        for (int i = 0; i < R - 1; ++i) {
+            unsigned short v00 = (unsigned short)(j * R + i);
+            unsigned short v10 = v00 + 1;
+            unsigned short v01 = v00 + R;
+            unsigned short v11 = v01 + 1;
+            indices.insert(indices.end(), { v00, v10, v11, v00, v11, v01 });
+        }
+    }
+    // Ivica A -> B ide CCW oko zakrpe, pa je spoljna strana zida suknje desno od nje
+    for (int edge = 0; edge < 4; ++edge) {
+        for (int k = 0; k < R - 1; ++k) {
+            unsigned short a = (unsigned short)edgeVertex(edge, k);
+            unsigned short b = (unsigned short)edgeVertex(edge, k + 1);
+            unsigned short lowA = (unsigned short)(R * R + edge * R + k);
+            unsigned short lowB = lowA + 1;
+            indices.insert(indices.end(), { a, lowA, lowB, a, lowB, b });
+        }
+    }
+}
+
+TerrainPatchBounds terrainPatchBounds(const TerrainPatchKey& key, float lowest, float highest) {
+    TerrainPatchBounds bounds;
+    bounds.direction = glm::normalize(patchDirection(key, 0.5f, 0.5f));
+
+    float nearest = highest;        // Duz pravca sredine; sredina je najdalja tacka
+    float lateral = 0.0f;
+    float minCos = 1.0f;
+    for (int j = 0; j <= 2; ++j) {
+        for (int i = 0; i <= 2; ++i) {
+            glm::vec3 direction = glm::normalize(patchDirection(key, i * 0.5f, j * 0.5f));
+            float along = glm::dot(direction, bounds.direction);
+            nearest = std::min(nearest, along * lowest);
+            lateral = std::max(lateral, glm::length(direction - bounds.direction * along) * highest);
+            minCos = std::min(minCos, along);
+        }
+    }
+
+    float halfDepth = 0.5f * (highest - nearest);
+    bounds.center = bounds.direction * (0.5f * (highest + nearest));
+    bounds.radius = std::sqrt(halfDepth * halfDepth + lateral * lateral) * BOUNDS_SLACK;
+    bounds.coneAngle = std::acos(glm::clamp(minCos, -1.0f, 1.0f)) * BOUNDS_SLACK;
+    return bounds;
+}
+
+void selectTerrainPatches(const glm::vec3& cameraLocal, const glm::mat4& modelViewProjection, float pixelsPerUnit,
+    float nearDistance, float heightScale, const std::function<const TerrainPatchInfo*(const TerrainPatchKey&)>& findResident,
+    std::vector<TerrainPatchKey>& draws, std::vector<TerrainRequest>& requests) {
+    draws.clear();
+    requests.clear();
+
+    Frustum frustum(modelViewProjection);
+    float cameraDistance = glm::length(cameraLocal);
+    float highest = 1.0f + heightScale;
+
+    // Ugao od tacke ispod kamere do horizonta, plus koliko se najvisi vrh vidi preko njega
+    bool useHorizon = cameraDistance > highest;
+    float horizonAngle = useHorizon ? std::acos(1.0f / cameraDistance) + std::acos(1.0f / highest) : 0.0f;
+    glm::vec3 cameraDirection = cameraDistance > 0.0f ? cameraLocal / cameraDistance : glm::vec3(0.0f, 0.0f, 1.0f);
+
+    // Granice iz izmerenih visina zakrpe; za zakrpu koje jos nema najgore sto izmerene mogu biti (sadrze izmerene)
+    auto patchBounds = [&](const TerrainPatchKey& key, const TerrainPatchInfo* info, float parentError) {
+        if (!info) {
+            float skirt = terrainSkirtDepth(terrainPatchMaxError(key.level, heightScale), parentError);
+            return terrainPatchBounds(key, 1.0f - skirt, highest);
+        }
+        return terrainPatchBounds(key, info->lowest * (1.0f - terrainSkirtDepth(info->error, parentError)), info->highest);
+    };
+    auto isVisible = [&](const TerrainPatchBounds& bounds) {
+        if (!frustum.intersectsSphere(bounds.center, bounds.radius)) return false;
+        if (!useHorizon) return true;
+        float angle = std::acos(glm::clamp(glm::dot(bounds.direction, cameraDirection), -1.0f, 1.0f));
+        return angle - bounds.coneAngle <= horizonAngle;
+    };
+
+    struct Visit {
+        TerrainPatchKey key;
+        const TerrainPatchInfo* info;
+        float parentError;
+    };
+    std::vector<Visit> stack;
+    for (int root = TERRAIN_ROOT_PATCHES - 1; root >= 0; --root) {
+        TerrainPatchKey key = terrainRootPatch(root);
+        stack.push_back(Visit{ key, findResident(key), 0.0f });
+    }
+
+    while (!stack.empty()) {
+        Visit visit = stack.back();
+        stack.pop_back();
+        if (!visit.info) continue;          // Koren koji jos nije stigao
+
+        TerrainPatchBounds bounds = patchBounds(visit.key, visit.info, visit.parentError);
+        if (!isVisible(bounds)) continue;
+
+        const TerrainPatchKey& key = visit.key;
+        float error = visit.info->error;
+        // Blize od bliske ravni se nista ne vidi, pa se ni greska ne gleda izblize
+        float distance = std::max(glm::length(cameraLocal - bounds.center) - bounds.radius, nearDistance);
+        float pixels = error / distance * pixelsPerUnit;
+        if (pixels > TERRAIN_MAX_PIXEL_ERROR && key.level < TERRAIN_MAX_LEVEL) {
+            // Deca van kadra ne moraju biti spremna - ionako se ne crtaju. Vidljivost po najgorim granicama,
+            // pa se ne dira (ni ne cuva od izbacivanja) dete koje se sigurno ne vidi
+            Visit children[4];
+            int visible = 0;
+            bool allResident = true;
+            for (int c = 0; c < 4; ++c) {
+                TerrainPatchKey child{ key.face, key.level + 1, key.x * 2 + (c & 1), key.y * 2 + (c >> 1) };
+                if (!isVisible(patchBounds(child, nullptr, error))) continue;
+                const TerrainPatchInfo* childInfo = findResident(child);
+                children[visible++] = Visit{ child, childInfo, error };
+                if (!childInfo) {
+                    allResident = false;
+                    requests.push_back(TerrainRequest{ child, pixels, error });
+                }
+            }
+            if (allResident) {
+                while (visible > 0) stack.push_back(children[--visible]);
+                continue;
+            }
+        }
+        draws.push_back(key);
+    }
+}
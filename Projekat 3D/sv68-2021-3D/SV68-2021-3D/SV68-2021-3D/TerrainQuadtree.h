@@ -0,0 +1,106 @@
+#ifndef TERRAIN_QUADTREE_H
+#define TERRAIN_QUADTREE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Povrsina tela izbliza kao quadtree zakrpa na kocki projektovanoj na sferu, bez OpenGL poziva -
+// koristi ga SurfaceTerrain. Sve je u prostoru modela jedinicne sfere (kao SphereMesh), pa
+// UV raspored odgovara SPHERE_UV_PLANET i tekstura tela se lepi bez promene sejdera.
+
+const int TERRAIN_PATCH_RESOLUTION = 17;        // Verteksa po ivici zakrpe (16 x 16 celija)
+const int TERRAIN_PATCH_VERTICES = TERRAIN_PATCH_RESOLUTION * TERRAIN_PATCH_RESOLUTION + 4 * TERRAIN_PATCH_RESOLUTION;  // Mreza + suknja
+const int TERRAIN_PATCH_FLOATS = 5;             // x, y, z, s, t po verteksu
+const int TERRAIN_MAX_LEVEL = 12;               // Celija najsitnijeg nivoa je ~1e-5 poluprecnika
+
+// Koreni su na nivou 1 (4 po strani): pol je tada uvek ugao zakrpe, pa s nigde ne preskace
+// preko cele zakrpe (na nivou 0 pol je usred +Z i -Z strane)
+const int TERRAIN_ROOT_LEVEL = 1;
+const int TERRAIN_ROOT_PATCHES = 24;
+
+// Zakrpa se deli kad joj geometrijska greska na ekranu predje ovoliko piksela
+const float TERRAIN_MAX_PIXEL_ERROR = 1.0f;
+
+// Zakrpa: strana kocke (0..5 = +X, -X, +Y, -Y, +Z, -Z), nivo i polje (x, y) u mrezi 2^level x 2^level
+struct TerrainPatchKey {
+    int face;
+    int level;
+    int x;
+    int y;
+};
+
+// Jedinstven broj zakrpe (za mape), body u gornjih 16 bita
+uint64_t terrainPatchId(int body, const TerrainPatchKey& key);
+
+// Visine iz slike u SPHERE_UV_PLANET rasporedu (red 0 = gornja ivica slike, t = 1); prazna mapa = glatka sfera
+struct TerrainHeightMap {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> samples;     // Jedan kanal, 0 = poluprecnik 1, 255 = 1 + scale
+    float scale = 0.0f;                     // U jedinicama poluprecnika
+
+    bool empty() const { return samples.empty(); }
+    float sample(float s, float t) const;   // 0..1, bilinearno; s se ponavlja, t se odseca
+};
+
+TerrainPatchKey terrainRootPatch(int index);       // index iz [0, TERRAIN_ROOT_PATCHES)
+
+// Tacka (u, v) iz [-1, 1]^2 strane kocke kao jedinicni pravac; preslikavanje ujednacava povrsinu celija
+glm::vec3 cubeToSphere(int face, float u, float v);
+
+// Ono sto generateTerrainPatch izmeri o zakrpi, u jedinicama poluprecnika
+struct TerrainPatchInfo {
+    float error;                // Najvece odstupanje trouglova od povrsine sa visinama, uzorkovano gusce od mreze
+    float lowest;               // Najmanji i najveci poluprecnik povrsine na zakrpi (bez suknje)
+    float highest;
+};
+
+// Gornja granica za TerrainPatchInfo::error: cela visina plus ugib tetive celije (i zaokruzivanje float-a).
+// Vazi i za zakrpu koja jos nije napravljena
+float terrainPatchMaxError(int level, float heightScale);
+
+// Dubina suknje: pukotina prema susedu je najvise zbir gresaka obe strane, a sused je najcesce nivo
+// roditelja, pa suknja pokriva dvostruku vecu od greske zakrpe i roditelja
+float terrainSkirtDepth(float error, float parentError);
+
+// TERRAIN_PATCH_VERTICES verteksa (TERRAIN_PATCH_FLOATS float-ova) zakrpe: mreza red po red, pa po
+// TERRAIN_PATCH_RESOLUTION verteksa suknje za svaku ivicu, spustenih za terrainSkirtDepth da pokriju pukotine
+// izmedju susednih nivoa. s je odmotan oko sredine zakrpe, pa sav prelaz preko sava ide kroz GL_REPEAT.
+// Gresku meri o visinama gusce od mreze (do po jedan uzorak na teksel mape), pa je sporija od samog pravljenja
+TerrainPatchInfo generateTerrainPatch(const TerrainPatchKey& key, const TerrainHeightMap* heights, float parentError,
+    std::vector<float>& vertices);
+
+// Indeksi zajednicki za sve zakrpe (CCW spolja, kao SphereMesh)
+void generateTerrainPatchIndices(std::vector<unsigned short>& indices);
+
+// Sfera koja obuhvata zakrpu sa svim visinama i suknjom
+struct TerrainPatchBounds {
+    glm::vec3 center;
+    float radius;
+    glm::vec3 direction;        // Pravac sredine zakrpe
+    float coneAngle;            // Najveci ugao izmedju direction i ugla zakrpe
+};
+
+// lowest i highest su najmanji i najveci poluprecnik zakrpe zajedno sa suknjom
+TerrainPatchBounds terrainPatchBounds(const TerrainPatchKey& key, float lowest, float highest);
+
+// Zakrpa koju treba napraviti; veci priority (greska na ekranu roditelja) ide pre
+struct TerrainRequest {
+    TerrainPatchKey key;
+    float priority;
+    float parentError;          // Za dubinu suknje (generateTerrainPatch)
+};
+
+// Izbor zakrpa za jedan frejm, od TERRAIN_ROOT_PATCHES korena (moraju biti spremni). cameraLocal i
+// modelViewProjection su u prostoru modela jedinicne sfere; pixelsPerUnit = projection[1][1] * visina
+// viewport-a / 2, nearDistance bliska ravan u istim jedinicama: greska zakrpe blize od nje racuna se kao da je
+// na njoj, pa se deljenje zaustavlja na nivou koji je dovoljno fin za najblize sto se vidi. Zakrpa van kadra ili iza horizonta se preskace. Deli se po izmerenoj gresci (findResident
+// vraca TerrainPatchInfo zakrpe na GPU-u, nullptr ako je nema), i to samo ako su sva vidljiva deca spremna;
+// inace se crta ona, a deca koja fale idu u requests - pa zbog cekanja na decu slika nema rupa.
+void selectTerrainPatches(const glm::vec3& cameraLocal, const glm::mat4& modelViewProjection, float pixelsPerUnit,
+    float nearDistance, float heightScale, const std::function<const TerrainPatchInfo*(const TerrainPatchKey&)>& findResident,
+    std::vector<TerrainPatchKey>& draws, std::vector<TerrainRequest>& requests);
+
+#endif // TERRAIN_QUADTREE_H
@@ -0,0 +1,196 @@
+#include "TextureArrays.h"
+#include "AssetManifest.h"
+#include "AssetPack.h"
+#include "CompressedTexture.h"
+#include "GpuMemory.h"
+#include "TexturePreview.h"
+#include "TextureStreamer.h"
+#include "Trace.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// Umanjena verzija slike preuzorkovana na nivo niza; siva (neprovidna) ako ne postoji
+bool loadLayerPreview(const std::string& path, int width, int height, std::vector<unsigned char>& out) {
+    AssetData file = AssetPack::load(previewPathFor(path));
+    std::vector<unsigned char> rgba;
+    int previewWidth = 0, previewHeight = 0;
+    if (file.empty() || !decodePreview(file.data(), file.size(), true, rgba, previewWidth, previewHeight)) {
+        out.assign((size_t)width * height * 4, 128);
+        for (size_t i = 3; i < out.size(); i += 4) out[i] = 255;
+        return false;
+    }
+    resampleImage(rgba.data(), previewWidth, previewHeight, 4, width, height, out);
+    return true;
+}
+
+// BC1, ili BC3 ako ga trazi bar jedan sloj, kad svaki sloj ima .dds u velicini klase; 0 = niz ostaje RGBA8.
+// Cita se samo zaglavlje; sloj ciji se mip lanac ili format ipak ne poklopi streamer kompresuje sam
+unsigned int compressedArrayFormat(const std::vector<std::string>& paths, int width, int height) {
+    unsigned int format = COMPRESSED_RGB_BC1;
+    for (const std::string& path : paths) {
+        std::string ddsPath = compressedPathFor(path);
+        AssetData dds = AssetPack::load(ddsPath);
+        CompressedImage header;
+        if (dds.empty() || !readDdsHeader(dds.data(), dds.size(), ddsPath, header) || header.width != width || header.height != height) return 0;
+        if (header.format == COMPRESSED_RGBA_BC3) format = COMPRESSED_RGBA_BC3;
+        else if (header.format != COMPRESSED_RGB_BC1) return 0;
+    }
+    return TextureStreamer::supportsCompressedFormat(format) ? format : 0;
+}
+
+}
+
+TextureArrayManager::TextureArrayManager(TextureStreamer& streamer)
+    : streamer(streamer), maxLayers(256), built(false) {
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+}
+
+TextureArrayManager::~TextureArrayManager() {
+    for (ArrayInfo& info : arrays) {
+        GpuMemory::release(GPU_TEXTURE, info.texture);
+        glDeleteTextures(1, &info.texture);
+    }
+}
+
+int TextureArrayManager::previewLevelFor(int sizeClass) {
+    int level = 0;
+    while ((TEXTURE_SIZE_CLASSES[sizeClass].width >> level) > PREVIEW_MAX_SIZE) level++;
+    return level;
+}
+
+TextureLayer TextureArrayManager::add(const std::string& path) {
+    auto found = layers.find(path);
+    if (found != layers.end()) return found->second;
+    if (built) {
+        std::cerr << "TextureArrayManager: sloj dodat posle build(): " << path << std::endl;
+        return TextureLayer();
+    }
+
+    // Klasa se bira iz zaglavlja slike; dekodiranje ostaje na nitima streamera
+    int width = 0, height = 0, channels = 0;
+    AssetData file = AssetPack::load(path);
+    if (file.empty() || !stbi_info_from_memory(file.data(), (int)file.size(), &width, &height, &channels)) {
+        std::cerr << "TextureArrayManager: nepoznata velicina slike: " << path << std::endl;
+    }
+    int sizeClass = textureSizeClassFor(width, height);
+
+    ArrayInfo* target = nullptr;
+    for (ArrayInfo& info : arrays) {
+        if (info.sizeClass == sizeClass && (GLint)info.paths.size() < maxLayers) {
+            target = &info;
+            break;
+        }
+    }
+    if (!target) {
+        ArrayInfo info;
+        glGenTextures(1, &info.texture);
+        info.sizeClass = sizeClass;
+        info.format = 0;
+        arrays.push_back(info);
+        target = &arrays.back();
+    }
+
+    TextureLayer handle;
+    handle.array = target->texture;
+    handle.layer = (int)target->paths.size();
+    target->paths.push_back(path);
+    layers[path] = handle;
+    return handle;
+}
+
+void TextureArrayManager::build() {
+    TRACE_SCOPE("TextureArrayManager::build");
+    if (built) return;
+    built = true;
+
+    int previews = 0;
+    int compressed = 0;
+    std::vector<unsigned char> layerPixels;
+    CompressedImage compressedPreview;
+    for (ArrayInfo& info : arrays) {
+        const TextureSizeClass& size = TEXTURE_SIZE_CLASSES[info.sizeClass];
+        GLsizei layerCount = (GLsizei)info.paths.size();
+        int previewLevel = previewLevelFor(info.sizeClass);
+        int previewWidth = size.width >> previewLevel;
+        int previewHeight = size.height >> previewLevel;
+        info.format = compressedArrayFormat(info.paths, size.width, size.height);
+
+        // Nivo 0 popunjava streamer; dok ne stigne ceo niz, BASE_LEVEL drzi uzorkovanje na nivou umanjenih verzija.
+        // Kompresovan niz dobija ceo mip lanac odmah, jer slojevi stizu sa svojim nivoima (glGenerateMipmap ne radi nad BC)
+        long long bytes = 0;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, info.texture);
+        if (info.format != 0) {
+            for (int level = 0; level < mipLevelCount(size.width, size.height); ++level) {
+                int levelWidth = std::max(1, size.width >> level), levelHeight = std::max(1, size.height >> level);
+                size_t levelBytes = compressedLevelSize(info.format, levelWidth, levelHeight) * layerCount;
+                glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, info.format, levelWidth, levelHeight, layerCount, 0, (GLsizei)levelBytes, nullptr);
+                bytes += (long long)levelBytes;
+            }
+            compressed++;
+        }
+        else {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size.width, size.height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, previewLevel, GL_RGBA8, previewWidth, previewHeight, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            bytes = GpuMemory::imageBytes(size.width, size.height, 4, false) * layerCount;
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, previewLevel);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, previewLevel);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);      // Mipmape tek kad stignu svi slojevi
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        for (GLsizei layer = 0; layer < layerCount; ++layer) {
+            if (loadLayerPreview(info.paths[layer], previewWidth, previewHeight, layerPixels)) previews++;
+            if (info.format != 0 && compressImage(layerPixels.data(), previewWidth, previewHeight, 4, info.format, false, compressedPreview)) {
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, previewLevel, 0, 0, layer, previewWidth, previewHeight, 1, info.format,
+                    (GLsizei)compressedPreview.data.size(), compressedPreview.data.data());
+            }
+            else if (info.format == 0) {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, previewLevel, 0, 0, layer, previewWidth, previewHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, layerPixels.data());
+            }
+        }
+
+        std::string label = "texture array " + std::to_string(size.width) + "x" + std::to_string(size.height);
+        if (info.format != 0) label += std::string(" ") + compressedFormatName(info.format);
+        GpuMemory::track(GPU_TEXTURE, info.texture, bytes, label.c_str(), GPU_MEMORY_SITE);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    for (const ArrayInfo& info : arrays) {
+        const TextureSizeClass& size = TEXTURE_SIZE_CLASSES[info.sizeClass];
+        for (size_t layer = 0; layer < info.paths.size(); ++layer) {
+            streamer.loadArrayLayer(info.texture, (int)layer, size.width, size.height, info.paths[layer], info.format);
+        }
+    }
+
+    std::cout << "TextureArrayManager: " << layerCount() << " tekstura u " << arrayCount() << " GL_TEXTURE_2D_ARRAY ("
+        << compressed << " kompresovano), " << previews << " umanjenih verzija" << std::endl;
+}
+
+int TextureArrayManager::arrayCount() const {
+    return (int)arrays.size();
+}
+
+int TextureArrayManager::layerCount() const {
+    return (int)layers.size();
+}
+
+void TextureArrayManager::print(std::ostream& out) const {
+    out << "Texture arrays: " << layerCount() << " slojeva, " << arrayCount() << " nizova" << std::endl;
+    for (const ArrayInfo& info : arrays) {
+        const TextureSizeClass& size = TEXTURE_SIZE_CLASSES[info.sizeClass];
+        out << "  " << std::setw(4) << size.width << "x" << std::left << std::setw(5) << size.height << std::right
+            << std::setw(5) << (info.format != 0 ? compressedFormatName(info.format) : "RGBA8")
+            << std::setw(3) << info.paths.size() << " slojeva " << std::setw(6) << GpuMemory::objectBytes(GPU_TEXTURE, info.texture) / 1024 << " KB:";
+        for (const std::string& path : info.paths) out << " " << path;
+        out << std::endl;
+    }
+}
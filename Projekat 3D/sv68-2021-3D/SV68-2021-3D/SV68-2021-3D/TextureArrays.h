@@ -0,0 +1,65 @@
+#ifndef TEXTURE_ARRAYS_H
+#define TEXTURE_ARRAYS_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureStreamer;
+
+// Sloj niza tekstura: ono sto telo binduje umesto svoje GL_TEXTURE_2D teksture
+struct TextureLayer {
+    GLuint array = 0;           // GL_TEXTURE_2D_ARRAY
+    int layer = 0;
+};
+
+// Povrsinske teksture planeta i meseca spakovane u GL_TEXTURE_2D_ARRAY po klasama velicine.
+//
+//   TextureArrayManager bodyTextures(textureStreamer);
+//   TextureLayer earthTexture = bodyTextures.add("earth-tex.jpg");    // 1024x512, sloj 2
+//   bodyTextures.build();                                             // alocira nizove, slike stizu kroz streamer
+//   earth.Draw(planetProgram, earthTexture, ...);                      // sampler2DArray + uniform layer
+//
+// Svaka slika se preuzorkuje na klasu najblizu po sirini (TEXTURE_SIZE_CLASSES), pa sva tela iste klase dele
+// jednu teksturu i mogu u jedan instancirani poziv sa slojem po instanci. Niz je BC1/BC3 kad svaki njegov sloj
+// ima .dds u velicini klase (SV68-2021-TexConvert) i drajver podrzava format; slojevi tada stizu sa gotovim
+// mip lancem. Inace je niz RGBA8, a mip lanac se pravi kad stigne poslednji sloj. Do tada niz uzorkuje samo
+// nivo sa umanjenim verzijama (64x32, TexturePreview), pa svako telo odmah ima svoje boje, a svi slojevi niza
+// prelaze na pune slike u istom frejmu.
+class TextureArrayManager {
+public:
+    explicit TextureArrayManager(TextureStreamer& streamer);
+    ~TextureArrayManager();
+    TextureArrayManager(const TextureArrayManager&) = delete;
+    TextureArrayManager& operator=(const TextureArrayManager&) = delete;
+
+    // Pre build(); ime niza je odmah vazece, ista putanja vraca isti sloj
+    TextureLayer add(const std::string& path);
+    // Alocira sve nizove, puni nivo umanjenih verzija i salje slike streameru; jednom, iz GL niti
+    void build();
+
+    int arrayCount() const;
+    int layerCount() const;
+    void print(std::ostream& out) const;
+
+    static int previewLevelFor(int sizeClass);     // Mip nivo klase sa sirinom PREVIEW_MAX_SIZE
+
+private:
+    struct ArrayInfo {
+        GLuint texture;
+        int sizeClass;
+        unsigned int format;                // COMPRESSED_* ili 0 = RGBA8; bira se u build()
+        std::vector<std::string> paths;     // Indeks je sloj
+    };
+
+    TextureStreamer& streamer;
+    std::vector<ArrayInfo> arrays;
+    std::unordered_map<std::string, TextureLayer> layers;
+    GLint maxLayers;
+    bool built;
+};
+
+#endif // TEXTURE_ARRAYS_H
@@ -0,0 +1,163 @@
+#include "TexturePreview.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Jedan korak box filtera; dimenzija koja se ne polovi ostaje ista, neparna ivica ponavlja poslednji piksel
+std::vector<unsigned char> halve(const std::vector<unsigned char>& pixels, int width, int height, int channels, int nextWidth, int nextHeight) {
+    std::vector<unsigned char> out((size_t)nextWidth * nextHeight * channels);
+    int stepX = (nextWidth < width) ? 2 : 1;
+    int stepY = (nextHeight < height) ? 2 : 1;
+    for (int y = 0; y < nextHeight; ++y) {
+        int y0 = y * stepY;
+        int y1 = std::min(y0 + stepY - 1, height - 1);
+        for (int x = 0; x < nextWidth; ++x) {
+            int x0 = x * stepX;
+            int x1 = std::min(x0 + stepX - 1, width - 1);
+            for (int c = 0; c < channels; ++c) {
+                int sum = pixels[((size_t)y0 * width + x0) * channels + c] + pixels[((size_t)y0 * width + x1) * channels + c] +
+                    pixels[((size_t)y1 * width + x0) * channels + c] + pixels[((size_t)y1 * width + x1) * channels + c];
+                out[((size_t)y * nextWidth + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return out;
+}
+
+// TGA zaglavlje (18 B): bez ID-a i palete, tip 2 = nekompresovan truecolor
+const int TGA_HEADER_SIZE = 18;
+const unsigned char TGA_TRUECOLOR = 2;
+const unsigned char TGA_TOP_LEFT = 0x20;       // Bit 5 deskriptora: prvi red je gornji
+
+}
+
+std::string previewPathFor(const std::string& sourcePath) {
+    size_t dot = sourcePath.find_last_of('.');
+    size_t slash = sourcePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return sourcePath + ".preview.tga";
+    return sourcePath.substr(0, dot) + ".preview.tga";
+}
+
+void previewSize(int width, int height, int& previewWidth, int& previewHeight) {
+    previewWidth = width;
+    previewHeight = height;
+    if (width <= PREVIEW_MAX_SIZE && height <= PREVIEW_MAX_SIZE) return;
+    if (width >= height) {
+        previewWidth = PREVIEW_MAX_SIZE;
+        previewHeight = std::max(1, (int)((long long)height * PREVIEW_MAX_SIZE / width));
+    }
+    else {
+        previewHeight = PREVIEW_MAX_SIZE;
+        previewWidth = std::max(1, (int)((long long)width * PREVIEW_MAX_SIZE / height));
+    }
+}
+
+bool writePreview(const std::string& path, const unsigned char* pixels, int width, int height, int channels, bool bottomUp) {
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return false;
+
+    int previewWidth, previewHeight;
+    previewSize(width, height, previewWidth, previewHeight);
+    std::vector<unsigned char> small;
+    resampleImage(pixels, width, height, channels, previewWidth, previewHeight, small);
+
+    bool alpha = (channels == 2 || channels == 4);
+    int outChannels = alpha ? 4 : 3;
+    unsigned char header[TGA_HEADER_SIZE] = {};
+    header[2] = TGA_TRUECOLOR;
+    header[12] = (unsigned char)(previewWidth & 0xFF);
+    header[13] = (unsigned char)(previewWidth >> 8);
+    header[14] = (unsigned char)(previewHeight & 0xFF);
+    header[15] = (unsigned char)(previewHeight >> 8);
+    header[16] = (unsigned char)(outChannels * 8);
+    header[17] = (bottomUp ? 0 : TGA_TOP_LEFT) | (alpha ? 8 : 0);
+
+    std::vector<unsigned char> bgra((size_t)previewWidth * previewHeight * outChannels);
+    for (size_t i = 0; i < (size_t)previewWidth * previewHeight; ++i) {
+        const unsigned char* p = &small[i * channels];
+        unsigned char r = p[0];
+        unsigned char g = (channels >= 3) ? p[1] : p[0];
+        unsigned char b = (channels >= 3) ? p[2] : p[0];
+        unsigned char* out = &bgra[i * outChannels];
+        out[0] = b;
+        out[1] = g;
+        out[2] = r;
+        if (alpha) out[3] = p[channels - 1];
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bgra.data()), (std::streamsize)bgra.size());
+    return (bool)file;
+}
+
+bool decodePreview(const unsigned char* bytes, size_t size, bool flip, std::vector<unsigned char>& rgba, int& width, int& height) {
+    if (!bytes || size < (size_t)TGA_HEADER_SIZE || bytes[1] != 0 || bytes[2] != TGA_TRUECOLOR) return false;
+    int bits = bytes[16];
+    if (bits != 24 && bits != 32) return false;
+
+    width = bytes[12] | (bytes[13] << 8);
+    height = bytes[14] | (bytes[15] << 8);
+    int channels = bits / 8;
+    size_t offset = TGA_HEADER_SIZE + bytes[0];     // Preskace ID polje
+    if (width <= 0 || height <= 0 || size < offset + (size_t)width * height * channels) return false;
+
+    // TGA je podrazumevano odozdo nagore; flip (kao za original) okrece jos jednom
+    bool topDown = (bytes[17] & TGA_TOP_LEFT) != 0;
+    bool reverseRows = (topDown == flip);
+    rgba.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* row = bytes + offset + (size_t)(reverseRows ? height - 1 - y : y) * width * channels;
+        unsigned char* out = &rgba[(size_t)y * width * 4];
+        for (int x = 0; x < width; ++x) {
+            out[x * 4 + 0] = row[x * channels + 2];
+            out[x * 4 + 1] = row[x * channels + 1];
+            out[x * 4 + 2] = row[x * channels + 0];
+            out[x * 4 + 3] = (channels == 4) ? row[x * channels + 3] : 255;
+        }
+    }
+    return true;
+}
+
+void resampleImage(const unsigned char* pixels, int width, int height, int channels, int targetWidth, int targetHeight,
+    std::vector<unsigned char>& out) {
+    std::vector<unsigned char> current(pixels, pixels + (size_t)width * height * channels);
+    while (width >= 2 * targetWidth || height >= 2 * targetHeight) {
+        int nextWidth = (width >= 2 * targetWidth) ? width / 2 : width;
+        int nextHeight = (height >= 2 * targetHeight) ? height / 2 : height;
+        current = halve(current, width, height, channels, nextWidth, nextHeight);
+        width = nextWidth;
+        height = nextHeight;
+    }
+
+    out.resize((size_t)targetWidth * targetHeight * channels);
+    if (width == targetWidth && height == targetHeight) {
+        out.swap(current);
+        return;
+    }
+
+    // Bilinearno, sa centrima piksela poravnatim kao pri uzorkovanju teksture
+    float scaleX = (float)width / targetWidth;
+    float scaleY = (float)height / targetHeight;
+    for (int y = 0; y < targetHeight; ++y) {
+        float sy = std::min(std::max((y + 0.5f) * scaleY - 0.5f, 0.0f), (float)(height - 1));
+        int y0 = (int)sy;
+        int y1 = std::min(y0 + 1, height - 1);
+        float fy = sy - y0;
+        for (int x = 0; x < targetWidth; ++x) {
+            float sx = std::min(std::max((x + 0.5f) * scaleX - 0.5f, 0.0f), (float)(width - 1));
+            int x0 = (int)sx;
+            int x1 = std::min(x0 + 1, width - 1);
+            float fx = sx - x0;
+            for (int c = 0; c < channels; ++c) {
+                float top = current[((size_t)y0 * width + x0) * channels + c] * (1.0f - fx) + current[((size_t)y0 * width + x1) * channels + c] * fx;
+                float bottom = current[((size_t)y1 * width + x0) * channels + c] * (1.0f - fx) + current[((size_t)y1 * width + x1) * channels + c] * fx;
+                out[((size_t)y * targetWidth + x) * channels + c] = (unsigned char)(top * (1.0f - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef TEXTURE_PREVIEW_H
+#define TEXTURE_PREVIEW_H
+
+#include <string>
+#include <vector>
+
+// Umanjene verzije tekstura (najvise 64 piksela po strani) koje program crta dok se prava slika dekodira.
+// Pravi ih SV68-2021-TexConvert pored izvorne slike kao nekompresovan TGA (earth-tex.jpg -> earth-tex.preview.tga),
+// pa se pri pokretanju citaju sinhrono za par mikrosekundi, pre prvog frejma:
+//
+//   AssetData file = AssetPack::load(previewPathFor("earth-tex.jpg"));
+//   if (decodePreview(file.data(), file.size(), true, rgba, width, height)) ... glTexImage2D(64x32)
+//
+// Redovi su upisani kao u izvornoj slici; flip se primenjuje pri citanju, isto kao za original.
+// Ne zavisi od GL zaglavlja ni od stb_image (TGA je samo zaglavlje + BGR(A) pikseli).
+
+const int PREVIEW_MAX_SIZE = 64;
+
+// "earth-tex.jpg" -> "earth-tex.preview.tga"
+std::string previewPathFor(const std::string& sourcePath);
+
+// Velicina umanjene slike: duza strana PREVIEW_MAX_SIZE, odnos stranica ocuvan (manje slike se ne uvecavaju)
+void previewSize(int width, int height, int& previewWidth, int& previewHeight);
+
+// Pikseli izvorne slike (channels 1-4) -> 24-bitni TGA, ili 32-bitni ako slika ima alfu.
+// bottomUp: redovi su vec okrenuti (ucitani sa flipom); upisuje se u zaglavlje, pa citanje ostaje isto
+bool writePreview(const std::string& path, const unsigned char* pixels, int width, int height, int channels, bool bottomUp);
+
+// Nekompresovan 24/32-bitni TGA (kao iz writePreview) -> RGBA; flip okrece redove kao stbi_set_flip_vertically_on_load
+bool decodePreview(const unsigned char* bytes, size_t size, bool flip, std::vector<unsigned char>& rgba, int& width, int& height);
+
+// Slika iste vrste piksela u drugoj velicini: polovljenje box filterom dok je izvor bar 2x veci, zatim bilinearno
+void resampleImage(const unsigned char* pixels, int width, int height, int channels, int targetWidth, int targetHeight,
+    std::vector<unsigned char>& out);
+
+#endif // TEXTURE_PREVIEW_H
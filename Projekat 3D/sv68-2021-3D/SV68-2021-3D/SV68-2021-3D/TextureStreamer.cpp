@@ -0,0 +1,509 @@
+#include "TextureStreamer.h"
+#include "AssetPack.h"
+#include "GpuMemory.h"
+#include "ImageCache.h"
+#include "TextureArrays.h"
+#include "TexturePreview.h"
+#include "Trace.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const GLubyte PLACEHOLDER_PIXEL[3] = { 128, 128, 128 };
+
+double nowMs() {
+    return Tracer::now() / 1.0e6;
+}
+
+bool hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (extension && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+// Formati koje drajver prijavljuje; S3TC i BPTC se cesto vide samo kao ekstenzije
+std::vector<unsigned int> queryCompressedFormats() {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    std::vector<GLint> listed(std::max(count, 0));
+    if (count > 0) glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, listed.data());
+
+    std::vector<unsigned int> formats(listed.begin(), listed.end());
+    if (hasExtension("GL_EXT_texture_compression_s3tc")) {
+        formats.push_back(COMPRESSED_RGB_BC1);
+        formats.push_back(COMPRESSED_RGBA_BC3);
+    }
+    if (hasExtension("GL_ARB_texture_compression_bptc")) {
+        formats.push_back(COMPRESSED_RGBA_BC7);
+    }
+    return formats;
+}
+
+}
+
+TextureStreamer::TextureStreamer(int workerCount)
+    : stopping(false), requested(0), uploaded(0), pixelBuffer(0), pixelBufferSize(0), previews(0),
+    startMs(nowMs()), longestDecodeMs(0.0), totalDecodeMs(0.0) {
+    if (workerCount <= 0) {
+        workerCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+        workerCount = std::min(workerCount, 8);
+    }
+    supportsCompressedFormat(COMPRESSED_RGB_BC1);      // Upit ide iz GL niti, pre radnih niti
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&TextureStreamer::workerLoop, this, i);
+    }
+    glGenBuffers(1, &pixelBuffer);
+}
+
+TextureStreamer::~TextureStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+
+    for (DecodedImage& image : decoded) stbi_image_free(image.pixels);
+    for (auto& cube : cubeFaces) {
+        for (DecodedImage& image : cube.second) stbi_image_free(image.pixels);
+    }
+    GpuMemory::release(GPU_BUFFER, pixelBuffer);
+    glDeleteBuffers(1, &pixelBuffer);
+}
+
+GLuint TextureStreamer::createPlaceholder(GLenum target, const std::vector<std::string>& sources, bool flip) {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(target, textureID);
+
+    // Umanjene verzije (SV68-2021-TexConvert) se citaju odmah, na glavnoj niti; za cube mapu samo ako
+    // postoje za svih 6 stranica i iste su velicine, inace bi tekstura bila nekompletna
+    std::vector<std::vector<unsigned char>> pixels(sources.size());
+    int width = 0, height = 0;
+    bool havePreviews = !sources.empty();
+    for (size_t i = 0; i < sources.size() && havePreviews; ++i) {
+        AssetData file = AssetPack::load(previewPathFor(sources[i]));
+        int previewWidth = 0, previewHeight = 0;
+        havePreviews = !file.empty() && decodePreview(file.data(), file.size(), flip, pixels[i], previewWidth, previewHeight) &&
+            (i == 0 || (previewWidth == width && previewHeight == height));
+        width = previewWidth;
+        height = previewHeight;
+    }
+    if (havePreviews) previews++;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (target == GL_TEXTURE_CUBE_MAP) {
+        for (int face = 0; face < 6; ++face) {
+            if (havePreviews) glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels[face].data());
+            else glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+        }
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    }
+    else {
+        if (havePreviews) glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels[0].data());
+        else glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(target, 0);
+    return textureID;
+}
+
+GLuint TextureStreamer::loadTexture(const std::string& path) {
+    GLuint textureID = createPlaceholder(GL_TEXTURE_2D, { path }, true);
+    enqueue(Job{ textureID, GL_TEXTURE_2D, path, true, true, true });
+    return textureID;
+}
+
+GLuint TextureStreamer::loadCubemap(const std::vector<std::string>& faces) {
+    if (faces.size() != 6) {
+        std::cerr << "TextureStreamer: cube mapa mora imati 6 stranica, ima " << faces.size() << std::endl;
+        return createPlaceholder(GL_TEXTURE_CUBE_MAP, {}, false);
+    }
+    GLuint textureID = createPlaceholder(GL_TEXTURE_CUBE_MAP, faces, false);
+
+    // Sve stranice cube mape moraju imati isti format, pa se .dds ne mesa sa PNG-om
+    bool allowCompressed = true;
+    for (size_t i = 0; i < faces.size(); ++i) {
+        allowCompressed = allowCompressed && AssetPack::contains(compressedPathFor(faces[i]));
+    }
+    for (size_t i = 0; i < faces.size(); ++i) {
+        enqueue(Job{ textureID, (GLenum)(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i), faces[i], false, false, allowCompressed });
+    }
+    return textureID;
+}
+
+void TextureStreamer::loadArrayLayer(GLuint array, int layer, int width, int height, const std::string& path, unsigned int compressedFormat) {
+    Job job{ array, GL_TEXTURE_2D_ARRAY, path, true, true, compressedFormat != 0 };
+    job.layer = layer;
+    job.width = width;
+    job.height = height;
+    job.compressedFormat = compressedFormat;
+    arrayLayersPending[array]++;
+    enqueue(job);
+}
+
+void TextureStreamer::enqueue(const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+        requested++;
+    }
+    jobReady.notify_one();
+}
+
+// Kljuc u ImageCache: isto sto worker radi posle stbi_load (sloj niza je vec preuzorkovan, 2D tekstura ima mip lanac)
+ImageDecode TextureStreamer::decodeFor(const Job& job) {
+    ImageDecode decode;
+    decode.flip = job.flip;
+    if (job.target == GL_TEXTURE_2D_ARRAY) {
+        decode.channels = 4;        // Svi slojevi niza su RGBA8
+        decode.width = job.width;
+        decode.height = job.height;
+    }
+    decode.mipmaps = job.mipmap && job.target == GL_TEXTURE_2D;
+    return decode;
+}
+
+void TextureStreamer::workerLoop(int index) {
+    std::string threadName = "decode " + std::to_string(index);
+    Tracer::setThreadName(threadName.c_str());
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        DecodedImage image;
+        image.job = job;
+        image.pixels = nullptr;
+        image.width = image.height = image.channels = 0;
+        double start = nowMs();
+        if (job.allowCompressed) {
+            TRACE_SCOPE_DETAIL("loadDds", job.path.c_str());
+            std::string ddsPath = compressedPathFor(job.path);
+            AssetData dds = AssetPack::load(ddsPath);
+            if (!dds.empty() && loadDdsFromMemory(dds.data(), dds.size(), ddsPath, image.compressed) &&
+                !supportsCompressedFormat(image.compressed.format)) {
+                std::cerr << "TextureStreamer: " << compressedFormatName(image.compressed.format)
+                    << " nije podrzan, koristi se " << job.path << std::endl;
+                image.compressed = CompressedImage();
+            }
+            // Sloj niza mora tacno da odgovara nivoima koje je TextureArrayManager alocirao
+            const CompressedImage& layer = image.compressed;
+            if (job.target == GL_TEXTURE_2D_ARRAY && layer.format != 0 && (layer.format != job.compressedFormat ||
+                layer.width != job.width || layer.height != job.height || (int)layer.levels.size() != mipLevelCount(job.width, job.height))) {
+                std::cerr << "TextureStreamer: " << ddsPath << " nije " << compressedFormatName(job.compressedFormat) << " "
+                    << job.width << "x" << job.height << " sa punim mip lancem, sloj se kompresuje pri ucitavanju" << std::endl;
+                image.compressed = CompressedImage();
+            }
+        }
+        if (image.compressed.format == 0) {
+            AssetData file = AssetPack::load(job.path);       // Iz paketa: dekoder cita direktno iz mapirane memorije
+            ImageDecode decode = decodeFor(job);
+            if (!file.empty()) image.cached = ImageCache::load(job.path, file.data(), file.size(), decode);
+            if (!image.cached.empty()) {
+                image.width = image.cached.width();
+                image.height = image.cached.height();
+                image.channels = image.cached.channels();
+            }
+            else if (!file.empty()) {
+                {
+                    TRACE_SCOPE_DETAIL("stbi_load", job.path.c_str());
+                    stbi_set_flip_vertically_on_load_thread(job.flip);     // Globalni flag menja i glavna nit
+                    image.pixels = stbi_load_from_memory(file.data(), (int)file.size(), &image.width, &image.height, &image.channels, decode.channels);
+                }
+                if (image.pixels && job.target == GL_TEXTURE_2D_ARRAY) {
+                    TRACE_SCOPE_DETAIL("resampleImage", job.path.c_str());
+                    resampleImage(image.pixels, image.width, image.height, 4, job.width, job.height, image.layerPixels);
+                    stbi_image_free(image.pixels);
+                    image.pixels = nullptr;
+                    image.width = job.width;
+                    image.height = job.height;
+                    image.channels = 4;
+                }
+                // Sledece pokretanje cita ovo umesto dekodiranja; upis se placa samo kad se slika promeni
+                const unsigned char* pixels = image.pixels ? image.pixels : image.layerPixels.data();
+                if ((image.pixels || !image.layerPixels.empty()) && image.channels >= 3) {
+                    ImageCache::store(job.path, file.data(), file.size(), decode, pixels, image.width, image.height, image.channels);
+                }
+            }
+            // Kompresovan niz ne prima RGBA8 slojeve; bez .dds sloj se kompresuje ovde, van glavne niti
+            if (job.compressedFormat != 0 && (!image.cached.empty() || !image.layerPixels.empty())) {
+                TRACE_SCOPE_DETAIL("compressImage", job.path.c_str());
+                const unsigned char* pixels = image.cached.empty() ? image.layerPixels.data() : image.cached.pixels();
+                compressImage(pixels, job.width, job.height, 4, job.compressedFormat, true, image.compressed);
+                image.layerPixels = std::vector<unsigned char>();
+                image.cached = CachedImage();
+            }
+        }
+        image.decodeMs = nowMs() - start;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decoded.push_back(std::move(image));
+        }
+        imageReady.notify_one();
+    }
+}
+
+void TextureStreamer::uploadImage(DecodedImage& image) {
+    const Job& job = image.job;
+    TRACE_SCOPE_DETAIL("TextureStreamer::upload", job.path.c_str());
+
+    longestDecodeMs = std::max(longestDecodeMs, image.decodeMs);
+    totalDecodeMs += image.decodeMs;
+
+    if (job.target == GL_TEXTURE_2D_ARRAY) {
+        uploadArrayLayer(image);
+        return;
+    }
+    if (image.compressed.format != 0) {
+        uploadCompressedImage(image);
+        return;
+    }
+    if (!image.cached.empty()) {
+        uploadCachedImage(image);
+        return;
+    }
+    if (!image.pixels) {
+        std::cerr << "Failed to load texture: " << job.path << std::endl;
+        return;
+    }
+
+    GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+    int channels = (image.channels == 4) ? 4 : 3;
+    GLsizeiptr size = (GLsizeiptr)image.width * image.height * image.channels;
+
+    const void* source = fillPixelBuffer(image.pixels, size);
+
+    bool cubeFace = job.target != GL_TEXTURE_2D;
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, job.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(job.target, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, source);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (job.mipmap) glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 0);
+
+    stbi_image_free(image.pixels);
+    image.pixels = nullptr;
+
+    // Stranice cube mape se sabiraju pod istim imenom
+    long long bytes = GpuMemory::imageBytes(image.width, image.height, channels, job.mipmap);
+    if (cubeFace) bytes += GpuMemory::objectBytes(GPU_TEXTURE, job.texture);
+    GpuMemory::track(GPU_TEXTURE, job.texture, bytes, cubeFace ? "skybox cubemap" : job.path.c_str(), GPU_MEMORY_SITE);
+}
+
+void TextureStreamer::uploadCompressedImage(DecodedImage& image) {
+    const Job& job = image.job;
+    const CompressedImage& compressed = image.compressed;
+    const unsigned char* source = (const unsigned char*)fillPixelBuffer(compressed.data.data(), (GLsizeiptr)compressed.data.size());
+
+    bool cubeFace = job.target != GL_TEXTURE_2D;
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, job.texture);
+    uploadCompressedLevels(job.target, compressed, source);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 0);
+
+    long long bytes = (long long)compressed.data.size();
+    if (cubeFace) bytes += GpuMemory::objectBytes(GPU_TEXTURE, job.texture);
+    GpuMemory::track(GPU_TEXTURE, job.texture, bytes, cubeFace ? "skybox cubemap" : job.path.c_str(), GPU_MEMORY_SITE);
+    image.compressed = CompressedImage();
+}
+
+// Nivoi iz mapiranog kesa idu u PBO jednim kopiranjem; mip lanac je vec izracunat, pa nema glGenerateMipmap
+void TextureStreamer::uploadCachedImage(DecodedImage& image) {
+    const Job& job = image.job;
+    const CachedImage& cached = image.cached;
+    GLenum format = (cached.channels() == 4) ? GL_RGBA : GL_RGB;
+    const unsigned char* source = (const unsigned char*)fillPixelBuffer(cached.pixels(), (GLsizeiptr)cached.pixelBytes());
+
+    bool cubeFace = job.target != GL_TEXTURE_2D;
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, job.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int i = 0; i < cached.levelCount(); ++i) {
+        const CachedLevel& level = cached.level(i);
+        const void* pixels = source ? (const void*)(source + level.offset) : (const void*)(uintptr_t)level.offset;    // Pomeraj u PBO-u
+        glTexImage2D(job.target, i, format, level.width, level.height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(cubeFace ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 0);
+
+    long long bytes = GpuMemory::imageBytes(cached.width(), cached.height(), cached.channels() == 4 ? 4 : 3, cached.levelCount() > 1);
+    if (cubeFace) bytes += GpuMemory::objectBytes(GPU_TEXTURE, job.texture);
+    GpuMemory::track(GPU_TEXTURE, job.texture, bytes, cubeFace ? "skybox cubemap" : job.path.c_str(), GPU_MEMORY_SITE);
+    image.cached = CachedImage();
+}
+
+void TextureStreamer::uploadArrayLayer(DecodedImage& image) {
+    const Job& job = image.job;
+
+    if (image.compressed.format != 0) {
+        // Nivoi su vec alocirani za ceo niz (glCompressedTexImage3D u build()), pa se menja samo ovaj sloj
+        const CompressedImage& compressed = image.compressed;
+        const unsigned char* source = (const unsigned char*)fillPixelBuffer(compressed.data.data(), (GLsizeiptr)compressed.data.size());
+        glBindTexture(GL_TEXTURE_2D_ARRAY, job.texture);
+        for (size_t i = 0; i < compressed.levels.size(); ++i) {
+            const CompressedLevel& level = compressed.levels[i];
+            const void* pixels = source ? (const void*)(source + level.offset) : (const void*)(uintptr_t)level.offset;    // Pomeraj u PBO-u
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)i, 0, 0, job.layer, level.width, level.height, 1,
+                compressed.format, (GLsizei)level.size, pixels);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        image.compressed = CompressedImage();
+    }
+    else if (!image.layerPixels.empty() || !image.cached.empty()) {
+        const unsigned char* pixels = image.cached.empty() ? image.layerPixels.data() : image.cached.pixels();
+        size_t size = image.cached.empty() ? image.layerPixels.size() : image.cached.level(0).size;
+        const void* source = fillPixelBuffer(pixels, (GLsizeiptr)size);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, job.texture);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, job.layer, image.width, image.height, 1, GL_RGBA, GL_UNSIGNED_BYTE, source);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        image.layerPixels = std::vector<unsigned char>();
+        image.cached = CachedImage();
+    }
+    else {
+        std::cerr << "Failed to load texture: " << job.path << " (sloj " << job.layer << " ostaje siv)" << std::endl;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, job.texture);
+    }
+
+    // glGenerateMipmap racuna sve slojeve niza, pa se poziva jednom, posle poslednjeg;
+    // kompresovan niz vec ima sve nivoe (i bajtove u GpuMemory) iz svojih slojeva
+    if (--arrayLayersPending[job.texture] == 0) {
+        // Svi slojevi prelaze sa umanjenih verzija na pune slike istovremeno
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+        if (job.compressedFormat != 0) {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, mipLevelCount(job.width, job.height) - 1);
+        }
+        else {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 1000);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+            GpuMemory::track(GPU_TEXTURE, job.texture, GpuMemory::objectBytes(GPU_TEXTURE, job.texture) * 4 / 3, nullptr, GPU_MEMORY_SITE);
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        arrayLayersPending.erase(job.texture);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// Podaci se kopiraju u PBO, pa glTex*Image ne ceka da drajver prepise memoriju klijenta;
+// glBufferData(nullptr) odbacuje prethodni sadrzaj, pa nema cekanja ni na prethodni prenos.
+// Vraca pokazivac za glTex*Image: pomeraj 0 u bindovanom PBO-u, ili data ako mapiranje nije uspelo.
+const void* TextureStreamer::fillPixelBuffer(const unsigned char* data, GLsizeiptr size) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    if (size > pixelBufferSize) {
+        pixelBufferSize = size;
+        GpuMemory::track(GPU_BUFFER, pixelBuffer, pixelBufferSize, "TextureStreamer PBO", GPU_MEMORY_SITE);
+    }
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, data, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        return nullptr;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);    // Bez PBO-a: salje se direktno iz memorije
+    return data;
+}
+
+void TextureStreamer::uploadCompressedLevels(GLenum target, const CompressedImage& image, const unsigned char* data) {
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        const CompressedLevel& level = image.levels[i];
+        const void* pixels = data ? (const void*)(data + level.offset) : (const void*)(uintptr_t)level.offset;    // Pomeraj u PBO-u
+        glCompressedTexImage2D(target, (GLint)i, image.format, level.width, level.height, 0, (GLsizei)level.size, pixels);
+    }
+    // Mip lanac iz fajla moze biti kraci od punog; bez ovoga tekstura sa mip filterom ne bi bila kompletna
+    if (target == GL_TEXTURE_2D) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image.levels.size() - 1);
+    }
+}
+
+bool TextureStreamer::supportsCompressedFormat(unsigned int format) {
+    static const std::vector<unsigned int> formats = queryCompressedFormats();
+    return std::find(formats.begin(), formats.end(), format) != formats.end();
+}
+
+int TextureStreamer::upload(int maxUploads) {
+    std::vector<DecodedImage> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!decoded.empty() && (int)ready.size() < maxUploads) {
+            ready.push_back(std::move(decoded.front()));
+            decoded.pop_front();
+        }
+    }
+
+    for (DecodedImage& image : ready) {
+        GLenum target = image.job.target;
+        if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) {
+            std::vector<DecodedImage>& faces = cubeFaces[image.job.texture];
+            faces.push_back(std::move(image));
+            if (faces.size() < 6) continue;
+
+            // Svih 6 stranica u istom pozivu: izmedju frejmova nikad nisu razlicite velicine
+            for (DecodedImage& face : faces) {
+                uploadImage(face);
+                uploaded++;
+            }
+            cubeFaces.erase(faces.front().job.texture);
+            continue;
+        }
+        uploadImage(image);
+        uploaded++;
+    }
+
+    if (!ready.empty() && uploaded == requested) {
+        std::cout << "TextureStreamer: " << requested << " slika za " << (int)(nowMs() - startMs) << " ms ("
+            << workers.size() << " niti, najduze dekodiranje " << (int)longestDecodeMs << " ms, zbir "
+            << (int)totalDecodeMs << " ms, " << ImageCache::hitCount() << " iz kesa)" << std::endl;
+    }
+    return (int)ready.size();
+}
+
+void TextureStreamer::finish() {
+    TRACE_SCOPE("TextureStreamer::finish");
+    while (!isDone()) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            imageReady.wait(lock, [this] { return !decoded.empty(); });
+        }
+        upload(requested);
+    }
+}
+
+bool TextureStreamer::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return uploaded == requested;
+}
+
+int TextureStreamer::previewCount() const {
+    return previews;
+}
+
+int TextureStreamer::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requested - uploaded;
+}
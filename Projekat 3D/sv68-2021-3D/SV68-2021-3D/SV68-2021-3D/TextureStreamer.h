@@ -0,0 +1,119 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "CompressedTexture.h"
+#include "ImageCache.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Ucitavanje tekstura pri pokretanju: slike se dekodiraju (stbi_load) na pozadinskim nitima,
+// a glavna nit ih salje na GPU kroz pixel buffer objekat (glTexImage2D iz PBO-a).
+//
+//   TextureStreamer streamer;
+//   GLuint earth = streamer.loadTexture("earth-tex.jpg");   // odmah vraca ime teksture
+//   streamer.upload(TextureStreamer::UPLOADS_PER_FRAME);     // svakog frejma, glavna nit
+//   streamer.finish();                                       // ili sacekaj sve (benchmark)
+//
+// Dok slika ne stigne, tekstura je umanjena verzija (TexturePreview, 64 px) ili 1x1 siva, pa je ime odmah
+// upotrebljivo za crtanje. Zamena je cela u jednom upload() pozivu: 2D tekstura dobija nivo 0 i mipmape odjednom,
+// a stranice cube mape cekaju jedna drugu, da nebo nikad ne bi bilo nekompletno (stranice razlicite velicine).
+// Ako pored slike postoji .dds (SV68-2021-TexConvert) u formatu koji drajver podrzava, umesto
+// dekodiranja se cita on i salje kroz glCompressedTexImage2D sa gotovim mip lancem.
+// Inace se slika prvo trazi u ImageCache (dekodirana i sa mip lancem iz proslog pokretanja, mapirana sa diska);
+// posle stbi_load radna nit upisuje rezultat u kes, pa sledece pokretanje ne dekodira nista.
+// Prvi frejm ne ceka ni jedno dekodiranje, a sve slike su ucitane za vreme najduzeg dekodiranja
+// (ili zbira / broj niti, sta je duze) umesto za zbir svih.
+class TextureStreamer {
+public:
+    static const int UPLOADS_PER_FRAME = 2;     // Ogranicava zastoj frejma dok se slike salju
+
+    // workerCount 0 = hardware_concurrency - 1 (glavna nit ostaje za crtanje)
+    explicit TextureStreamer(int workerCount = 0);
+    ~TextureStreamer();
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // Isto kao ::loadTexture: RGB/RGBA, vertikalno okrenuta, sa mipmapama
+    GLuint loadTexture(const std::string& path);
+    // Kao ::loadCubemap: tacno 6 stranica redom +X, -X, +Y, -Y, +Z, -Z, bez okretanja i mipmapa
+    GLuint loadCubemap(const std::vector<std::string>& faces);
+    // Sloj GL_TEXTURE_2D_ARRAY (TextureArrayManager): RGBA, preuzorkovan na width x height, vertikalno okrenut;
+    // mip lanac niza se pravi kad stigne njegov poslednji sloj. Uz compressedFormat (BC1/BC3, niz vec alociran
+    // sa svim nivoima) sloj se cita iz .dds iste velicine i formata, a ako takvog nema, radna nit ga kompresuje
+    void loadArrayLayer(GLuint array, int layer, int width, int height, const std::string& path, unsigned int compressedFormat = 0);
+
+    // Glavna nit (GL kontekst): salje najvise maxUploads dekodiranih slika; vraca broj poslatih
+    int upload(int maxUploads);
+    void finish();
+
+    bool isDone() const;
+    int pendingCount() const;
+    int previewCount() const;       // Tekstura koje su do prvog frejma dobile umanjenu verziju umesto sive
+
+    // Prvi poziv mora iz GL niti (cita GL_COMPRESSED_TEXTURE_FORMATS i ekstenzije)
+    static bool supportsCompressedFormat(unsigned int format);
+    // Svi nivoi slike na target (bindovana tekstura); data je image.data ili nullptr uz bindovan PBO
+    static void uploadCompressedLevels(GLenum target, const CompressedImage& image, const unsigned char* data);
+
+private:
+    struct Job {
+        GLuint texture;
+        GLenum target;              // GL_TEXTURE_2D ili stranica cube mape
+        std::string path;
+        bool flip;
+        bool mipmap;
+        bool allowCompressed;       // Cube mapa: .dds samo ako postoji za svih 6 stranica
+        int layer = 0;              // GL_TEXTURE_2D_ARRAY: sloj i velicina na koju se slika preuzorkuje
+        int width = 0, height = 0;
+        unsigned int compressedFormat = 0;      // GL_TEXTURE_2D_ARRAY: format niza, 0 = RGBA8
+    };
+
+    struct DecodedImage {
+        Job job;
+        unsigned char* pixels;      // stbi_load; nullptr ako dekodiranje nije uspelo
+        int width, height, channels;
+        CompressedImage compressed; // format != 0 -> procitan (ili za sloj niza kompresovan) .dds, pixels je nullptr
+        std::vector<unsigned char> layerPixels;     // Sloj niza, vec preuzorkovan (pixels je nullptr)
+        CachedImage cached;         // Pogodak u ImageCache (pixels je nullptr); sloj niza je vec preuzorkovan
+        double decodeMs;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::deque<DecodedImage> decoded;
+    mutable std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable imageReady;
+    bool stopping;
+
+    int requested;
+    int uploaded;
+    GLuint pixelBuffer;
+    GLsizeiptr pixelBufferSize;
+    std::unordered_map<GLuint, int> arrayLayersPending;    // Niz -> slojevi koji jos nisu poslati
+    std::unordered_map<GLuint, std::vector<DecodedImage>> cubeFaces;     // Dekodirane stranice koje cekaju ostale
+    int previews;
+
+    double startMs;
+    double longestDecodeMs;
+    double totalDecodeMs;
+
+    void workerLoop(int index);
+    static ImageDecode decodeFor(const Job& job);
+    void enqueue(const Job& job);
+    void uploadImage(DecodedImage& image);
+    void uploadCompressedImage(DecodedImage& image);
+    void uploadCachedImage(DecodedImage& image);
+    void uploadArrayLayer(DecodedImage& image);
+    const void* fillPixelBuffer(const unsigned char* data, GLsizeiptr size);
+    GLuint createPlaceholder(GLenum target, const std::vector<std::string>& sources, bool flip);
+};
+
+#endif // TEXTURE_STREAMER_H
@@ -0,0 +1,143 @@
+#include "Trace.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t durationNs;
+    char detail[Tracer::DETAIL_LENGTH];
+};
+
+// Jedan pisac (vlasnik niti), citalac samo pri ispisu
+struct ThreadBuffer {
+    int threadId = 0;
+    std::string threadName;
+    std::atomic<uint64_t> written{ 0 };
+    std::unique_ptr<TraceEvent[]> events{ new TraceEvent[Tracer::EVENTS_PER_THREAD] };
+};
+
+const std::chrono::steady_clock::time_point programStart = std::chrono::steady_clock::now();
+
+std::mutex registryMutex;
+std::vector<ThreadBuffer*> registry;       // Baferi zive do kraja programa, da bi se ispisali i posle gasenja niti
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer* threadBuffer() {
+    if (!localBuffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        localBuffer = new ThreadBuffer();
+        localBuffer->threadId = static_cast<int>(registry.size()) + 1;
+        registry.push_back(localBuffer);
+    }
+    return localBuffer;
+}
+
+void writeJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) < 0x20) out << ' ';
+        else out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled{ true };
+
+int64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - programStart).count();
+}
+
+void Tracer::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const char* name) {
+    ThreadBuffer* buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+void Tracer::record(const char* name, int64_t startNs, int64_t endNs, const char* detail) {
+    ThreadBuffer* buffer = threadBuffer();
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+
+    TraceEvent& event = buffer->events[index % EVENTS_PER_THREAD];
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    if (detail) {
+        std::strncpy(event.detail, detail, DETAIL_LENGTH - 1);
+        event.detail[DETAIL_LENGTH - 1] = '\0';
+    }
+    else {
+        event.detail[0] = '\0';
+    }
+
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+bool Tracer::writeChromeJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Trace: ne mogu da otvorim " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    size_t eventCount = 0;
+
+    for (ThreadBuffer* buffer : registry) {
+        if (!buffer->threadName.empty()) {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->threadName.c_str());
+            out << "}}";
+            first = false;
+        }
+
+        // Ako pisac prepise dogadjaj dok traje ispis, taj jedan dogadjaj moze biti nekonzistentan
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = written > (uint64_t)EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+            out << (first ? "" : ",") << "\n{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"sv68\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0;
+            if (event.detail[0] != '\0') {
+                out << ",\"args\":{\"detail\":";
+                writeJsonString(out, event.detail);
+                out << "}";
+            }
+            out << "}";
+            first = false;
+            eventCount++;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "Trace: " << eventCount << " dogadjaja zapisano u " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Vremenska linija frejmova u Chrome trace-event formatu (chrome://tracing, ui.perfetto.dev).
+//
+//   TRACE_SCOPE("Planet::Draw");                    // zona traje do kraja bloka
+//   TRACE_SCOPE_DETAIL("loadTexture", filePath);    // + tekst u "args" (kopira se)
+//   Tracer::writeChromeJson("trace.json");          // ispis na zahtev
+//
+// Svaka nit pise u svoj prsten dogadjaja bez zakljucavanja; mutex se koristi samo
+// pri prvoj registraciji niti i pri ispisu.
+class Tracer {
+public:
+    static const int EVENTS_PER_THREAD = 32768;    // Stariji dogadjaji se prepisuju
+    static const int DETAIL_LENGTH = 40;
+
+    static int64_t now();                           // ns od pokretanja programa
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    static void setThreadName(const char* name);
+    static void record(const char* name, int64_t startNs, int64_t endNs, const char* detail = nullptr);
+
+    static bool writeChromeJson(const std::string& path);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+class TraceScope {
+private:
+    const char* name;
+    const char* detail;
+    int64_t startNs;
+
+public:
+    explicit TraceScope(const char* name, const char* detail = nullptr)
+        : name(name), detail(detail), startNs(Tracer::isEnabled() ? Tracer::now() : -1) {
+    }
+    ~TraceScope() {
+        if (startNs >= 0) Tracer::record(name, startNs, Tracer::now(), detail);
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_DETAIL(name, detail) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, detail)
+
+#endif // TRACE_H
@@ -0,0 +1,227 @@
+#include "UiAtlas.h"
+#include "AssetPack.h"
+#include "GpuMemory.h"
+#include "ImageCache.h"
+#include "Trace.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int MAX_PAGE_SIZE = 4096;
+
+int maxPageSize() {
+    GLint maxSize = MAX_PAGE_SIZE;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    return std::min((int)maxSize, MAX_PAGE_SIZE);
+}
+
+// Strana stranice za koju u budzet staje minPages stranica sa mip lancem (~4/3 osnovnog nivoa), poravnata kao celije
+int budgetPageSize(long long budgetBytes, int minPages) {
+    double pixels = (double)budgetBytes / minPages * 3.0 / 16.0;
+    return (int)std::sqrt(pixels) / 4 * 4;
+}
+
+}
+
+UiAtlas::UiAtlas(long long budgetBytes)
+    : layout(maxPageSize()), budgetBytes(budgetBytes), frame(1), evictions(0), atlasTexture(0), built(false) {
+}
+
+UiAtlas::~UiAtlas() {
+    if (atlasTexture != 0) {
+        GpuMemory::release(GPU_TEXTURE, atlasTexture);
+        glDeleteTextures(1, &atlasTexture);
+    }
+}
+
+void UiAtlas::add(const std::string& name, const std::string& path) {
+    if (built || paths.count(name)) return;
+
+    int width = 0, height = 0, channels = 0;
+    AssetData file = AssetPack::load(path);
+    if (file.empty() || !stbi_info_from_memory(file.data(), (int)file.size(), &width, &height, &channels)) {
+        std::cerr << "UiAtlas: nepoznata velicina slike: " << path << std::endl;
+        return;
+    }
+    paths[name] = path;
+    layout.add(name, width, height);
+}
+
+void UiAtlas::build() {
+    TRACE_SCOPE("UiAtlas::build");
+    if (built) return;
+    built = true;
+
+    // Manje stranice nego sto GL dozvoljava, da budzet drzi vise stranica i izbacivanje bude sitnije
+    int pageSize = std::max(budgetPageSize(budgetBytes, MIN_RESIDENT_PAGES), layout.largestCell());
+    layout.setMaxPageSize(std::min(pageSize, maxPageSize()));
+    layout.pack();
+    if (layout.pageCount() == 0) return;
+
+    long long pageBytes = GpuMemory::imageBytes(layout.pageWidth(), layout.pageHeight(), 4, true);
+    int layerCount = (int)std::max(1LL, std::min((long long)layout.pageCount(), budgetBytes / pageBytes));
+    pageLayers.assign(layout.pageCount(), -1);
+    layers.assign(layerCount, Layer());
+
+    // Sadrzaj slojeva je nedefinisan dok se celija ne popuni, ali se van popunjenih celija nikad ne uzorkuje
+    glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlasTexture);
+    for (int level = 0; level < AtlasLayout::MIP_LEVELS; ++level) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, std::max(1, layout.pageWidth() >> level), std::max(1, layout.pageHeight() >> level),
+            layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, AtlasLayout::MIP_LEVELS - 1);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GpuMemory::track(GPU_TEXTURE, atlasTexture, pageBytes * layerCount, "UI atlas", GPU_MEMORY_SITE);
+
+    std::cout << "UiAtlas: " << layout.imageCount() << " slika u " << layout.pageCount() << " stranica " << layout.pageWidth() << "x"
+        << layout.pageHeight() << " (" << (int)(layout.occupancy() + 0.5f) << "% popunjeno), " << layerCount << " u budzetu od "
+        << budgetBytes / (1024 * 1024) << " MB" << std::endl;
+}
+
+void UiAtlas::beginFrame() {
+    frame++;
+}
+
+UiRegion UiAtlas::find(const std::string& name) {
+    UiRegion region;
+    AtlasRect rect = layout.find(name);
+    if (!built || rect.page < 0 || failed.count(name)) return region;
+
+    int layer = residentLayer(rect.page);
+    if (layer < 0) return region;
+    if (!loaded.count(name)) {
+        if (!upload(name, rect, layer)) {
+            failed.insert(name);
+            return region;
+        }
+        loaded.insert(name);
+    }
+
+    layers[layer].lastUsed = frame;
+    region.layer = layer;
+    layout.uv(rect, region.u0, region.v0, region.u1, region.v1);
+    return region;
+}
+
+void UiAtlas::loadAll() {
+    TRACE_SCOPE("UiAtlas::loadAll");
+    for (const auto& entry : paths) find(entry.first);
+}
+
+int UiAtlas::residentLayer(int page) {
+    if (pageLayers[page] >= 0) return pageLayers[page];
+
+    // Slobodan sloj, inace najdavnije korisceni koji nije koriscen u ovom frejmu
+    int victim = -1;
+    for (int i = 0; i < (int)layers.size(); ++i) {
+        if (layers[i].page < 0) {
+            victim = i;
+            break;
+        }
+        if (layers[i].lastUsed < frame && (victim < 0 || layers[i].lastUsed < layers[victim].lastUsed)) victim = i;
+    }
+    if (victim < 0) return -1;
+
+    int evicted = layers[victim].page;
+    if (evicted >= 0) {
+        TRACE_SCOPE("UiAtlas::evict");
+        pageLayers[evicted] = -1;
+        for (auto it = loaded.begin(); it != loaded.end();) {
+            if (layout.find(*it).page == evicted) it = loaded.erase(it);
+            else ++it;
+        }
+        evictions++;
+    }
+    layers[victim].page = page;
+    pageLayers[page] = victim;
+    return victim;
+}
+
+bool UiAtlas::upload(const std::string& name, const AtlasRect& rect, int layer) {
+    const std::string& path = paths[name];
+    TRACE_SCOPE_DETAIL("UiAtlas::upload", path.c_str());
+
+    // Red 0 stranice je gornji red slike, pa bez okretanja; flag je globalan, pa se postavlja pre svakog citanja
+    ImageDecode decode;
+    decode.channels = 4;
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = nullptr;
+    AssetData file = AssetPack::load(path);
+    CachedImage cached = ImageCache::load(path, file.data(), file.size(), decode);
+    if (!cached.empty()) {
+        width = cached.width();
+        height = cached.height();
+    }
+    else if (!file.empty()) {
+        TRACE_SCOPE("stbi_load");
+        stbi_set_flip_vertically_on_load(false);
+        pixels = stbi_load_from_memory(file.data(), (int)file.size(), &width, &height, &channels, 4);
+        if (pixels) ImageCache::store(path, file.data(), file.size(), decode, pixels, width, height, 4);
+    }
+    if ((!pixels && cached.empty()) || width != rect.width || height != rect.height) {
+        std::cerr << "Failed to load texture: " << path << std::endl;
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    std::vector<unsigned char> cell;
+    int cellWidth, cellHeight;
+    AtlasLayout::withGutter(pixels ? pixels : cached.pixels(), width, height, cell, cellWidth, cellHeight);
+    stbi_image_free(pixels);
+
+    // Mip nivoi samo za ovu celiju, na CPU-u; glGenerateMipmap bi preracunao sve stranice niza. Celije su
+    // poravnate na 1 << (MIP_LEVELS - 1), pa je celija na nivou level tacno (x, y, w, h) >> level
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    std::vector<unsigned char> mip;
+    for (int level = 0; level < AtlasLayout::MIP_LEVELS; ++level) {
+        if (level > 0) {
+            AtlasLayout::halveCell(cell, cellWidth, cellHeight, mip);
+            cell.swap(mip);
+            cellWidth /= 2;
+            cellHeight /= 2;
+        }
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, (rect.x - AtlasLayout::GUTTER) >> level, (rect.y - AtlasLayout::GUTTER) >> level,
+            layer, cellWidth, cellHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, cell.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return true;
+}
+
+GLuint UiAtlas::texture() const {
+    return atlasTexture;
+}
+
+int UiAtlas::pageCount() const {
+    return layout.pageCount();
+}
+
+int UiAtlas::residentCount() const {
+    int resident = 0;
+    for (const Layer& layer : layers) resident += (layer.page >= 0) ? 1 : 0;
+    return resident;
+}
+
+int UiAtlas::loadedCount() const {
+    return (int)loaded.size();
+}
+
+void UiAtlas::print(std::ostream& out) const {
+    out << "UiAtlas: " << loaded.size() << "/" << layout.imageCount() << " slika ucitano, " << residentCount() << "/" << layout.pageCount()
+        << " stranica " << layout.pageWidth() << "x" << layout.pageHeight() << " u VRAM-u, " << GpuMemory::objectBytes(GPU_TEXTURE, atlasTexture) / 1024
+        << " KB od " << budgetBytes / 1024 << " KB budzeta, " << evictions << " izbacivanja";
+    if (!failed.empty()) out << ", " << failed.size() << " neuspesno";
+    out << std::endl;
+}
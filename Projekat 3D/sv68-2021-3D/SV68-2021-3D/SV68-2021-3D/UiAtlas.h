@@ -0,0 +1,84 @@
+#ifndef UI_ATLAS_H
+#define UI_ATLAS_H
+
+#include "GlHeaders.h"
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AtlasLayout.h"
+
+// Deo atlasa koji UI kvad uzorkuje: sloj i UV pravougaonik (u0, v0 = gornji levi ugao)
+struct UiRegion {
+    int layer = -1;             // -1 = slika ne postoji
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+// UI slike (trivia kartice) u jednom GL_TEXTURE_2D_ARRAY, sa stranicama atlasa kao slojevima.
+//
+//   UiAtlas triviaAtlas(budgetBytes);
+//   triviaAtlas.add("earth", "earth-trivia.png");     // cita samo zaglavlje slike
+//   triviaAtlas.build();                               // raspored + alokacija slojeva
+//   triviaAtlas.beginFrame();                          // svaki frejm, pre find()
+//   uiBatch.addQuad(x, y, w, h, triviaAtlas.find("earth"));
+//
+// Raspored se racuna pri pokretanju iz zaglavlja, a slika se dekodira i upisuje u svoju celiju tek
+// kad se prvi put trazi, pa pokretanje ne placa slike koje se nikad ne prikazu. Stranice imaju
+// AtlasLayout::MIP_LEVELS mip nivoa.
+//
+// VRAM je ogranicen budzetom: stranica je toliko mala da u budzet staje bar MIN_RESIDENT_PAGES
+// stranica (ali ne manja od najvece kartice), a tekstura ima samo onoliko slojeva koliko staje u
+// budzet. Stranica bez sloja dobija slobodan ili najdavnije korisceni sloj; kartice izbacene
+// stranice se ponovo dekodiraju kad se opet traze. Sloj koriscen u tekucem frejmu se ne izbacuje
+// (njegov kvad ceka u UiBatch-u), pa find() tada vraca prazan region i kartica se preskace.
+class UiAtlas {
+public:
+    static const long long DEFAULT_BUDGET_BYTES = 32LL * 1024 * 1024;
+    static const int MIN_RESIDENT_PAGES = 4;
+
+    explicit UiAtlas(long long budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~UiAtlas();
+    UiAtlas(const UiAtlas&) = delete;
+    UiAtlas& operator=(const UiAtlas&) = delete;
+
+    // Pre build()
+    void add(const std::string& name, const std::string& path);
+    void build();
+
+    void beginFrame();
+    UiRegion find(const std::string& name);
+    // Posle build(): odmah dekodira i salje slike koje staju u budzet (headless benchmark, da merni
+    // frejmovi ne placaju prvi prikaz)
+    void loadAll();
+    GLuint texture() const;
+
+    int pageCount() const;
+    int residentCount() const;
+    int loadedCount() const;
+    void print(std::ostream& out) const;
+
+private:
+    struct Layer {
+        int page = -1;              // Stranica rasporeda u sloju, -1 = slobodan
+        long long lastUsed = 0;     // Frejm poslednjeg find()
+    };
+
+    AtlasLayout layout;
+    long long budgetBytes;
+    std::unordered_map<std::string, std::string> paths;
+    std::unordered_set<std::string> loaded;         // Kartice upisane u sloj svoje stranice
+    std::unordered_set<std::string> failed;
+    std::vector<int> pageLayers;                    // Stranica -> sloj, -1 = nije rezidentna
+    std::vector<Layer> layers;
+    long long frame;
+    int evictions;
+    GLuint atlasTexture;
+    bool built;
+
+    int residentLayer(int page);
+    bool upload(const std::string& name, const AtlasRect& rect, int layer);
+};
+
+#endif // UI_ATLAS_H
@@ -0,0 +1,77 @@
+#include "UiBatch.h"
+#include "GpuMemory.h"
+#include "Trace.h"
+
+UiBatch::UiBatch()
+    : VAO(0), VBO(0), vboCapacity(0) {
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(UiVertex), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+UiBatch::~UiBatch() {
+    GpuMemory::release(GPU_BUFFER, VBO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void UiBatch::addQuad(float x, float y, float width, float height, const UiRegion& region) {
+    if (region.layer < 0) return;
+
+    float layer = (float)region.layer;
+    UiVertex topLeft = { x, y, region.u0, region.v0, layer };
+    UiVertex bottomLeft = { x, y - height, region.u0, region.v1, layer };
+    UiVertex bottomRight = { x + width, y - height, region.u1, region.v1, layer };
+    UiVertex topRight = { x + width, y, region.u1, region.v0, layer };
+
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topRight);
+}
+
+int UiBatch::flush(GLuint shaderProgram, GLuint atlasTexture, GLenum polygonMode) {
+    if (vertices.empty()) return 0;
+    TRACE_SCOPE("UiBatch::flush");
+
+    // Bafer raste samo kada je potrebno; inace se prepisuje postojeci
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (vertices.size() > vboCapacity) {
+        vboCapacity = vertices.size() * 2;
+        glBufferData(GL_ARRAY_BUFFER, vboCapacity * sizeof(UiVertex), nullptr, GL_DYNAMIC_DRAW);
+        GpuMemory::track(GPU_BUFFER, VBO, vboCapacity * sizeof(UiVertex), "UiBatch vertices", GPU_MEMORY_SITE);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(UiVertex), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // UI ide preko scene bez dubine i uvek popunjen, kao PerfHud; 2D ne koristi dubinu ni culling, pa se vraca zateceno stanje
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    if (polygonMode != GL_FILL) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    glUseProgram(shaderProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlasTexture);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
+    glBindVertexArray(0);
+
+    if (polygonMode != GL_FILL) glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+    if (cullFace) glEnable(GL_CULL_FACE);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+
+    int quads = (int)vertices.size() / 6;
+    vertices.clear();
+    return quads;
+}
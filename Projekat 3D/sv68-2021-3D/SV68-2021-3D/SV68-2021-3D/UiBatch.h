@@ -0,0 +1,39 @@
+#ifndef UI_BATCH_H
+#define UI_BATCH_H
+
+#include "GlHeaders.h"
+#include <vector>
+
+#include "UiAtlas.h"
+
+// UI kvadovi (info kartice i buduci paneli) skupljeni tokom frejma i nacrtani jednim glDrawArrays.
+// Svi kvadovi uzorkuju isti UiAtlas (sloj je atribut verteksa), a VAO/VBO traju koliko i objekat;
+// bafer raste samo kada kvadova ima vise nego ikad ranije.
+//
+//   uiBatch.addQuad(-0.95f, 0.9f, 0.8f, 0.4f, triviaAtlas.find("earth"));
+//   uiBatch.flush(triviaShaderProgram, triviaAtlas.texture(), polygonMode);    // details.vert/frag
+class UiBatch {
+public:
+    UiBatch();
+    ~UiBatch();
+    UiBatch(const UiBatch&) = delete;
+    UiBatch& operator=(const UiBatch&) = delete;
+
+    // NDC; (x, y) je gornji levi ugao. Region bez sloja (slika ne postoji) se preskace
+    void addQuad(float x, float y, float width, float height, const UiRegion& region);
+
+    // Crta i prazni red; menja depth/cull/polygon stanje i vraca zateceno. Vraca broj nacrtanih kvadova
+    int flush(GLuint shaderProgram, GLuint atlasTexture, GLenum polygonMode);
+
+private:
+    struct UiVertex {
+        float x, y, u, v;
+        float layer;
+    };
+
+    GLuint VAO, VBO;
+    size_t vboCapacity;             // U verteksima
+    std::vector<UiVertex> vertices;
+};
+
+#endif // UI_BATCH_H
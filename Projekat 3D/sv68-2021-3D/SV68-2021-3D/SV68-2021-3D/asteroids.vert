@@ -2,14 +2,20 @@
 
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in mat4 model; // Učitavanje model matrice iz instanceVBO
+layout (location = 2) in vec4 instance; // xyz = pozicija, w = skala (instanceVBO, 16 bajtova)
+layout (location = 3) in uint variant;  // Varijanta stene (variantVBO)
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform isamplerBuffer variantPositions;   // AsteroidVariantSet: x, y, z, 0 kao normalizovan short
+uniform int variantVertexCount;
 
 out vec2 TexCoord;
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    // aPos je neizmenjena ikosfera; stena iste topologije ima svoje pozicije u baferu varijanti
+    vec3 rockPos = vec3(texelFetch(variantPositions, int(variant) * variantVertexCount + gl_VertexID).xyz) / 32767.0;
+    vec3 worldPos = instance.xyz + rockPos * instance.w;   // Isto kao translate * scale model matrica
+    gl_Position = projection * view * vec4(worldPos, 1.0);
     TexCoord = aTexCoord;
 }
@@ -1,8 +1,9 @@
 #version 330 core
 out vec4 FragColor;
 in vec2 TexCoords;
-uniform sampler2D texture1;
+flat in float Layer;
+uniform sampler2DArray texture1;
 
 void main() {
-    FragColor = texture(texture1, TexCoords);
+    FragColor = texture(texture1, vec3(TexCoords, Layer));
 }
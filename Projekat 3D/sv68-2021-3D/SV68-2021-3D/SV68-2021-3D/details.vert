@@ -1,9 +1,12 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // pozicija + UV koordinate
+layout (location = 1) in float layer; // stranica UI atlasa
 uniform mat4 projection; // Dodaj uniform matricu
 out vec2 TexCoords;
+flat out float Layer;
 
 void main() {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    Layer = layer;
 }
@@ -4,8 +4,9 @@ out vec4 FragColor;
 
 in vec2 TexCoord;
 
-uniform sampler2D moonTexture; // Tekstura planete
+uniform sampler2DArray moonTextures; // Niz povrsinskih tekstura iste klase velicine (TextureArrayManager)
+uniform int layer;                   // Sloj ovog tela u nizu
 
 void main() {
-    FragColor = texture(moonTexture, TexCoord);
+    FragColor = texture(moonTextures, vec3(TexCoord, layer));
 }
@@ -1,7 +1,7 @@
 #version 330 core
+in vec3 OrbitColor;
 out vec4 FragColor;
-uniform vec3 orbitColor;
 
 void main() {
-    FragColor = vec4(orbitColor, 1.0);
+    FragColor = vec4(OrbitColor, 1.0);
 }
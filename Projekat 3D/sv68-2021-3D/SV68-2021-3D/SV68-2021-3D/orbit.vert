@@ -1,9 +1,39 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
+layout (location = 0) in vec4 orbit;    // xyz = centar (zariste), w = poluvelika osa (OrbitRenderer)
+layout (location = 1) in vec4 style;    // rgb = boja, a = ekscentricitet
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 cameraPos;
+uniform float pixelsPerUnit;    // projection[1][1] * visina viewport-a / 2
+uniform int minSegments;
+uniform int maxSegments;        // Broj segmenata nivoa u kom je orbita (OrbitRenderer); verteksa ima maxSegments + 1
+
+out vec3 OrbitColor;
+
+const float PI = 3.14159265;
+const float ORBIT_MAX_PIXEL_ERROR = 0.5;    // Najveci razmak tetive od elipse na ekranu
+const float NEAR_DISTANCE = 0.1;            // Near plane iz calculateProjectionMatrix
 
 void main() {
-    gl_Position = projection * view * vec4(aPos, 1.0);
+    float a = orbit.w;
+    float e = style.a;
+    float b = a * sqrt(1.0 - e * e);
+    vec3 ellipseCenter = orbit.xyz - vec3(a * e, 0.0, 0.0);
+
+    // Udaljenost kamere od najblize tacke orbite (elipsa priblizena krugom poluprecnika a)
+    float radial = abs(length(cameraPos.xz - ellipseCenter.xz) - a);
+    float distance = max(length(vec2(radial, cameraPos.y - ellipseCenter.y)), NEAR_DISTANCE);
+
+    // Tetiva od n segmenata odstupa a * (1 - cos(PI / n)) ~ a * PI^2 / (2 n^2) od luka
+    float pixelsPerWorld = pixelsPerUnit / distance;
+    int segments = int(ceil(PI * sqrt(a * pixelsPerWorld / (2.0 * ORBIT_MAX_PIXEL_ERROR))));
+    segments = clamp(segments, minSegments, maxSegments);
+
+    // Poslednji verteks i visak (duzi nulte duzine) padaju tacno na prvi, pa je petlja zatvorena
+    float angle = 2.0 * PI * float(min(gl_VertexID, segments) % segments) / float(segments);
+    vec3 worldPos = ellipseCenter + vec3(cos(angle) * a, 0.0, sin(angle) * b);
+
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+    OrbitColor = style.rgb;
 }
@@ -4,8 +4,9 @@ out vec4 FragColor;
 
 in vec2 TexCoord;
 
-uniform sampler2D planetTexture; // Tekstura planete
+uniform sampler2DArray planetTextures; // Niz povrsinskih tekstura iste klase velicine (TextureArrayManager)
+uniform int layer;                   // Sloj ovog tela u nizu
 
 void main() {
-    FragColor = texture(planetTexture, TexCoord);
+    FragColor = texture(planetTextures, vec3(TexCoord, layer));
 }
@@ -0,0 +1,16 @@
+#version 330 core
+
+in vec2 RingCoord;
+in vec3 Normal;
+in vec3 WorldPos;
+
+out vec4 FragColor;
+
+uniform sampler2D ringTexture;
+
+void main() {
+    // Boja stene je boja prstena na njenom poluprecniku; Sunce je u koordinatnom pocetku
+    vec3 color = texture(ringTexture, RingCoord).rgb;
+    float diffuse = max(dot(normalize(Normal), normalize(-WorldPos)), 0.0);
+    FragColor = vec4(color * (0.25 + 0.75 * diffuse), 1.0);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;         // Ikosfera 0 (MeshRegistry), jedinicna
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 particle;     // xyz = pozicija u odnosu na Saturn, w = poluprecnik stene
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 ringCenter;
+uniform float sizeScale;    // Proredjen sektor ima vece stene, da prsten ostane iste pokrivenosti
+uniform float innerRadius;
+uniform float outerRadius;
+
+out vec2 RingCoord;
+out vec3 Normal;
+out vec3 WorldPos;
+
+void main() {
+    WorldPos = ringCenter + particle.xyz + aPos * particle.w * sizeScale;
+    gl_Position = projection * view * vec4(WorldPos, 1.0);
+
+    // Tekstura prstena je traka: x ide od unutrasnje do spoljasnje ivice
+    RingCoord = vec2((length(particle.xz) - innerRadius) / (outerRadius - innerRadius), 0.5);
+    Normal = aPos;
+}
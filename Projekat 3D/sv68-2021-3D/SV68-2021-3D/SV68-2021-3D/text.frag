@@ -1,10 +1,12 @@
 #version 330 core
 in vec2 TexCoords;
+in vec4 Color;
 out vec4 color;
 uniform sampler2D text;
 uniform vec3 textColor;
 
 void main() {
+    // Atlas ima samo R kanal: pokrivenost glifa, odnosno 1.0 u belom bloku za pune pravougaonike
     vec4 sampled = texture(text, TexCoords);
-    color = vec4(textColor,sampled.r);
+    color = vec4(textColor * Color.rgb, Color.a * sampled.r);
 }
@@ -1,9 +1,12 @@
 #version 330 core
-layout(location = 0) in vec4 vertex;
+layout(location = 0) in vec4 vertex;        // xy = pozicija u pikselima, zw = UV u atlasu
+layout(location = 1) in vec4 vertexColor;   // RGBA po verteksu (normalizovani bajtovi)
 out vec2 TexCoords;
+out vec4 Color;
 uniform mat4 projection;
 
 void main() {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    Color = vertexColor;
 }
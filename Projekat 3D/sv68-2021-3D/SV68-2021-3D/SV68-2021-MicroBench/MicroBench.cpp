@@ -0,0 +1,526 @@
+// Microbenchmark CPU kernela 3D i 2D scene. Ne pravi OpenGL kontekst, pa radi na bilo kojoj masini.
+//
+//   SV68-2021-MicroBench [--filter TEXT] [--max-size N] [--min-time SECONDS] [--out FILE.json]
+//
+// Svaki kernel se meri za vise velicina problema; rezultat ide u tabelu na izlazu
+// i u JSON fajl (podrazumevano microbench.json) za pracenje kroz vreme.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "MeshGenerators.h"
+#include "OrbitMath.h"
+#include "RingLod.h"
+#include "TerrainQuadtree.h"
+#include "HitTest2D.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const int SAMPLES = 5;
+
+// Rezultat kernela ide ovde, da ga kompajler ne bi izbacio kao mrtav kod
+volatile float benchmarkSink = 0.0f;
+
+void consume(float value) {
+    benchmarkSink = benchmarkSink + value;
+}
+
+// Jedan poziv run() obradi ceo problem; items = broj elemenata (verteksa, tacaka, asteroida)
+struct PreparedKernel {
+    std::function<void()> run;
+    long long items;
+};
+
+struct Benchmark {
+    std::string name;
+    std::string sizeName;       // Sta je "size" za ovaj kernel (sectors, asteroids, points...)
+    std::vector<long long> sizes;
+    std::function<PreparedKernel(long long size)> prepare;   // Ulazi se prave van merenja
+};
+
+struct Result {
+    std::string name;
+    std::string sizeName;
+    long long size;
+    long long items;
+    long long iterations;       // Poziva po uzorku
+    std::vector<double> samplesNs;
+    double medianNs;
+    double minNs;
+    double maxNs;
+};
+
+struct Options {
+    std::string filter;
+    long long maxSize = 1000000;
+    double minTime = 0.5;       // Sekunde po kernelu i velicini (svi uzorci zajedno)
+    std::string outPath = "microbench.json";
+};
+
+std::vector<float> randomFloats(long long count, float low, float high, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(static_cast<size_t>(count));
+    for (float& value : values) value = dist(gen);
+    return values;
+}
+
+std::vector<glm::vec3> randomPoints3D(long long count, float extent, unsigned int seed) {
+    std::vector<float> values = randomFloats(count * 3, -extent, extent, seed);
+    std::vector<glm::vec3> points(static_cast<size_t>(count));
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = glm::vec3(values[i * 3], values[i * 3 + 1] * 0.1f, values[i * 3 + 2]);
+    }
+    return points;
+}
+
+std::vector<glm::vec2> randomPoints2D(long long count, float extent, unsigned int seed) {
+    std::vector<float> values = randomFloats(count * 2, -extent, extent, seed);
+    std::vector<glm::vec2> points(static_cast<size_t>(count));
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = glm::vec2(values[i * 2], values[i * 2 + 1]);
+    }
+    return points;
+}
+
+std::vector<Benchmark> registerBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+    const std::vector<long long> pointCounts = { 1000, 100000, 1000000 };
+    const std::vector<long long> sectorCounts = { 8, 16, 32, 64, 128, 256, 512 };
+
+    // Planet::getPosition
+    benchmarks.push_back({ "orbit/ellipticalOrbitPosition", "positions", pointCounts, [](long long size) {
+        auto angles = std::make_shared<std::vector<float>>(randomFloats(size, 0.0f, 360.0f, 1));
+        return PreparedKernel{ [angles]() {
+            float sum = 0.0f;
+            for (float angle : *angles) sum += ellipticalOrbitPosition(angle, 12.0f, 0.05f).x;
+            consume(sum);
+        }, size };
+    } });
+
+    // Moon::getPosition (bez pozicije planete, koja je poseban kernel iznad)
+    benchmarks.push_back({ "orbit/circularOrbitPosition", "positions", pointCounts, [](long long size) {
+        auto angles = std::make_shared<std::vector<float>>(randomFloats(size, 0.0f, 360.0f, 2));
+        return PreparedKernel{ [angles]() {
+            float sum = 0.0f;
+            glm::vec3 center(10.0f, 0.0f, 3.0f);
+            for (float angle : *angles) sum += circularOrbitPosition(center, angle, 1.5f).z;
+            consume(sum);
+        }, size };
+    } });
+
+    // Planet/Moon::generateVertices (stacks = sectors / 2, kao u sceni)
+    benchmarks.push_back({ "mesh/generateSphereVertices(planet)", "sectors", sectorCounts, [](long long size) {
+        int sectors = static_cast<int>(size);
+        return PreparedKernel{ [sectors]() {
+            std::vector<float> vertices;
+            generateSphereVertices(1.0f, sectors, sectors / 2, SPHERE_UV_PLANET, vertices);
+            consume(vertices.back());
+        }, (size + 1) * (size / 2 + 1) };
+    } });
+
+    // Sun/Asteroid::generateVertices
+    benchmarks.push_back({ "mesh/generateSphereVertices(sun)", "sectors", sectorCounts, [](long long size) {
+        int sectors = static_cast<int>(size);
+        return PreparedKernel{ [sectors]() {
+            std::vector<float> vertices;
+            generateSphereVertices(1.0f, sectors, sectors / 2, SPHERE_UV_STANDARD, vertices);
+            consume(vertices.back());
+        }, (size + 1) * (size / 2 + 1) };
+    } });
+
+    // generateIndices (isti za sva cetiri tela)
+    benchmarks.push_back({ "mesh/generateSphereIndices", "sectors", sectorCounts, [](long long size) {
+        int sectors = static_cast<int>(size);
+        int vertexCount = (sectors + 1) * (sectors / 2 + 1);
+        return PreparedKernel{ [sectors, vertexCount]() {
+            std::vector<int> indices;
+            generateSphereIndices(sectors, sectors / 2, vertexCount, indices);
+            consume(static_cast<float>(indices.back()));
+        }, (long long)sectors * (sectors / 2) * 2 };
+    } });
+
+    // MeshRegistry::icosphere bez preuredjivanja (asteroidi)
+    benchmarks.push_back({ "mesh/generateIcosphere", "subdivisions", { 1, 2, 3, 4, 5, 6 }, [](long long size) {
+        int subdivisions = static_cast<int>(size);
+        return PreparedKernel{ [subdivisions]() {
+            std::vector<float> vertices;
+            std::vector<unsigned short> indices;
+            generateIcosphere(subdivisions, vertices, indices);
+            consume(vertices.back());
+        }, 20LL << (2 * size) };
+    } });
+
+    // Forsyth preuredjivanje trouglova ikosfere (jednom po mrezi, pri pravljenju)
+    benchmarks.push_back({ "mesh/optimizeVertexCache", "subdivisions", { 1, 2, 3, 4, 5, 6 }, [](long long size) {
+        auto vertices = std::make_shared<std::vector<float>>();
+        auto indices = std::make_shared<std::vector<unsigned short>>();
+        generateIcosphere(static_cast<int>(size), *vertices, *indices);
+        int vertexCount = static_cast<int>(vertices->size() / 5);
+        return PreparedKernel{ [indices, vertexCount]() {
+            std::vector<unsigned short> ordered = *indices;
+            optimizeVertexCache(ordered, vertexCount);
+            consume(static_cast<float>(ordered.front()));
+        }, 20LL << (2 * size) };
+    } });
+
+    // AsteroidVariantSet: stene od ikosfere 1 na svim jezgrima (pri pokretanju)
+    benchmarks.push_back({ "mesh/generateAsteroidVariants", "variants", { 16, 32, 64, 256 }, [](long long size) {
+        auto base = std::make_shared<std::vector<float>>();
+        std::vector<unsigned short> indices;
+        generateIcosphere(1, *base, indices);
+        optimizeVertexFetch(*base, 5, indices);
+        int variants = static_cast<int>(size);
+        return PreparedKernel{ [base, variants]() {
+            std::vector<short> positions;
+            generateAsteroidVariants(*base, variants, 2021, 0, positions);
+            consume(static_cast<float>(positions.back()));
+        }, size * static_cast<long long>(base->size() / 5) };
+    } });
+
+    // SaturnRing::generateRingMesh (bez GL dela)
+    benchmarks.push_back({ "mesh/generateRingVertices", "segments", { 64, 256, 1024, 4096, 16384, 65536 }, [](long long size) {
+        int segments = static_cast<int>(size);
+        return PreparedKernel{ [segments]() {
+            std::vector<float> vertices;
+            generateRingVertices(segments, 1.2f, 2.0f, vertices);
+            consume(vertices.back());
+        }, (size + 1) * 2 };
+    } });
+
+    // SaturnRing::enableParticles (profil sa prazninom, kao Kasinijeva pukotina)
+    benchmarks.push_back({ "ring/generateRingParticles", "particles", { 10000, 100000, 1000000 }, [](long long size) {
+        auto profile = std::make_shared<std::vector<float>>(2048, 1.0f);
+        std::fill(profile->begin() + 900, profile->begin() + 1000, 0.0f);
+        int count = static_cast<int>(size);
+        return PreparedKernel{ [profile, count]() {
+            RingParticles ring;
+            generateRingParticles(count, 0.6f, 1.0f, *profile, 2021, ring);
+            consume(ring.particles.back().x);
+        }, size };
+    } });
+
+    // SaturnRing::Draw u rezimu cestica: izbor sektora i proredjivanje po frejmu (pogled sa 2 jedinice)
+    benchmarks.push_back({ "ring/selectRingParticles", "particles", { 100000, 1000000 }, [](long long size) {
+        auto ring = std::make_shared<RingParticles>();
+        generateRingParticles(static_cast<int>(size), 0.6f, 1.0f, std::vector<float>(), 2021, *ring);
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 2.0f, 0.1f, 100.0f);
+        glm::vec3 cameraPos(0.0f, 0.7f, 1.9f);
+        glm::mat4 viewProjection = projection * glm::lookAt(cameraPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        float pixelsPerUnit = projection[1][1] * 400.0f;
+        return PreparedKernel{ [ring, cameraPos, viewProjection, pixelsPerUnit]() {
+            std::vector<RingDraw> draws;
+            int rocks = selectRingParticles(*ring, 0.6f, 1.0f, glm::vec3(0.0f), cameraPos, viewProjection, pixelsPerUnit, draws);
+            consume(static_cast<float>(rocks));
+        }, RING_SECTORS };
+    } });
+
+    // SurfaceTerrain radna nit: zakrpe nivoa 6 sa visinama iz mape 1024 x 512
+    benchmarks.push_back({ "terrain/generateTerrainPatch", "patches", { 1, 16, 256 }, [](long long size) {
+        auto heights = std::make_shared<TerrainHeightMap>();
+        heights->width = 1024;
+        heights->height = 512;
+        heights->scale = 0.01f;
+        heights->samples.resize((size_t)heights->width * heights->height);
+        std::mt19937 gen(2021);
+        for (unsigned char& sample : heights->samples) sample = static_cast<unsigned char>(gen() & 0xFF);
+        int count = static_cast<int>(size);
+        return PreparedKernel{ [heights, count]() {
+            std::vector<float> vertices;
+            for (int i = 0; i < count; ++i) {
+                generateTerrainPatch(TerrainPatchKey{ i % 6, 6, i % 64, (i / 6) % 64 }, heights.get(), 0.0f, vertices);
+            }
+            consume(vertices.back());
+        }, size * TERRAIN_PATCH_VERTICES };
+    } });
+
+    // SurfaceTerrain::draw: izbor zakrpa kad je sve vec na GPU-u, glatka sfera, kamera na visini 1 / N poluprecnika
+    benchmarks.push_back({ "terrain/selectTerrainPatches", "1/altitude", { 10, 1000, 100000 }, [](long long size) {
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 2.0f, 1e-6f, 100.0f);
+        glm::vec3 cameraLocal = glm::normalize(glm::vec3(0.0f, 0.3f, 1.0f)) * (1.0f + 1.0f / size);
+        glm::mat4 viewProjection = projection * glm::lookAt(cameraLocal, glm::vec3(0.0f, 1.0f, 0.0f), glm::normalize(cameraLocal));
+        float pixelsPerUnit = projection[1][1] * 400.0f;
+
+        // Izmerena greska jedne zakrpe po nivou vazi za sve zakrpe tog nivoa
+        auto levels = std::make_shared<std::vector<TerrainPatchInfo>>();
+        std::vector<float> vertices;
+        for (int level = 0; level <= TERRAIN_MAX_LEVEL; ++level) {
+            levels->push_back(generateTerrainPatch(TerrainPatchKey{ 4, level, 0, 0 }, nullptr, 0.0f, vertices));
+        }
+        auto allResident = [levels](const TerrainPatchKey& key) { return &(*levels)[key.level]; };
+
+        std::vector<TerrainPatchKey> draws;
+        std::vector<TerrainRequest> requests;
+        selectTerrainPatches(cameraLocal, viewProjection, pixelsPerUnit, 1e-6f, 0.0f, allResident, draws, requests);
+        return PreparedKernel{ [cameraLocal, viewProjection, pixelsPerUnit, allResident]() {
+            std::vector<TerrainPatchKey> draws;
+            std::vector<TerrainRequest> requests;
+            selectTerrainPatches(cameraLocal, viewProjection, pixelsPerUnit, 1e-6f, 0.0f, allResident, draws, requests);
+            consume(static_cast<float>(draws.size()));
+        }, static_cast<long long>(draws.size()) };
+    } });
+
+    // AsteroidBelt::generateAsteroids
+    benchmarks.push_back({ "belt/generateBeltInstances", "asteroids",
+        { 10, 100, 1000, 10000, 100000, 1000000, 10000000 }, [](long long size) {
+        int count = static_cast<int>(size);
+        return PreparedKernel{ [count]() {
+            std::vector<glm::vec4> instances;
+            generateBeltInstances(count, 4.5f, 5.0f, 2021, instances);
+            consume(instances.back().x);
+        }, size };
+    } });
+
+    // AsteroidBelt::isInsideBelt
+    benchmarks.push_back({ "belt/isInsideBeltVolume", "points", pointCounts, [](long long size) {
+        auto points = std::make_shared<std::vector<glm::vec3>>(randomPoints3D(size, 25.0f, 3));
+        return PreparedKernel{ [points]() {
+            int inside = 0;
+            for (const glm::vec3& point : *points) inside += isInsideBeltVolume(point, 13.0f, 18.0f) ? 1 : 0;
+            consume(static_cast<float>(inside));
+        }, size };
+    } });
+
+    // 2D getMouseWorldPosition (bez glfwGetCursorPos)
+    benchmarks.push_back({ "2d/screenToWorld", "points", pointCounts, [](long long size) {
+        auto cursor = std::make_shared<std::vector<float>>(randomFloats(size * 2, 0.0f, 950.0f, 4));
+        glm::mat4 projection = glm::ortho(-1.8f, 1.8f, -0.95f, 0.95f, -1.0f, 1.0f);
+        return PreparedKernel{ [cursor, projection]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i + 1 < cursor->size(); i += 2) {
+                sum += screenToWorld((*cursor)[i], (*cursor)[i + 1], 1800, 950, projection).x;
+            }
+            consume(sum);
+        }, size };
+    } });
+
+    // 2D isMouseOverPlanet / isMouseOverSun / isMouseOverMoon
+    benchmarks.push_back({ "2d/isPointInCircle", "points", pointCounts, [](long long size) {
+        auto points = std::make_shared<std::vector<glm::vec2>>(randomPoints2D(size, 2.0f, 5));
+        return PreparedKernel{ [points]() {
+            int hits = 0;
+            glm::vec2 center(0.4f, -0.2f);
+            for (const glm::vec2& point : *points) hits += isPointInCircle(point, center, 0.05f) ? 1 : 0;
+            consume(static_cast<float>(hits));
+        }, size };
+    } });
+
+    // 2D isMouseOverAsteroidBelt
+    benchmarks.push_back({ "2d/isPointInRing", "points", pointCounts, [](long long size) {
+        auto points = std::make_shared<std::vector<glm::vec2>>(randomPoints2D(size, 5.0f, 6));
+        return PreparedKernel{ [points]() {
+            int hits = 0;
+            for (const glm::vec2& point : *points) hits += isPointInRing(point, 0.35f, 0.45f) ? 1 : 0;
+            consume(static_cast<float>(hits));
+        }, size };
+    } });
+
+    return benchmarks;
+}
+
+// ACMR pre i posle optimizeVertexCache; UV sfera 8x8 je raniji bazni asteroid, 36x18 telo Suncevog sistema.
+// "po instanci" = ACMR * trouglovi, broj pokretanja verteks sejdera za jednu instancu asteroida
+void printVertexCacheReport() {
+    const int cacheSizes[2] = { 16, 32 };
+
+    std::cout << std::left << std::setw(22) << "mesh (FIFO 16 / 32)" << std::right << std::setw(10) << "triangles"
+        << std::setw(18) << "ACMR before" << std::setw(18) << "ACMR after" << std::setw(16) << "vs/instance" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (int sectors : { 8, 36 }) {
+        int stacks = sectors == 8 ? 8 : sectors / 2;
+        std::vector<float> vertices;
+        std::vector<int> indices;
+        generateSphereVertices(1.0f, sectors, stacks, SPHERE_UV_STANDARD, vertices);
+        generateSphereIndices(sectors, stacks, static_cast<int>(vertices.size() / 5), indices);
+        float acmr16 = vertexCacheMissRatio(indices, cacheSizes[0]);
+        float acmr32 = vertexCacheMissRatio(indices, cacheSizes[1]);
+        std::cout << std::left << std::setw(22) << ("uv " + std::to_string(sectors) + "x" + std::to_string(stacks)) << std::right
+            << std::setw(10) << indices.size() / 3 << std::setw(10) << acmr16 << " / " << std::setw(5) << acmr32
+            << std::setw(18) << "-" << std::setw(16) << static_cast<int>(acmr16 * indices.size() / 3 + 0.5f) << std::endl;
+    }
+
+    for (int subdivisions = 1; subdivisions <= 6; ++subdivisions) {
+        std::vector<float> vertices;
+        std::vector<unsigned short> indices;
+        generateIcosphere(subdivisions, vertices, indices);
+        float before16 = vertexCacheMissRatio(indices, cacheSizes[0]);
+        float before32 = vertexCacheMissRatio(indices, cacheSizes[1]);
+        optimizeVertexCache(indices, static_cast<int>(vertices.size() / 5));
+        float after16 = vertexCacheMissRatio(indices, cacheSizes[0]);
+        float after32 = vertexCacheMissRatio(indices, cacheSizes[1]);
+        std::cout << std::left << std::setw(22) << ("icosphere " + std::to_string(subdivisions)) << std::right
+            << std::setw(10) << indices.size() / 3 << std::setw(10) << before16 << " / " << std::setw(5) << before32
+            << std::setw(10) << after16 << " / " << std::setw(5) << after32
+            << std::setw(16) << static_cast<int>(after16 * indices.size() / 3 + 0.5f) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+Result measure(const Benchmark& benchmark, long long size, double minTime) {
+    PreparedKernel kernel = benchmark.prepare(size);
+
+    // Kalibracija: udvostrucuj broj poziva dok jedan uzorak ne traje minTime / SAMPLES
+    double targetNs = minTime * 1.0e9 / SAMPLES;
+    long long iterations = 1;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < iterations; ++i) kernel.run();
+        double ns = elapsedNs(start);
+        if (ns >= targetNs || iterations >= (1LL << 30)) break;
+        iterations = (ns <= 0.0) ? iterations * 2 : std::max(iterations * 2, (long long)(iterations * targetNs / ns));
+    }
+
+    Result result;
+    result.name = benchmark.name;
+    result.sizeName = benchmark.sizeName;
+    result.size = size;
+    result.items = kernel.items;
+    result.iterations = iterations;
+
+    for (int sample = 0; sample < SAMPLES; ++sample) {
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < iterations; ++i) kernel.run();
+        result.samplesNs.push_back(elapsedNs(start) / iterations);
+    }
+
+    std::vector<double> sorted = result.samplesNs;
+    std::sort(sorted.begin(), sorted.end());
+    result.medianNs = sorted[sorted.size() / 2];
+    result.minNs = sorted.front();
+    result.maxNs = sorted.back();
+    return result;
+}
+
+const char* compilerName() {
+#if defined(_MSC_VER)
+    return "msvc";
+#elif defined(__clang__)
+    return "clang";
+#elif defined(__GNUC__)
+    return "gcc";
+#else
+    return "unknown";
+#endif
+}
+
+bool writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "MicroBench: ne mogu da otvorim " << path << std::endl;
+        return false;
+    }
+
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"suite\": \"sv68-microbench\",\n  \"version\": 1,\n";
+    out << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+    out << "  \"compiler\": \"" << compilerName() << "\",\n";
+    out << "  \"build\": \"" << build << "\",\n";
+    out << "  \"pointerBits\": " << sizeof(void*) * 8 << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << r.name << "\", \"sizeName\": \"" << r.sizeName << "\", \"size\": " << r.size
+            << ", \"items\": " << r.items << ", \"iterations\": " << r.iterations
+            << ", \"nsPerOp\": " << r.medianNs << ", \"nsPerOpMin\": " << r.minNs << ", \"nsPerOpMax\": " << r.maxNs
+            << ", \"nsPerItem\": " << (r.items > 0 ? r.medianNs / r.items : 0.0)
+            << ", \"samplesNs\": [";
+        for (size_t s = 0; s < r.samplesNs.size(); ++s) {
+            out << (s == 0 ? "" : ", ") << r.samplesNs[s];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+
+    std::cout << "MicroBench: " << results.size() << " rezultata zapisano u " << path << std::endl;
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: SV68-2021-MicroBench [--filter TEXT] [--max-size N] [--min-time SECONDS] [--out FILE.json] [--list]" << std::endl;
+    std::cout << "Default --max-size is 1000000; use --max-size 10000000 for the full asteroid range." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--filter") == 0 && hasValue) options.filter = argv[++i];
+        else if (std::strcmp(arg, "--max-size") == 0 && hasValue) options.maxSize = std::atoll(argv[++i]);
+        else if (std::strcmp(arg, "--min-time") == 0 && hasValue) options.minTime = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--out") == 0 && hasValue) options.outPath = argv[++i];
+        else if (std::strcmp(arg, "--list") == 0) listOnly = true;
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    std::vector<Benchmark> benchmarks = registerBenchmarks();
+    std::vector<Result> results;
+
+    // ACMR nije vreme, pa ide na izlaz pre tabele, a ne u JSON
+    if (!listOnly && (options.filter.empty() || options.filter.find("mesh") != std::string::npos)) {
+        printVertexCacheReport();
+    }
+
+    std::cout << std::left << std::setw(40) << "kernel" << std::right << std::setw(10) << "size"
+        << std::setw(14) << "ns/op" << std::setw(12) << "ns/item" << std::setw(10) << "spread" << std::endl;
+
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) continue;
+
+        for (long long size : benchmark.sizes) {
+            if (size > options.maxSize) continue;
+            if (listOnly) {
+                std::cout << benchmark.name << " " << benchmark.sizeName << "=" << size << std::endl;
+                continue;
+            }
+
+            Result r = measure(benchmark, size, options.minTime);
+            results.push_back(r);
+
+            double spread = r.medianNs > 0.0 ? (r.maxNs - r.minNs) / r.medianNs * 100.0 : 0.0;
+            std::cout << std::fixed << std::setprecision(1)
+                << std::left << std::setw(40) << r.name << std::right << std::setw(10) << r.size
+                << std::setw(14) << r.medianNs << std::setw(12) << std::setprecision(3) << (r.items > 0 ? r.medianNs / r.items : 0.0)
+                << std::setw(9) << std::setprecision(1) << spread << "%" << std::endl;
+        }
+    }
+
+    if (listOnly) return 0;
+    return writeJson(options.outPath, results) ? 0 : 1;
+}
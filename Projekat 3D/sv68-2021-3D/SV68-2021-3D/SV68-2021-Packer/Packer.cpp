@@ -0,0 +1,73 @@
+// Pakuje seidere, teksture i font 3D scene u jedan indeksirani fajl (assets.pak) koji program mapira u memoriju.
+// Ne pravi OpenGL kontekst; pokrece se iz foldera sa assetima (SV68-2021-3D).
+//
+//   SV68-2021-Packer [--out assets.pak] [--no-dds] [FILE...]
+//
+// Bez fajlova pakuje sve sto 3D program ucitava, zajedno sa .dds i .preview.tga verzijama slika koje postoje
+// (SV68-2021-TexConvert). Paket se stavlja pored exe fajla ili u radni folder programa.
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AssetManifest.h"
+#include "AssetPack.h"
+#include "CompressedTexture.h"
+#include "TexturePreview.h"
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: SV68-2021-Packer [--out FILE.pak] [--no-dds] [FILE...]" << std::endl;
+    std::cout << "Without files, packs every shader, texture and font the 3D viewer loads (run from the asset folder)." << std::endl;
+}
+
+std::vector<std::string> defaultFiles(bool includeDds) {
+    std::vector<std::string> files = sceneShaderFiles();
+    for (const std::string& image : sceneImageFiles()) {
+        files.push_back(image);
+        std::string dds = compressedPathFor(image);
+        if (includeDds && !isTriviaCard(image) && std::ifstream(dds, std::ios::binary)) files.push_back(dds);   // Samo radni folder, kao i write()
+        std::string preview = previewPathFor(image);
+        if (std::ifstream(preview, std::ios::binary)) files.push_back(preview);
+    }
+    for (const std::string& font : sceneFontFiles()) files.push_back(font);
+    return files;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outPath = AssetPack::DEFAULT_PACK_NAME;
+    bool includeDds = true;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--out") == 0 && hasValue) outPath = argv[++i];
+        else if (std::strcmp(arg, "--no-dds") == 0) includeDds = false;
+        else if (arg[0] != '-') files.push_back(arg);
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (files.empty()) files = defaultFiles(includeDds);
+
+    if (!AssetPack::write(outPath, files, std::cout)) return 1;
+
+    // Provera: paket mora da se otvori i da sadrzi sve upisane fajlove
+    if (!AssetPack::open(outPath)) return 1;
+    int packed = 0;
+    for (const std::string& file : files) {
+        AssetData asset = AssetPack::load(file);
+        if (asset.fromPack()) packed++;
+    }
+    AssetPack::close();
+    std::cout << packed << "/" << files.size() << " fajlova u paketu" << std::endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Offline konverzija tekstura 3D scene u blok-kompresovane DDS fajlove (BC1/BC3 sa mip lancem).
+// Ne pravi OpenGL kontekst; pokrece se iz foldera sa slikama (SV68-2021-3D).
+//
+//   SV68-2021-TexConvert [--format auto|bc1|bc3] [--no-mips] [--no-flip] [--no-previews] [FILE...]
+//
+// Bez fajlova konvertuje sve teksture koje 3D program ucitava. Svaki FILE.jpg/png dobija FILE.dds
+// pored sebe; program koristi .dds kad postoji, a inace dekodira original.
+// Uz to pise i FILE.preview.tga (najvise 64 px) koji program crta dok se original ne dekodira.
+// Kartice sa trivijom se ne konvertuju: program ih pakuje u RGBA8 atlas (UiAtlas) iz originala.
+// Pravila prate ucitavanje u programu: stranice neba (bkg1_*) se ne okrecu i nemaju mipmape,
+// sve ostalo se okrece vertikalno (kao stbi_set_flip_vertically_on_load) i dobija ceo mip lanac.
+// Povrsinske mape (isSurfaceMap) se pre kompresije preuzorkuju na svoju klasu velicine, jer ih program
+// slaze u kompresovane nizove tekstura (TextureArrayManager) koji primaju samo .dds tacne velicine.
+// auto bira BC3 samo za slike sa providnim pikselima, inace BC1.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "AssetManifest.h"
+#include "CompressedTexture.h"
+#include "TexturePreview.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options {
+    std::string format = "auto";
+    bool mipmaps = true;
+    bool flip = true;
+    bool rulesFromName = true;      // --no-mips / --no-flip iskljucuju pravila po imenu
+    bool previews = true;
+};
+
+bool convert(const std::string& path, const Options& options, long long& sourceBytes, long long& compressedBytes) {
+    auto start = Clock::now();
+
+    bool skyboxFace = options.rulesFromName && isSkyboxFace(path);
+    bool flip = options.flip && !skyboxFace;
+    bool mipmaps = options.mipmaps && !skyboxFace;
+
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load(flip);
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (!pixels) {
+        std::cerr << "Failed to load texture: " << path << " (" << stbi_failure_reason() << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int format = COMPRESSED_RGB_BC1;
+    if (options.format == "bc3") format = COMPRESSED_RGBA_BC3;
+    else if (options.format == "auto" && hasTranslucentPixels(pixels, width, height, channels)) format = COMPRESSED_RGBA_BC3;
+
+    // Sloj niza: ista velicina kao u TextureArrayManager, umanjena verzija ostaje iz originala
+    const unsigned char* source = pixels;
+    int sourceWidth = width, sourceHeight = height;
+    std::vector<unsigned char> resampled;
+    if (options.rulesFromName && isSurfaceMap(path)) {
+        const TextureSizeClass& size = TEXTURE_SIZE_CLASSES[textureSizeClassFor(width, height)];
+        if (size.width != width || size.height != height) {
+            resampleImage(pixels, width, height, channels, size.width, size.height, resampled);
+            source = resampled.data();
+            sourceWidth = size.width;
+            sourceHeight = size.height;
+        }
+    }
+
+    CompressedImage image;
+    bool ok = compressImage(source, sourceWidth, sourceHeight, channels, format, mipmaps, image);
+    if (ok && options.previews && !isTriviaCard(path) && !writePreview(previewPathFor(path), pixels, width, height, channels, flip)) {
+        std::cerr << "Neuspesno pisanje: " << previewPathFor(path) << std::endl;
+    }
+    stbi_image_free(pixels);
+
+    std::string target = compressedPathFor(path);
+    if (!ok || !writeDds(target, image)) {
+        std::cerr << "Neuspesno pisanje: " << target << std::endl;
+        return false;
+    }
+
+    // Poredi se sa onim sto bi glTexImage2D alocirao za istu sliku (RGB/RGBA8, isti broj mip nivoa)
+    int uploadChannels = (channels == 4) ? 4 : 3;
+    long long uncompressed = 0;
+    for (const CompressedLevel& level : image.levels) uncompressed += (long long)level.width * level.height * uploadChannels;
+    sourceBytes += uncompressed;
+    compressedBytes += (long long)image.data.size();
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(32) << target << std::right << std::setw(6) << image.width << "x" << std::left << std::setw(6) << image.height
+        << std::right << std::setw(5) << compressedFormatName(format) << std::setw(4) << image.levels.size() << " mip"
+        << std::setw(10) << uncompressed / 1024 << " KB ->" << std::setw(8) << image.data.size() / 1024 << " KB"
+        << std::fixed << std::setprecision(0) << std::setw(8) << ms << " ms" << std::endl;
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Usage: SV68-2021-TexConvert [--format auto|bc1|bc3] [--no-mips] [--no-flip] [--no-previews] [FILE...]" << std::endl;
+    std::cout << "Without files, converts every texture the 3D viewer loads (run from the asset folder)." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--format") == 0 && hasValue) options.format = argv[++i];
+        else if (std::strcmp(arg, "--no-mips") == 0) { options.mipmaps = false; options.rulesFromName = false; }
+        else if (std::strcmp(arg, "--no-flip") == 0) { options.flip = false; options.rulesFromName = false; }
+        else if (std::strcmp(arg, "--no-previews") == 0) options.previews = false;
+        else if (arg[0] != '-') files.push_back(arg);
+        else {
+            printUsage();
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (options.format != "auto" && options.format != "bc1" && options.format != "bc3") {
+        printUsage();
+        return 1;
+    }
+    if (files.empty()) {
+        for (const std::string& file : sceneImageFiles()) {
+            if (!isTriviaCard(file)) files.push_back(file);
+        }
+    }
+
+    long long sourceBytes = 0, compressedBytes = 0;
+    int failures = 0;
+    for (const std::string& file : files) {
+        if (!convert(file, options, sourceBytes, compressedBytes)) failures++;
+    }
+
+    std::cout << files.size() - failures << "/" << files.size() << " fajlova, VRAM " << sourceBytes / (1024 * 1024) << " MB -> "
+        << compressedBytes / (1024 * 1024) << " MB" << std::endl;
+    return failures == 0 ? 0 : 1;
+}